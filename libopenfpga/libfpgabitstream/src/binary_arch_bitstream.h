@@ -0,0 +1,73 @@
+#ifndef BINARY_ARCH_BITSTREAM_H
+#define BINARY_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * This file defines the binary container of architecture bitstream,
+ * which is an alternative of the XML format to store
+ * large architecture bitstreams in an indexed and compact way
+ *
+ * All the integers are stored in little-endian
+ *
+ * +------------------------------------------------------------+
+ * | Header (40 bytes)                                          |
+ * |   [0:3]   magic string "OABS"                              |
+ * |   [4:7]   version (uint32)                                 |
+ * |   [8:15]  number of blocks (uint64)                        |
+ * |   [16:23] number of bits (uint64)                          |
+ * |   [24:31] number of strings (uint64)                       |
+ * |   [32:39] size of string data in bytes (uint64)            |
+ * +------------------------------------------------------------+
+ * | Block table (32 bytes per block)                           |
+ * |   [0:3]   string id of block name (uint32)                 |
+ * |   [4:7]   index of parent block (uint32)                   |
+ * |   [8:15]  first bit (uint64)                               |
+ * |   [16:19] number of bits (uint32)                          |
+ * |   [20:23] path id (int32)                                  |
+ * |   [24:27] string id of input net ids (uint32)              |
+ * |   [28:31] string id of output net ids (uint32)             |
+ * +------------------------------------------------------------+
+ * | Data bits                                                  |
+ * |   Packed bits, 8 bits per byte, starting from the LSB      |
+ * +------------------------------------------------------------+
+ * | String table                                               |
+ * |   Offset of each string in the string data (uint64),       |
+ * |   followed by the end offset of the last string (uint64)   |
+ * +------------------------------------------------------------+
+ * | String data                                                |
+ * |   Characters of all the strings, without terminators       |
+ * +------------------------------------------------------------+
+ *
+ * Blocks are stored in a Depth-First Search order from the top block,
+ * which is the same order as the XML format, so that
+ * - The top block is the first block, and its parent index is invalid
+ * - The parent of a block is always stored before the block
+ * - The child blocks of a block are stored in the order of
+ *   BitstreamManager::block_children()
+ * - The bits of the blocks are consecutive in the data bits
+ *
+ * Block names and net ids are stored only once in the string table,
+ * String 0 is always an empty string, which is used by blocks
+ * without any input or output nets
+ *
+ * The string table is the last section, so that the block table and
+ * the data bits can be written as the blocks are visited,
+ * and only the header has to be updated once the string table is complete
+ *******************************************************************/
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr std::array<char, 4> BINARY_ARCH_BITSTREAM_MAGIC = {{'O', 'A', 'B', 'S'}};
+constexpr uint32_t BINARY_ARCH_BITSTREAM_VERSION = 1;
+constexpr size_t BINARY_ARCH_BITSTREAM_HEADER_SIZE = 40;
+constexpr size_t BINARY_ARCH_BITSTREAM_BLOCK_SIZE = 32;
+
+/* Parent index of the top block */
+constexpr uint32_t BINARY_ARCH_BITSTREAM_INVALID_INDEX = 0xffffffff;
+
+} /* end namespace openfpga */
+
+#endif
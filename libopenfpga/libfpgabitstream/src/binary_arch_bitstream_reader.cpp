@@ -0,0 +1,266 @@
+/******************************************************************************
+ * This file includes member functions for the reader of binary architecture bitstream
+ ******************************************************************************/
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vtr_assert.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#include "binary_arch_bitstream_reader.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Offsets of the fields in a block of the block table */
+constexpr size_t BLOCK_NAME_FIELD = 0;
+constexpr size_t BLOCK_PARENT_FIELD = 4;
+constexpr size_t BLOCK_FIRST_BIT_FIELD = 8;
+constexpr size_t BLOCK_NUM_BITS_FIELD = 16;
+constexpr size_t BLOCK_PATH_ID_FIELD = 20;
+constexpr size_t BLOCK_INPUT_NETS_FIELD = 24;
+constexpr size_t BLOCK_OUTPUT_NETS_FIELD = 28;
+
+/**************************************************
+ * Public Constructor
+ *************************************************/
+BinaryArchBitstreamReader::BinaryArchBitstreamReader(const std::string& fname) {
+  fname_ = fname;
+  data_ = nullptr;
+  size_ = 0;
+
+  int fd = open(fname.c_str(), O_RDONLY);
+  if (-1 == fd) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Fail to open binary architecture bitstream!\n");
+  }
+
+  struct stat file_stat;
+  if (-1 == fstat(fd, &file_stat)) {
+    close(fd);
+    archfpga_throw(fname.c_str(), 0,
+                   "Fail to get the size of binary architecture bitstream!\n");
+  }
+  size_ = file_stat.st_size;
+
+  if (BINARY_ARCH_BITSTREAM_HEADER_SIZE > size_) {
+    close(fd);
+    archfpga_throw(fname.c_str(), 0,
+                   "Binary architecture bitstream is too small (%lu bytes) to contain a header!\n",
+                   size_);
+  }
+
+  void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  /* The mapping remains valid after the file is closed */
+  close(fd);
+  if (MAP_FAILED == addr) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Fail to map binary architecture bitstream to memory!\n");
+  }
+  data_ = static_cast<const uint8_t*>(addr);
+
+  /* From now on, the mapping will be released by the destructor if any error is thrown */
+  try {
+    /* Header */
+    if (!std::equal(BINARY_ARCH_BITSTREAM_MAGIC.begin(), BINARY_ARCH_BITSTREAM_MAGIC.end(), data_)) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid magic string of binary architecture bitstream!\n");
+    }
+
+    version_ = read_uint(4, 4);
+    if (BINARY_ARCH_BITSTREAM_VERSION != version_) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Unsupported version '%u' of binary architecture bitstream! Expect version '%u'\n",
+                     version_, BINARY_ARCH_BITSTREAM_VERSION);
+    }
+
+    num_blocks_ = read_uint(8, 8);
+    num_bits_ = read_uint(16, 8);
+    num_strings_ = read_uint(24, 8);
+    size_t string_data_size = read_uint(32, 8);
+
+    /* Locate the sections, the sizes are checked against the file size
+     * before any multiplication to avoid overflows
+     */
+    size_t offset = BINARY_ARCH_BITSTREAM_HEADER_SIZE;
+    if ( (0 == num_blocks_)
+      || ((size_ - offset) / BINARY_ARCH_BITSTREAM_BLOCK_SIZE < num_blocks_) ) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Binary architecture bitstream is truncated in block table!\n");
+    }
+    block_table_offset_ = offset;
+    offset += num_blocks_ * BINARY_ARCH_BITSTREAM_BLOCK_SIZE;
+
+    size_t num_data_bytes = num_bits_ / 8 + (0 != num_bits_ % 8 ? 1 : 0);
+    if (size_ - offset < num_data_bytes) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Binary architecture bitstream is truncated in data bits!\n");
+    }
+    data_offset_ = offset;
+    offset += num_data_bytes;
+
+    if ( (0 == num_strings_)
+      || ((size_ - offset) / 8 <= num_strings_) ) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Binary architecture bitstream is truncated in string table!\n");
+    }
+    string_table_offset_ = offset;
+    offset += (num_strings_ + 1) * 8;
+
+    if (size_ - offset < string_data_size) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Binary architecture bitstream is truncated in string data!\n");
+    }
+    string_data_offset_ = offset;
+
+    /* String table: offsets should be in an ascending order
+     * and string 0 should be empty
+     */
+    size_t prev_string_offset = 0;
+    for (size_t istr = 0; istr <= num_strings_; ++istr) {
+      size_t string_offset = read_uint(string_table_offset_ + 8 * istr, 8);
+      if ( (string_offset < prev_string_offset)
+        || (string_data_size < string_offset)
+        || ((1 == istr) && (0 != string_offset)) ) {
+        archfpga_throw(fname.c_str(), 0,
+                       "Invalid offset of string '%lu' in binary architecture bitstream!\n",
+                       istr);
+      }
+      prev_string_offset = string_offset;
+    }
+    if (string_data_size != prev_string_offset) {
+      archfpga_throw(fname.c_str(), 0,
+                     "String table does not cover the string data in binary architecture bitstream!\n");
+    }
+
+    /* Block table: parents should be stored before their children,
+     * and bits of the blocks should be consecutive
+     */
+    size_t next_bit = 0;
+    for (size_t iblk = 0; iblk < num_blocks_; ++iblk) {
+      size_t parent = block_parent(iblk);
+      if ( ((0 == iblk) && (BINARY_ARCH_BITSTREAM_INVALID_INDEX != parent))
+        || ((0 != iblk) && (iblk <= parent)) ) {
+        archfpga_throw(fname.c_str(), 0,
+                       "Invalid parent of block '%lu' in binary architecture bitstream!\n",
+                       iblk);
+      }
+
+      if ( (num_strings_ <= block_field(iblk, BLOCK_NAME_FIELD, 4))
+        || (num_strings_ <= block_field(iblk, BLOCK_INPUT_NETS_FIELD, 4))
+        || (num_strings_ <= block_field(iblk, BLOCK_OUTPUT_NETS_FIELD, 4)) ) {
+        archfpga_throw(fname.c_str(), 0,
+                       "Invalid string id of block '%lu' in binary architecture bitstream!\n",
+                       iblk);
+      }
+
+      if ( (next_bit != block_first_bit(iblk))
+        || (num_bits_ - next_bit < block_num_bits(iblk)) ) {
+        archfpga_throw(fname.c_str(), 0,
+                       "Invalid bits of block '%lu' in binary architecture bitstream!\n",
+                       iblk);
+      }
+      next_bit += block_num_bits(iblk);
+    }
+    if (num_bits_ != next_bit) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Blocks do not cover all the bits in binary architecture bitstream!\n");
+    }
+  } catch (...) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+    throw;
+  }
+}
+
+BinaryArchBitstreamReader::~BinaryArchBitstreamReader() {
+  munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+/******************************************************************************
+ * Public Accessors
+ ******************************************************************************/
+uint32_t BinaryArchBitstreamReader::version() const {
+  return version_;
+}
+
+size_t BinaryArchBitstreamReader::num_blocks() const {
+  return num_blocks_;
+}
+
+size_t BinaryArchBitstreamReader::num_bits() const {
+  return num_bits_;
+}
+
+std::string BinaryArchBitstreamReader::block_name(const size_t& block) const {
+  return read_string(block_field(block, BLOCK_NAME_FIELD, 4));
+}
+
+size_t BinaryArchBitstreamReader::block_parent(const size_t& block) const {
+  return block_field(block, BLOCK_PARENT_FIELD, 4);
+}
+
+size_t BinaryArchBitstreamReader::block_first_bit(const size_t& block) const {
+  return block_field(block, BLOCK_FIRST_BIT_FIELD, 8);
+}
+
+size_t BinaryArchBitstreamReader::block_num_bits(const size_t& block) const {
+  return block_field(block, BLOCK_NUM_BITS_FIELD, 4);
+}
+
+int BinaryArchBitstreamReader::block_path_id(const size_t& block) const {
+  return int32_t(uint32_t(block_field(block, BLOCK_PATH_ID_FIELD, 4)));
+}
+
+std::string BinaryArchBitstreamReader::block_input_net_ids(const size_t& block) const {
+  return read_string(block_field(block, BLOCK_INPUT_NETS_FIELD, 4));
+}
+
+std::string BinaryArchBitstreamReader::block_output_net_ids(const size_t& block) const {
+  return read_string(block_field(block, BLOCK_OUTPUT_NETS_FIELD, 4));
+}
+
+bool BinaryArchBitstreamReader::bit_value(const size_t& bit) const {
+  VTR_ASSERT(bit < num_bits_);
+  return 0 != (data_[data_offset_ + bit / 8] & (1 << (bit % 8)));
+}
+
+/******************************************************************************
+ * Internal decoders
+ ******************************************************************************/
+uint64_t BinaryArchBitstreamReader::read_uint(const size_t& offset,
+                                              const size_t& num_bytes) const {
+  if ( (size_ < offset)
+    || (size_ - offset < num_bytes) ) {
+    archfpga_throw(fname_.c_str(), 0,
+                   "Binary architecture bitstream is truncated at byte '%lu'!\n",
+                   offset);
+  }
+
+  uint64_t value = 0;
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    value |= (uint64_t(data_[offset + ibyte]) << (8 * ibyte));
+  }
+  return value;
+}
+
+size_t BinaryArchBitstreamReader::block_field(const size_t& block,
+                                              const size_t& field_offset,
+                                              const size_t& num_bytes) const {
+  VTR_ASSERT(block < num_blocks_);
+  return read_uint(block_table_offset_ + block * BINARY_ARCH_BITSTREAM_BLOCK_SIZE + field_offset, num_bytes);
+}
+
+std::string BinaryArchBitstreamReader::read_string(const size_t& string_id) const {
+  VTR_ASSERT(string_id < num_strings_);
+  size_t begin = read_uint(string_table_offset_ + 8 * string_id, 8);
+  size_t end = read_uint(string_table_offset_ + 8 * (string_id + 1), 8);
+  return std::string(reinterpret_cast<const char*>(data_) + string_data_offset_ + begin, end - begin);
+}
+
+} /* end namespace openfpga */
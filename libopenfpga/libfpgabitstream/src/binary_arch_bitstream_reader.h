@@ -0,0 +1,82 @@
+#ifndef BINARY_ARCH_BITSTREAM_READER_H
+#define BINARY_ARCH_BITSTREAM_READER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <string>
+#include <cstdint>
+
+#include "binary_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A reader of architecture bitstream in the binary container
+ * (see binary_arch_bitstream.h)
+ * The file is memory-mapped, so that only the pages which
+ * are accessed are loaded. Any block and any bit can be
+ * accessed in constant time without loading the whole file
+ *
+ * Blocks are indexed in the order they are stored in the file,
+ * where the top block is block 0
+ *
+ * Example:
+ *   BinaryArchBitstreamReader reader("arch_bitstream.bin");
+ *   for (size_t iblk = 0; iblk < reader.num_blocks(); ++iblk) {
+ *     reader.block_name(iblk);
+ *     reader.block_first_bit(iblk);
+ *   }
+ *******************************************************************/
+class BinaryArchBitstreamReader {
+  public: /* Public constructor */
+    /* Open and validate a file, error out if the file is invalid */
+    BinaryArchBitstreamReader(const std::string& fname);
+    ~BinaryArchBitstreamReader();
+    /* The reader owns the file mapping, which should not be copied */
+    BinaryArchBitstreamReader(const BinaryArchBitstreamReader&) = delete;
+    BinaryArchBitstreamReader& operator=(const BinaryArchBitstreamReader&) = delete;
+
+  public: /* Public accessors */
+    uint32_t version() const;
+    size_t num_blocks() const;
+    size_t num_bits() const;
+
+    std::string block_name(const size_t& block) const;
+    /* Return BINARY_ARCH_BITSTREAM_INVALID_INDEX for the top block */
+    size_t block_parent(const size_t& block) const;
+    size_t block_first_bit(const size_t& block) const;
+    size_t block_num_bits(const size_t& block) const;
+    /* Follow the convention of BitstreamManager::block_path_id() */
+    int block_path_id(const size_t& block) const;
+    std::string block_input_net_ids(const size_t& block) const;
+    std::string block_output_net_ids(const size_t& block) const;
+
+    bool bit_value(const size_t& bit) const;
+
+  private: /* Internal decoders */
+    uint64_t read_uint(const size_t& offset, const size_t& num_bytes) const;
+    size_t block_field(const size_t& block, const size_t& field_offset, const size_t& num_bytes) const;
+    std::string read_string(const size_t& string_id) const;
+
+  private: /* Internal data */
+    std::string fname_;
+    const uint8_t* data_;
+    size_t size_;
+
+    uint32_t version_;
+    size_t num_blocks_;
+    size_t num_bits_;
+    size_t num_strings_;
+
+    /* Offsets of the sections from the beginning of the file */
+    size_t block_table_offset_;
+    size_t string_table_offset_;
+    size_t string_data_offset_;
+    size_t data_offset_;
+};
+
+} /* end namespace openfpga */
+
+#endif
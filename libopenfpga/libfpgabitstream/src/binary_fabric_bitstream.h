@@ -0,0 +1,73 @@
+#ifndef BINARY_FABRIC_BITSTREAM_H
+#define BINARY_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * This file defines the binary container of fabric bitstream,
+ * which is an alternative of the plain text format to
+ * store large fabric bitstreams in a compact way
+ *
+ * All the integers are stored in little-endian
+ *
+ * +------------------------------------------------------------+
+ * | Header (40 bytes)                                          |
+ * |   [0:3]   magic string "OFBS"                              |
+ * |   [4:7]   version (uint32)                                 |
+ * |   [8:11]  configuration protocol type (uint32)             |
+ * |   [12:15] number of regions (uint32)                       |
+ * |   [16:23] number of bits (uint64)                          |
+ * |   [24:27] BL address width or frame address width (uint32) |
+ * |   [28:31] WL address width (uint32)                        |
+ * |   [32:35] address encoding (uint32)                        |
+ * |   [36:39] number of addresses in an address block (uint32) |
+ * +------------------------------------------------------------+
+ * | Region table                                               |
+ * |   For each region: first bit (uint64), number of bits      |
+ * |   (uint64)                                                 |
+ * +------------------------------------------------------------+
+ * | Data bits                                                  |
+ * |   Packed bits, 8 bits per byte, starting from the LSB      |
+ * +------------------------------------------------------------+
+ * | BL (or frame) address stream, if address width > 0         |
+ * +------------------------------------------------------------+
+ * | WL address stream, if address width > 0                   |
+ * +------------------------------------------------------------+
+ *
+ * Each address stream starts with the size of its payload (uint64)
+ * - For raw encoding, the payload contains packed address bits,
+ *   <address width> bits per configuration bit
+ * - For delta encoding, the payload is led by a block table,
+ *   which is the byte offset (uint64) of each block of addresses in the payload.
+ *   Each address is then the zigzag-encoded difference to the previous address,
+ *   stored as a variable-length integer.
+ *   The previous address is reset to 0 at the beginning of each block,
+ *   so that any address can be decoded without walking through the whole stream
+ *
+ * An address is converted to an integer where the first character of
+ * the address (see FabricBitstream::bit_address()) is the LSB
+ *******************************************************************/
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr std::array<char, 4> BINARY_FABRIC_BITSTREAM_MAGIC = {{'O', 'F', 'B', 'S'}};
+constexpr uint32_t BINARY_FABRIC_BITSTREAM_VERSION = 1;
+constexpr size_t BINARY_FABRIC_BITSTREAM_HEADER_SIZE = 40;
+
+/* Number of addresses in a block of delta-encoded addresses */
+constexpr uint32_t BINARY_FABRIC_BITSTREAM_ADDRESS_BLOCK_SIZE = 1024;
+
+/* The largest address width that can be delta-encoded */
+constexpr size_t BINARY_FABRIC_BITSTREAM_MAX_DELTA_ADDRESS_WIDTH = 64;
+
+enum e_binary_address_encoding {
+  BINARY_ADDRESS_RAW,
+  BINARY_ADDRESS_DELTA,
+  NUM_BINARY_ADDRESS_ENCODINGS
+};
+
+} /* end namespace openfpga */
+
+#endif
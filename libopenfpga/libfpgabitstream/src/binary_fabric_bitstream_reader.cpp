@@ -0,0 +1,336 @@
+/******************************************************************************
+ * This file includes member functions for the reader of binary fabric bitstream
+ ******************************************************************************/
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vtr_assert.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#include "binary_fabric_bitstream_reader.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Constructor
+ *************************************************/
+BinaryFabricBitstreamReader::BinaryFabricBitstreamReader(const std::string& fname) {
+  fname_ = fname;
+  data_ = nullptr;
+  size_ = 0;
+
+  int fd = open(fname.c_str(), O_RDONLY);
+  if (-1 == fd) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Fail to open binary fabric bitstream!\n");
+  }
+
+  struct stat file_stat;
+  if (-1 == fstat(fd, &file_stat)) {
+    close(fd);
+    archfpga_throw(fname.c_str(), 0,
+                   "Fail to get the size of binary fabric bitstream!\n");
+  }
+  size_ = file_stat.st_size;
+
+  if (BINARY_FABRIC_BITSTREAM_HEADER_SIZE > size_) {
+    close(fd);
+    archfpga_throw(fname.c_str(), 0,
+                   "Binary fabric bitstream is too small (%lu bytes) to contain a header!\n",
+                   size_);
+  }
+
+  void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  /* The mapping remains valid after the file is closed */
+  close(fd);
+  if (MAP_FAILED == addr) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Fail to map binary fabric bitstream to memory!\n");
+  }
+  data_ = static_cast<const uint8_t*>(addr);
+
+  /* From now on, the mapping will be released by the destructor if any error is thrown */
+  try {
+    /* Header */
+    if (!std::equal(BINARY_FABRIC_BITSTREAM_MAGIC.begin(), BINARY_FABRIC_BITSTREAM_MAGIC.end(), data_)) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid magic string of binary fabric bitstream!\n");
+    }
+
+    version_ = read_uint(4, 4);
+    if (BINARY_FABRIC_BITSTREAM_VERSION != version_) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Unsupported version '%u' of binary fabric bitstream! Expect version '%u'\n",
+                     version_, BINARY_FABRIC_BITSTREAM_VERSION);
+    }
+
+    uint64_t config_protocol_type = read_uint(8, 4);
+    if (NUM_CONFIG_PROTOCOL_TYPES <= config_protocol_type) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid configuration protocol type '%lu' of binary fabric bitstream!\n",
+                     config_protocol_type);
+    }
+    config_protocol_type_ = e_config_protocol_type(config_protocol_type);
+
+    size_t num_regions = read_uint(12, 4);
+    num_bits_ = read_uint(16, 8);
+    size_t bl_address_width = read_uint(24, 4);
+    size_t wl_address_width = read_uint(28, 4);
+
+    uint64_t address_encoding = read_uint(32, 4);
+    if (NUM_BINARY_ADDRESS_ENCODINGS <= address_encoding) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid address encoding '%lu' of binary fabric bitstream!\n",
+                     address_encoding);
+    }
+    address_encoding_ = e_binary_address_encoding(address_encoding);
+
+    address_block_size_ = read_uint(36, 4);
+    if (0 == address_block_size_) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid address block size of binary fabric bitstream!\n");
+    }
+
+    /* Region table */
+    size_t offset = BINARY_FABRIC_BITSTREAM_HEADER_SIZE;
+    region_first_bits_.reserve(num_regions);
+    region_num_bits_.reserve(num_regions);
+    for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+      uint64_t first_bit = read_uint(offset, 8);
+      uint64_t region_num_bits = read_uint(offset + 8, 8);
+      if ( (num_bits_ < first_bit)
+        || (num_bits_ - first_bit < region_num_bits) ) {
+        archfpga_throw(fname.c_str(), 0,
+                       "Region '%lu' of binary fabric bitstream exceeds the number of bits!\n",
+                       iregion);
+      }
+      region_first_bits_.push_back(first_bit);
+      region_num_bits_.push_back(region_num_bits);
+      offset += 16;
+    }
+
+    /* Data bits */
+    data_offset_ = offset;
+    offset += (num_bits_ + 7) / 8;
+    if (size_ < offset) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Binary fabric bitstream is truncated in data bits!\n");
+    }
+
+    /* Address streams */
+    offset = init_address_stream(bl_addresses_, bl_address_width, offset);
+    offset = init_address_stream(wl_addresses_, wl_address_width, offset);
+  } catch (...) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+    throw;
+  }
+}
+
+BinaryFabricBitstreamReader::~BinaryFabricBitstreamReader() {
+  munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+/******************************************************************************
+ * Public Accessors
+ ******************************************************************************/
+uint32_t BinaryFabricBitstreamReader::version() const {
+  return version_;
+}
+
+e_config_protocol_type BinaryFabricBitstreamReader::config_protocol_type() const {
+  return config_protocol_type_;
+}
+
+size_t BinaryFabricBitstreamReader::num_bits() const {
+  return num_bits_;
+}
+
+size_t BinaryFabricBitstreamReader::num_regions() const {
+  return region_first_bits_.size();
+}
+
+size_t BinaryFabricBitstreamReader::region_first_bit(const size_t& region) const {
+  VTR_ASSERT(region < num_regions());
+  return region_first_bits_[region];
+}
+
+size_t BinaryFabricBitstreamReader::region_num_bits(const size_t& region) const {
+  VTR_ASSERT(region < num_regions());
+  return region_num_bits_[region];
+}
+
+size_t BinaryFabricBitstreamReader::bl_address_width() const {
+  return bl_addresses_.width;
+}
+
+size_t BinaryFabricBitstreamReader::wl_address_width() const {
+  return wl_addresses_.width;
+}
+
+bool BinaryFabricBitstreamReader::bit_value(const size_t& bit) const {
+  VTR_ASSERT(bit < num_bits_);
+  return 0 != (data_[data_offset_ + bit / 8] & (1 << (bit % 8)));
+}
+
+std::vector<char> BinaryFabricBitstreamReader::bit_bl_address(const size_t& bit) const {
+  return decode_address(bl_addresses_, bit);
+}
+
+std::vector<char> BinaryFabricBitstreamReader::bit_wl_address(const size_t& bit) const {
+  return decode_address(wl_addresses_, bit);
+}
+
+std::vector<char> BinaryFabricBitstreamReader::bit_address(const size_t& bit) const {
+  return bit_bl_address(bit);
+}
+
+/******************************************************************************
+ * Internal decoders
+ ******************************************************************************/
+uint64_t BinaryFabricBitstreamReader::read_uint(const size_t& offset,
+                                                const size_t& num_bytes) const {
+  if ( (size_ < offset)
+    || (size_ - offset < num_bytes) ) {
+    archfpga_throw(fname_.c_str(), 0,
+                   "Binary fabric bitstream is truncated at byte '%lu'!\n",
+                   offset);
+  }
+
+  uint64_t value = 0;
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    value |= (uint64_t(data_[offset + ibyte]) << (8 * ibyte));
+  }
+  return value;
+}
+
+/********************************************************************
+ * Locate an address stream starting from the given offset,
+ * and return the offset of the byte after the stream
+ *******************************************************************/
+size_t BinaryFabricBitstreamReader::init_address_stream(t_address_stream& stream,
+                                                        const size_t& width,
+                                                        const size_t& offset) {
+  stream.width = width;
+  stream.payload_offset = offset;
+  stream.payload_size = 0;
+  stream.cursor_bit = 0;
+  stream.cursor_offset = 0;
+  stream.cursor_address = 0;
+
+  if (0 == width) {
+    return offset;
+  }
+
+  if ( (BINARY_ADDRESS_DELTA == address_encoding_)
+    && (BINARY_FABRIC_BITSTREAM_MAX_DELTA_ADDRESS_WIDTH < width) ) {
+    archfpga_throw(fname_.c_str(), 0,
+                   "Address width '%lu' is too large for delta encoding!\n",
+                   width);
+  }
+
+  stream.payload_size = read_uint(offset, 8);
+  stream.payload_offset = offset + 8;
+  if (size_ - stream.payload_offset < stream.payload_size) {
+    archfpga_throw(fname_.c_str(), 0,
+                   "Binary fabric bitstream is truncated in address stream!\n");
+  }
+
+  if (BINARY_ADDRESS_RAW == address_encoding_) {
+    if ((num_bits_ * width + 7) / 8 > stream.payload_size) {
+      archfpga_throw(fname_.c_str(), 0,
+                     "Address stream of binary fabric bitstream is too small!\n");
+    }
+  } else {
+    VTR_ASSERT(BINARY_ADDRESS_DELTA == address_encoding_);
+    size_t num_blocks = (num_bits_ + address_block_size_ - 1) / address_block_size_;
+    if (8 * num_blocks > stream.payload_size) {
+      archfpga_throw(fname_.c_str(), 0,
+                     "Block table of binary fabric bitstream is truncated!\n");
+    }
+    for (size_t iblock = 0; iblock < num_blocks; ++iblock) {
+      if (stream.payload_size <= read_uint(stream.payload_offset + 8 * iblock, 8)) {
+        archfpga_throw(fname_.c_str(), 0,
+                       "Block '%lu' of address stream is out of range!\n",
+                       iblock);
+      }
+    }
+  }
+
+  return stream.payload_offset + stream.payload_size;
+}
+
+std::vector<char> BinaryFabricBitstreamReader::decode_address(const t_address_stream& stream,
+                                                              const size_t& bit) const {
+  VTR_ASSERT(bit < num_bits_);
+
+  std::vector<char> address(stream.width, '0');
+  if (0 == stream.width) {
+    return address;
+  }
+
+  const uint8_t* payload = data_ + stream.payload_offset;
+
+  if (BINARY_ADDRESS_RAW == address_encoding_) {
+    size_t bit_offset = bit * stream.width;
+    for (size_t ibit = 0; ibit < stream.width; ++ibit) {
+      if (0 != (payload[(bit_offset + ibit) / 8] & (1 << ((bit_offset + ibit) % 8)))) {
+        address[ibit] = '1';
+      }
+    }
+    return address;
+  }
+
+  VTR_ASSERT(BINARY_ADDRESS_DELTA == address_encoding_);
+
+  /* Resume from the cursor if it is in the same block and not beyond the bit,
+   * otherwise restart from the beginning of the block
+   */
+  size_t block_first_bit = bit - bit % address_block_size_;
+  if ( (stream.cursor_bit <= block_first_bit)
+    || (stream.cursor_bit > bit) ) {
+    stream.cursor_bit = block_first_bit;
+    stream.cursor_offset = read_uint(stream.payload_offset + 8 * (block_first_bit / address_block_size_), 8);
+    stream.cursor_address = 0;
+  }
+
+  while (stream.cursor_bit <= bit) {
+    /* Decode a variable-length integer */
+    uint64_t zigzag = 0;
+    size_t shift = 0;
+    while (true) {
+      if ( (stream.cursor_offset >= stream.payload_size)
+        || (64 <= shift) ) {
+        archfpga_throw(fname_.c_str(), 0,
+                       "Corrupted address stream of binary fabric bitstream at bit '%lu'!\n",
+                       stream.cursor_bit);
+      }
+      uint8_t byte = payload[stream.cursor_offset];
+      stream.cursor_offset++;
+      zigzag |= (uint64_t(byte & 0x7f) << shift);
+      shift += 7;
+      if (0 == (byte & 0x80)) {
+        break;
+      }
+    }
+    uint64_t delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+    stream.cursor_address += delta;
+    stream.cursor_bit++;
+  }
+
+  for (size_t ibit = 0; ibit < stream.width; ++ibit) {
+    if (0 != (stream.cursor_address & (uint64_t(1) << ibit))) {
+      address[ibit] = '1';
+    }
+  }
+
+  return address;
+}
+
+} /* end namespace openfpga */
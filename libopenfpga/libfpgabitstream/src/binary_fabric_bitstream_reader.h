@@ -0,0 +1,100 @@
+#ifndef BINARY_FABRIC_BITSTREAM_READER_H
+#define BINARY_FABRIC_BITSTREAM_READER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "circuit_types.h"
+#include "binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A reader of fabric bitstream in the binary container
+ * (see binary_fabric_bitstream.h)
+ * The file is memory-mapped, so that only the pages which
+ * are accessed are loaded. Any bit and its address can be
+ * decoded in constant time without loading the whole file
+ *
+ * Example:
+ *   BinaryFabricBitstreamReader reader("fabric_bitstream.bin");
+ *   for (size_t ibit = 0; ibit < reader.num_bits(); ++ibit) {
+ *     reader.bit_value(ibit);
+ *     reader.bit_bl_address(ibit);
+ *   }
+ *******************************************************************/
+class BinaryFabricBitstreamReader {
+  public: /* Public constructor */
+    /* Open and validate a file, error out if the file is invalid */
+    BinaryFabricBitstreamReader(const std::string& fname);
+    ~BinaryFabricBitstreamReader();
+    /* The reader owns the file mapping, which should not be copied */
+    BinaryFabricBitstreamReader(const BinaryFabricBitstreamReader&) = delete;
+    BinaryFabricBitstreamReader& operator=(const BinaryFabricBitstreamReader&) = delete;
+
+  public: /* Public accessors */
+    uint32_t version() const;
+    e_config_protocol_type config_protocol_type() const;
+    size_t num_bits() const;
+    size_t num_regions() const;
+    size_t region_first_bit(const size_t& region) const;
+    size_t region_num_bits(const size_t& region) const;
+    size_t bl_address_width() const;
+    size_t wl_address_width() const;
+
+    bool bit_value(const size_t& bit) const;
+
+    /* Addresses are in the format of FabricBitstream::bit_address() */
+    std::vector<char> bit_bl_address(const size_t& bit) const;
+    std::vector<char> bit_wl_address(const size_t& bit) const;
+    /* Alias of bit_bl_address(), for the protocols with a single address */
+    std::vector<char> bit_address(const size_t& bit) const;
+
+  private: /* Internal decoders */
+    struct t_address_stream {
+      size_t width;
+      /* Offset of the payload from the beginning of the file */
+      size_t payload_offset;
+      size_t payload_size;
+      /* Cursor of the last decoded address, to speed up sequential access */
+      mutable size_t cursor_bit;
+      mutable size_t cursor_offset;
+      mutable uint64_t cursor_address;
+    };
+
+    uint64_t read_uint(const size_t& offset, const size_t& num_bytes) const;
+    size_t init_address_stream(t_address_stream& stream,
+                               const size_t& width,
+                               const size_t& offset);
+    std::vector<char> decode_address(const t_address_stream& stream,
+                                     const size_t& bit) const;
+
+  private: /* Internal data */
+    std::string fname_;
+    const uint8_t* data_;
+    size_t size_;
+
+    uint32_t version_;
+    e_config_protocol_type config_protocol_type_;
+    size_t num_bits_;
+    e_binary_address_encoding address_encoding_;
+    size_t address_block_size_;
+
+    std::vector<uint64_t> region_first_bits_;
+    std::vector<uint64_t> region_num_bits_;
+
+    /* Offset of the data bits from the beginning of the file */
+    size_t data_offset_;
+
+    t_address_stream bl_addresses_;
+    t_address_stream wl_addresses_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,230 @@
+/******************************************************************************
+ * This file includes member functions for the writer of binary fabric bitstream
+ ******************************************************************************/
+#include <fstream>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "binary_fabric_bitstream_writer.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Append an unsigned integer to a buffer in little-endian
+ *******************************************************************/
+static
+void append_binary_uint(std::vector<uint8_t>& buffer,
+                        const uint64_t& value,
+                        const size_t& num_bytes) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    buffer.push_back(uint8_t((value >> (8 * ibyte)) & 0xff));
+  }
+}
+
+/********************************************************************
+ * Append an unsigned integer to a buffer as a variable-length integer
+ * Each byte carries 7 bits of the value, and the MSB of a byte
+ * indicates if more bytes follow
+ *******************************************************************/
+static
+void append_binary_varint(std::vector<uint8_t>& buffer,
+                          const uint64_t& value) {
+  uint64_t remain = value;
+  while (0x80 <= remain) {
+    buffer.push_back(uint8_t((remain & 0x7f) | 0x80));
+    remain >>= 7;
+  }
+  buffer.push_back(uint8_t(remain));
+}
+
+/********************************************************************
+ * Write the bytes of a buffer to a binary file stream
+ *******************************************************************/
+static
+void write_binary_buffer(std::fstream& fp,
+                         const std::vector<uint8_t>& buffer) {
+  fp.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+}
+
+/**************************************************
+ * Public Constructor
+ *************************************************/
+BinaryFabricBitstreamWriter::BinaryFabricBitstreamWriter(const e_config_protocol_type& config_protocol_type,
+                                                         const size_t& bl_address_width,
+                                                         const size_t& wl_address_width) {
+  config_protocol_type_ = config_protocol_type;
+  num_bits_ = 0;
+
+  /* Use delta encoding only when all the addresses can be converted to integers */
+  if ( (BINARY_FABRIC_BITSTREAM_MAX_DELTA_ADDRESS_WIDTH >= bl_address_width)
+    && (BINARY_FABRIC_BITSTREAM_MAX_DELTA_ADDRESS_WIDTH >= wl_address_width) ) {
+    address_encoding_ = BINARY_ADDRESS_DELTA;
+  } else {
+    address_encoding_ = BINARY_ADDRESS_RAW;
+  }
+
+  init_address_stream(bl_addresses_, bl_address_width);
+  init_address_stream(wl_addresses_, wl_address_width);
+}
+
+/******************************************************************************
+ * Public Accessors
+ ******************************************************************************/
+size_t BinaryFabricBitstreamWriter::num_bits() const {
+  return num_bits_;
+}
+
+/******************************************************************************
+ * Public Mutators
+ ******************************************************************************/
+void BinaryFabricBitstreamWriter::add_region() {
+  region_first_bits_.push_back(num_bits_);
+}
+
+void BinaryFabricBitstreamWriter::add_bit(const bool& bit_value,
+                                          const std::vector<char>& bl_address,
+                                          const std::vector<char>& wl_address) {
+  /* Ensure we have a region to add the bit */
+  VTR_ASSERT(false == region_first_bits_.empty());
+
+  if (0 == num_bits_ % 8) {
+    data_bits_.push_back(0);
+  }
+  if (true == bit_value) {
+    data_bits_.back() |= uint8_t(1 << (num_bits_ % 8));
+  }
+
+  add_address(bl_addresses_, bl_address);
+  add_address(wl_addresses_, wl_address);
+
+  num_bits_++;
+}
+
+int BinaryFabricBitstreamWriter::write_to_file(const std::string& fname) const {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s' to output binary fabric bitstream!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  /* The sections are written to the file one by one,
+   * so that the large data bits and address payloads are not copied in memory.
+   * Only the small header and tables are staged in a buffer
+   */
+  std::vector<uint8_t> buffer;
+
+  /* Header */
+  buffer.insert(buffer.end(), BINARY_FABRIC_BITSTREAM_MAGIC.begin(), BINARY_FABRIC_BITSTREAM_MAGIC.end());
+  append_binary_uint(buffer, BINARY_FABRIC_BITSTREAM_VERSION, 4);
+  append_binary_uint(buffer, config_protocol_type_, 4);
+  append_binary_uint(buffer, region_first_bits_.size(), 4);
+  append_binary_uint(buffer, num_bits_, 8);
+  append_binary_uint(buffer, bl_addresses_.width, 4);
+  append_binary_uint(buffer, wl_addresses_.width, 4);
+  append_binary_uint(buffer, address_encoding_, 4);
+  append_binary_uint(buffer, BINARY_FABRIC_BITSTREAM_ADDRESS_BLOCK_SIZE, 4);
+  VTR_ASSERT(BINARY_FABRIC_BITSTREAM_HEADER_SIZE == buffer.size());
+
+  /* Region table */
+  for (size_t iregion = 0; iregion < region_first_bits_.size(); ++iregion) {
+    uint64_t region_end = num_bits_;
+    if (iregion + 1 < region_first_bits_.size()) {
+      region_end = region_first_bits_[iregion + 1];
+    }
+    append_binary_uint(buffer, region_first_bits_[iregion], 8);
+    append_binary_uint(buffer, region_end - region_first_bits_[iregion], 8);
+  }
+  write_binary_buffer(fp, buffer);
+
+  /* Data bits */
+  write_binary_buffer(fp, data_bits_);
+
+  /* Address streams */
+  write_address_stream(fp, bl_addresses_);
+  write_address_stream(fp, wl_addresses_);
+
+  fp.close();
+  if (fp.fail()) {
+    VTR_LOG_ERROR("Fail to write binary fabric bitstream to file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+/******************************************************************************
+ * Internal encoders
+ ******************************************************************************/
+void BinaryFabricBitstreamWriter::init_address_stream(t_address_stream& stream,
+                                                      const size_t& width) {
+  stream.width = width;
+  stream.encoding = address_encoding_;
+  stream.payload.clear();
+  stream.block_offsets.clear();
+  stream.prev_address = 0;
+}
+
+void BinaryFabricBitstreamWriter::add_address(t_address_stream& stream,
+                                              const std::vector<char>& address) {
+  VTR_ASSERT(stream.width == address.size());
+
+  if (0 == stream.width) {
+    return;
+  }
+
+  if (BINARY_ADDRESS_RAW == stream.encoding) {
+    size_t bit_offset = num_bits_ * stream.width;
+    stream.payload.resize((bit_offset + stream.width + 7) / 8, 0);
+    for (size_t ibit = 0; ibit < stream.width; ++ibit) {
+      if ('1' == address[ibit]) {
+        stream.payload[(bit_offset + ibit) / 8] |= uint8_t(1 << ((bit_offset + ibit) % 8));
+      }
+    }
+    return;
+  }
+
+  VTR_ASSERT(BINARY_ADDRESS_DELTA == stream.encoding);
+
+  /* Start a new block, where the delta encoding restarts */
+  if (0 == num_bits_ % BINARY_FABRIC_BITSTREAM_ADDRESS_BLOCK_SIZE) {
+    stream.block_offsets.push_back(stream.payload.size());
+    stream.prev_address = 0;
+  }
+
+  uint64_t curr_address = 0;
+  for (size_t ibit = 0; ibit < stream.width; ++ibit) {
+    if ('1' == address[ibit]) {
+      curr_address |= (uint64_t(1) << ibit);
+    }
+  }
+
+  /* Zigzag encoding of the difference, so that small negative values are still short */
+  int64_t delta = int64_t(curr_address - stream.prev_address);
+  uint64_t zigzag = (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+  append_binary_varint(stream.payload, zigzag);
+
+  stream.prev_address = curr_address;
+}
+
+void BinaryFabricBitstreamWriter::write_address_stream(std::fstream& fp,
+                                                       const t_address_stream& stream) const {
+  if (0 == stream.width) {
+    return;
+  }
+
+  std::vector<uint8_t> buffer;
+  size_t block_table_size = 8 * stream.block_offsets.size();
+  append_binary_uint(buffer, block_table_size + stream.payload.size(), 8);
+  for (const uint64_t& block_offset : stream.block_offsets) {
+    append_binary_uint(buffer, block_table_size + block_offset, 8);
+  }
+  write_binary_buffer(fp, buffer);
+  write_binary_buffer(fp, stream.payload);
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,88 @@
+#ifndef BINARY_FABRIC_BITSTREAM_WRITER_H
+#define BINARY_FABRIC_BITSTREAM_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "circuit_types.h"
+#include "binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A writer to output a fabric bitstream in the binary container
+ * (see binary_fabric_bitstream.h)
+ * Configuration bits are added region by region,
+ * and they are encoded on the fly.
+ * The file is outputted when all the bits are added
+ *
+ * Example:
+ *   BinaryFabricBitstreamWriter writer(CONFIG_MEM_FRAME_BASED, 16, 0);
+ *   writer.add_region();
+ *   writer.add_bit(true, address, std::vector<char>());
+ *   ...
+ *   writer.write_to_file("fabric_bitstream.bin");
+ *******************************************************************/
+class BinaryFabricBitstreamWriter {
+  public: /* Public constructor */
+    BinaryFabricBitstreamWriter(const e_config_protocol_type& config_protocol_type,
+                                const size_t& bl_address_width,
+                                const size_t& wl_address_width);
+
+  public: /* Public mutators */
+    /* Start a new region, the following bits will be added to the region */
+    void add_region();
+
+    /* Add a configuration bit to the last region
+     * Addresses are in the format of FabricBitstream::bit_address(),
+     * and should be empty if the address width is zero
+     */
+    void add_bit(const bool& bit_value,
+                 const std::vector<char>& bl_address,
+                 const std::vector<char>& wl_address);
+
+    /* Output the binary container to a file
+     * Return 0 if succeed, 1 if the file cannot be written
+     */
+    int write_to_file(const std::string& fname) const;
+
+  public: /* Public accessors */
+    size_t num_bits() const;
+
+  private: /* Internal encoders */
+    struct t_address_stream {
+      size_t width;
+      e_binary_address_encoding encoding;
+      std::vector<uint8_t> payload;
+      std::vector<uint64_t> block_offsets;
+      uint64_t prev_address;
+    };
+
+    void init_address_stream(t_address_stream& stream, const size_t& width);
+    void add_address(t_address_stream& stream, const std::vector<char>& address);
+    void write_address_stream(std::fstream& fp, const t_address_stream& stream) const;
+
+  private: /* Internal data */
+    e_config_protocol_type config_protocol_type_;
+    size_t num_bits_;
+    e_binary_address_encoding address_encoding_;
+
+    /* First bit of each region */
+    std::vector<uint64_t> region_first_bits_;
+
+    /* Packed data bits */
+    std::vector<uint8_t> data_bits_;
+
+    t_address_stream bl_addresses_;
+    t_address_stream wl_addresses_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -49,14 +49,18 @@ bool BitstreamManager::bit_value(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return '1' == bit_values_[bit_id];
+  return bit_values_[size_t(bit_id)];
 }
 
 ConfigBlockId BitstreamManager::bit_parent_block(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return bit_parent_blocks_[bit_id];
+  /* Find the last range whose first bit is not larger than the bit */
+  auto range_it = std::upper_bound(bit_parent_block_range_lsbs_.begin(), bit_parent_block_range_lsbs_.end(), bit_id);
+  VTR_ASSERT(range_it != bit_parent_block_range_lsbs_.begin());
+
+  return bit_parent_block_range_blocks_[std::distance(bit_parent_block_range_lsbs_.begin(), range_it) - 1];
 }
 
 std::string BitstreamManager::block_name(const ConfigBlockId& block_id) const {
@@ -73,13 +77,20 @@ ConfigBlockId BitstreamManager::block_parent(const ConfigBlockId& block_id) cons
   return parent_block_ids_[block_id];
 }
 
-std::vector<ConfigBlockId> BitstreamManager::block_children(const ConfigBlockId& block_id) const {
+const std::vector<ConfigBlockId>& BitstreamManager::block_children(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
   return child_block_ids_[block_id];
 }
 
+const std::vector<ConfigBlockId>& BitstreamManager::configurable_child_blocks(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  return configurable_child_block_ids_[block_id];
+}
+
 std::vector<ConfigBitId> BitstreamManager::block_bits(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
@@ -151,13 +162,14 @@ ConfigBitId BitstreamManager::add_bit(const ConfigBlockId& parent_block, const b
   ConfigBitId bit = ConfigBitId(num_bits_);
   /* Add a new bit, and allocate associated data structures */
   num_bits_++;
-  if (true == bit_value) {
-    bit_values_.push_back('1');
-  } else {
-    bit_values_.push_back('0');
-  }
+  bit_values_.push_back(bit_value);
 
-  bit_parent_blocks_.push_back(parent_block);
+  /* Start a new range of bits when the parent block changes */
+  if ( (true == bit_parent_block_range_blocks_.empty())
+    || (parent_block != bit_parent_block_range_blocks_.back()) ) {
+    bit_parent_block_range_lsbs_.push_back(bit);
+    bit_parent_block_range_blocks_.push_back(parent_block);
+  }
 
   return bit; 
 }
@@ -171,6 +183,7 @@ void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
   block_output_net_ids_.reserve(num_blocks);
   parent_block_ids_.reserve(num_blocks);
   child_block_ids_.reserve(num_blocks);
+  configurable_child_block_ids_.reserve(num_blocks);
 }
 
 void BitstreamManager::reserve_bits(const size_t& num_bits) {
@@ -189,6 +202,7 @@ ConfigBlockId BitstreamManager::create_block() {
   block_output_net_ids_.emplace_back();
   parent_block_ids_.push_back(ConfigBlockId::INVALID());
   child_block_ids_.emplace_back();
+  configurable_child_block_ids_.emplace_back();
 
   return block; 
 }
@@ -234,6 +248,20 @@ void BitstreamManager::add_child_block(const ConfigBlockId& parent_block, const
   parent_block_ids_[child_block] = parent_block;
 }
 
+void BitstreamManager::set_configurable_child_blocks(const ConfigBlockId& parent_block,
+                                                     const std::vector<ConfigBlockId>& child_blocks) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+
+  /* Each child block should be a child of the parent block */
+  for (const ConfigBlockId& child_block : child_blocks) {
+    VTR_ASSERT( (ConfigBlockId::INVALID() == child_block)
+             || (parent_block == parent_block_ids_[child_block]) );
+  }
+
+  configurable_child_block_ids_[parent_block] = child_blocks;
+}
+
 void BitstreamManager::add_block_bits(const ConfigBlockId& block,
                                       const std::vector<bool>& block_bitstream) {
   /* Ensure the input ids are valid */
@@ -18,6 +18,8 @@
  * in the sequence to fit different configuration protocol. 
  * By using the link between ModuleManager and BitstreamManager, 
  * we can build a sequence of configuration bits to fit different configuration protocols.
+ * The link can be resolved once and stored as configurable_child_blocks(),
+ * so that the sequence can be built without searching blocks by names.
  *
  *     +------------------+                                 +-----------------+
  *     |                  |   block_name == instance_name   |                 |
@@ -129,7 +131,12 @@ class BitstreamManager {
     ConfigBlockId block_parent(const ConfigBlockId& block_id) const;
 
     /* Find the children of a block */
-    std::vector<ConfigBlockId> block_children(const ConfigBlockId& block_id) const;
+    const std::vector<ConfigBlockId>& block_children(const ConfigBlockId& block_id) const;
+
+    /* Find the children of a block in the sequence of the configurable children
+     * of the associated module in ModuleManager (see set_configurable_child_blocks()) 
+     */
+    const std::vector<ConfigBlockId>& configurable_child_blocks(const ConfigBlockId& block_id) const;
 
     /* Find all the bits that belong to a block */
     std::vector<ConfigBitId> block_bits(const ConfigBlockId& block_id) const;
@@ -173,6 +180,13 @@ class BitstreamManager {
     /* Set a block as a child block of another */
     void add_child_block(const ConfigBlockId& parent_block, const ConfigBlockId& child_block);
 
+    /* Link the children of a block to the configurable children of the associated module in ModuleManager
+     * The i-th element is the block of the i-th configurable child,
+     * or an invalid id if the configurable child has no block, e.g., a decoder
+     */
+    void set_configurable_child_blocks(const ConfigBlockId& parent_block,
+                                       const std::vector<ConfigBlockId>& child_blocks);
+
     /* Add a bitstream to a block */
     void add_block_bits(const ConfigBlockId& block,
                         const std::vector<bool>& block_bitstream);
@@ -211,6 +225,11 @@ class BitstreamManager {
     vtr::vector<ConfigBlockId, ConfigBlockId> parent_block_ids_; 
     vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>> child_block_ids_; 
 
+    /* Child blocks indexed by the configurable children of the associated module in ModuleManager
+     * This is a cross-reference to build fabric-dependent bitstream without searching blocks by names
+     */
+    vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>> configurable_child_block_ids_; 
+
     /* The ids of the inputs of routing multiplexer blocks which is propagated to outputs 
      * By default, it will be -2 (which is invalid)
      * A valid id starts from -1 
@@ -236,9 +255,23 @@ class BitstreamManager {
     /* Unique id of a bit in the Bitstream */
     size_t num_bits_; 
     std::unordered_set<ConfigBitId> invalid_bit_ids_; 
-    /* value of a bit in the Bitstream */
-    vtr::vector<ConfigBitId, char> bit_values_;
-    vtr::vector<ConfigBitId, ConfigBlockId> bit_parent_blocks_;
+    /* value of a bit in the Bitstream 
+     * Note: 
+     *   - Values are stored in a bit-packed vector to be memory efficient
+     *     as there can be millions of bits in the bitstream
+     */
+    std::vector<bool> bit_values_;
+
+    /* Parent blocks of the bits 
+     * Bits of a block are always added consecutively,
+     * so that the parent blocks are stored as a list of bit ranges
+     * rather than a parent block id per bit 
+     * - bit_parent_block_range_lsbs_ is the first bit of each range
+     *   which is in an ascending order
+     * - bit_parent_block_range_blocks_ is the parent block of each range
+     */
+    std::vector<ConfigBitId> bit_parent_block_range_lsbs_;
+    std::vector<ConfigBlockId> bit_parent_block_range_blocks_;
 };
 
 } /* end namespace openfpga */
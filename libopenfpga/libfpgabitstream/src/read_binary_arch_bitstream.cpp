@@ -0,0 +1,92 @@
+/********************************************************************
+ * This file includes the top-level function to read
+ * an architecture bitstream in the binary format
+ * (see binary_arch_bitstream.h) to an object of BitstreamManager
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#include "openfpga_reserved_words.h"
+
+#include "binary_arch_bitstream_reader.h"
+#include "read_binary_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Build a BitstreamManager from a binary architecture bitstream
+ *
+ * The blocks are stored in a Depth-First Search order,
+ * where a parent block is always stored before its child blocks.
+ * Therefore, the blocks and bits can be created in the same order as they
+ * are stored, in a single pass without any recursion,
+ * and the block ids are the same as the indices in the file
+ *******************************************************************/
+BitstreamManager read_binary_architecture_bitstream(const std::string& fname) {
+
+  vtr::ScopedStartFinishTimer timer("Read Architecture Bitstream binary file");
+
+  BitstreamManager bitstream_manager;
+
+  BinaryArchBitstreamReader reader(fname);
+
+  /* Find the name of the top block*/
+  std::string top_block_name = reader.block_name(0);
+  if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Top-level block must be named as '%s'!\n",
+                   FPGA_TOP_MODULE_NAME);
+  }
+
+  bitstream_manager.reserve_blocks(reader.num_blocks());
+  bitstream_manager.reserve_bits(reader.num_bits());
+
+  std::vector<bool> block_bits;
+  for (size_t iblk = 0; iblk < reader.num_blocks(); ++iblk) {
+    ConfigBlockId curr_block = bitstream_manager.add_block(reader.block_name(iblk));
+    VTR_ASSERT(size_t(curr_block) == iblk);
+
+    if (0 < iblk) {
+      bitstream_manager.add_child_block(ConfigBlockId(reader.block_parent(iblk)), curr_block);
+    }
+
+    std::string input_net_ids = reader.block_input_net_ids(iblk);
+    if (false == input_net_ids.empty()) {
+      bitstream_manager.add_input_net_id_to_block(curr_block, input_net_ids);
+    }
+
+    std::string output_net_ids = reader.block_output_net_ids(iblk);
+    if (false == output_net_ids.empty()) {
+      bitstream_manager.add_output_net_id_to_block(curr_block, output_net_ids);
+    }
+
+    /* -2 is an invalid value defined in the bitstream manager internally */
+    if (-2 < reader.block_path_id(iblk)) {
+      bitstream_manager.add_path_id_to_block(curr_block, reader.block_path_id(iblk));
+    }
+
+    if (0 == reader.block_num_bits(iblk)) {
+      continue;
+    }
+
+    block_bits.clear();
+    size_t first_bit = reader.block_first_bit(iblk);
+    for (size_t ibit = first_bit; ibit < first_bit + reader.block_num_bits(iblk); ++ibit) {
+      block_bits.push_back(reader.bit_value(ibit));
+    }
+    /* Link the bit to parent block */
+    bitstream_manager.add_block_bits(curr_block, block_bits);
+  }
+
+  return bitstream_manager;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,218 @@
+/********************************************************************
+ * This file includes functions that output bitstream database
+ * to a file in the binary format (see binary_arch_bitstream.h)
+ *******************************************************************/
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "bitstream_manager_utils.h"
+#include "binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write an unsigned integer to a file in little-endian
+ *******************************************************************/
+static
+void write_binary_uint(std::fstream& fp,
+                       const uint64_t& value,
+                       const size_t& num_bytes) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    fp.put(char((value >> (8 * ibyte)) & 0xff));
+  }
+}
+
+/********************************************************************
+ * A string table where each distinct string is stored only once
+ *******************************************************************/
+class BinaryStringTable {
+  public:
+    BinaryStringTable() {
+      /* String 0 is reserved for the empty string */
+      find_or_add(std::string());
+    }
+
+    uint32_t find_or_add(const std::string& str) {
+      auto result = ids_.emplace(str, uint32_t(offsets_.size()));
+      if (true == result.second) {
+        VTR_ASSERT(BINARY_ARCH_BITSTREAM_INVALID_INDEX > offsets_.size());
+        offsets_.push_back(data_.size());
+        data_.insert(data_.end(), str.begin(), str.end());
+      }
+      return result.first->second;
+    }
+
+    size_t num_strings() const {
+      return offsets_.size();
+    }
+
+    size_t data_size() const {
+      return data_.size();
+    }
+
+    void write(std::fstream& fp) const {
+      for (const uint64_t& offset : offsets_) {
+        write_binary_uint(fp, offset, 8);
+      }
+      write_binary_uint(fp, data_.size(), 8);
+      fp.write(data_.data(), data_.size());
+    }
+
+  private:
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<uint64_t> offsets_;
+    std::vector<char> data_;
+};
+
+/********************************************************************
+ * Write the header, where the sizes of the string table are
+ * only known after all the blocks have been written
+ *******************************************************************/
+static
+void write_binary_arch_bitstream_header(std::fstream& fp,
+                                        const size_t& num_blocks,
+                                        const size_t& num_bits,
+                                        const BinaryStringTable& string_table) {
+  fp.write(BINARY_ARCH_BITSTREAM_MAGIC.data(), BINARY_ARCH_BITSTREAM_MAGIC.size());
+  write_binary_uint(fp, BINARY_ARCH_BITSTREAM_VERSION, 4);
+  write_binary_uint(fp, num_blocks, 8);
+  write_binary_uint(fp, num_bits, 8);
+  write_binary_uint(fp, string_table.num_strings(), 8);
+  write_binary_uint(fp, string_table.data_size(), 8);
+}
+
+/********************************************************************
+ * Write the bitstream to a file without binding to the configuration
+ * procotols of a given FPGA fabric in binary format
+ *
+ * The blocks are visited in the same Depth-First Search order as
+ * the XML writer, so that reading either file results in
+ * the same bitstream database.
+ * Unlike the XML writer, the hierarchy of each block is not outputted,
+ * as it can be rebuilt from the parent indices,
+ * and the net ids are stored as they are, without being split.
+ *
+ * Each section is written to the file as it is produced:
+ * the block table while visiting the blocks, then the data bits
+ * of the blocks in the same order, and finally the string table.
+ * Only the string table, which deduplicates the names and net ids,
+ * and the order of the blocks are kept in memory.
+ * The header is written again at the end with the sizes of the string table
+ *
+ * Return 0 if succeed, 1 if the file cannot be written
+ *******************************************************************/
+int write_binary_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                        const std::string& fname) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(bitstream_manager.num_bits()) + std::string(" architecture independent bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Find the top block, which has not parents */
+  std::vector<ConfigBlockId> top_block = find_bitstream_manager_top_blocks(bitstream_manager);
+  /* Make sure we have only 1 top block */
+  VTR_ASSERT(1 == top_block.size());
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s' to output binary architecture bitstream!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  BinaryStringTable string_table;
+  std::vector<ConfigBlockId> block_order;
+  block_order.reserve(bitstream_manager.num_blocks());
+  size_t num_bits = 0;
+
+  /* Reserve the header, which is completed once the string table is built */
+  write_binary_arch_bitstream_header(fp, 0, 0, string_table);
+
+  /* Block table
+   * Depth-First Search without recursion, as the block tree can be deep.
+   * Each stack entry is a block and the index of its parent in the block table
+   */
+  std::vector<std::pair<ConfigBlockId, uint32_t>> block_stack;
+  block_stack.push_back(std::make_pair(top_block[0], BINARY_ARCH_BITSTREAM_INVALID_INDEX));
+  while (false == block_stack.empty()) {
+    ConfigBlockId block = block_stack.back().first;
+    uint32_t parent_index = block_stack.back().second;
+    block_stack.pop_back();
+
+    VTR_ASSERT(BINARY_ARCH_BITSTREAM_INVALID_INDEX > block_order.size());
+    uint32_t block_index = block_order.size();
+    block_order.push_back(block);
+
+    size_t block_num_bits = bitstream_manager.block_bits(block).size();
+
+    write_binary_uint(fp, string_table.find_or_add(bitstream_manager.block_name(block)), 4);
+    write_binary_uint(fp, parent_index, 4);
+    write_binary_uint(fp, num_bits, 8);
+    write_binary_uint(fp, block_num_bits, 4);
+    write_binary_uint(fp, uint32_t(int32_t(bitstream_manager.block_path_id(block))), 4);
+    write_binary_uint(fp, string_table.find_or_add(bitstream_manager.block_input_net_ids(block)), 4);
+    write_binary_uint(fp, string_table.find_or_add(bitstream_manager.block_output_net_ids(block)), 4);
+
+    num_bits += block_num_bits;
+
+    /* Push the child blocks in a reversed order, so that they are visited in order */
+    const std::vector<ConfigBlockId>& child_blocks = bitstream_manager.block_children(block);
+    for (auto it = child_blocks.rbegin(); it != child_blocks.rend(); ++it) {
+      block_stack.push_back(std::make_pair(*it, block_index));
+    }
+  }
+
+  /* Data bits, packed in the order of the block table */
+  uint8_t data_byte = 0;
+  size_t ibit = 0;
+  for (const ConfigBlockId& block : block_order) {
+    for (const ConfigBitId& bit : bitstream_manager.block_bits(block)) {
+      if (true == bitstream_manager.bit_value(bit)) {
+        data_byte |= uint8_t(1 << (ibit % 8));
+      }
+      ibit++;
+      if (0 == ibit % 8) {
+        fp.put(char(data_byte));
+        data_byte = 0;
+      }
+    }
+  }
+  VTR_ASSERT(num_bits == ibit);
+  if (0 != num_bits % 8) {
+    fp.put(char(data_byte));
+  }
+
+  /* String table and string data */
+  string_table.write(fp);
+
+  /* Complete the header */
+  fp.seekp(0);
+  write_binary_arch_bitstream_header(fp, block_order.size(), num_bits, string_table);
+
+  fp.close();
+  if (fp.fail()) {
+    VTR_LOG_ERROR("Fail to write binary architecture bitstream to file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+} /* end namespace openfpga */
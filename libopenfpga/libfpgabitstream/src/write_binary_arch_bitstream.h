@@ -0,0 +1,22 @@
+#ifndef WRITE_BINARY_ARCH_BITSTREAM_H
+#define WRITE_BINARY_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_binary_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                        const std::string& fname);
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,8 +2,6 @@
  * This file includes functions that output bitstream database
  * to files in different formats
  *******************************************************************/
-#include <chrono>
-#include <ctime>
 #include <fstream>
 
 /* Headers from vtrutil library */
@@ -30,14 +28,11 @@ static
 void write_bitstream_xml_file_head(std::fstream& fp) {
   valid_file_stream(fp);
  
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
   fp << "<!--" << std::endl;
   fp << "\t- Architecture independent bitstream" << std::endl;
   fp << "\t- Author: Xifan TANG" << std::endl;
   fp << "\t- Organization: University of Utah" << std::endl;
-  fp << "\t- Date: " << std::ctime(&end_time) ;
+  fp << "\t- Date: " << get_current_date() << std::endl;
   fp << "-->" << std::endl;
   fp << std::endl;
 }
@@ -49,14 +44,21 @@ void write_bitstream_xml_file_head(std::fstream& fp) {
  * 1. For block with bits as children, we will output the XML lines
  * 2. For block without bits/child blocks, we can return 
  * 3. For block with child blocks, we visit each child recursively
+ *
+ * The blocks from the top block to the current block are kept in 
+ * the block_hierarchy during the search, so that the hierarchy of 
+ * a block is not searched again from the bitstream manager
  *******************************************************************/
 static 
 void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
                                            const BitstreamManager& bitstream_manager, 
                                            const ConfigBlockId& block,
-                                           const size_t& hierarchy_level) {
+                                           const size_t& hierarchy_level,
+                                           std::vector<ConfigBlockId>& block_hierarchy) {
   valid_file_stream(fp);
 
+  block_hierarchy.push_back(block);
+
   /* Write the bits of this block */
   write_tab_to_file(fp, hierarchy_level);
   fp << "<bitstream_block";
@@ -66,17 +68,17 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
 
   /* Dive to child blocks if this block has any */
   for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
-    rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block, hierarchy_level + 1);
+    rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block, hierarchy_level + 1, block_hierarchy);
   }
   
-  if (0 == bitstream_manager.block_bits(block).size()) {
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+  if (0 == block_bits.size()) {
     write_tab_to_file(fp, hierarchy_level);
     fp << "</bitstream_block>" <<std::endl;
+    block_hierarchy.pop_back();
     return;
   }
 
-  std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, block); 
-  
   /* Output hierarchy of this parent*/
   write_tab_to_file(fp, hierarchy_level + 1);
   fp << "<hierarchy>" << std::endl;
@@ -142,7 +144,7 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
   }
   fp << ">" << std::endl;
 
-  for (const ConfigBitId& child_bit : bitstream_manager.block_bits(block)) {
+  for (const ConfigBitId& child_bit : block_bits) {
     write_tab_to_file(fp, hierarchy_level + 2);
     fp << "<bit";
     fp << " memory_port=\"" << CONFIGURABLE_MEMORY_DATA_OUT_NAME << "[" << bit_counter << "]" << "\"";
@@ -155,6 +157,8 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
 
   write_tab_to_file(fp, hierarchy_level);
   fp << "</bitstream_block>" <<std::endl;
+
+  block_hierarchy.pop_back();
 }
 
 /********************************************************************
@@ -196,7 +200,8 @@ void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == top_block.size());
 
   /* Write bitstream, block by block, in a recursive way */
-  rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0], 0);
+  std::vector<ConfigBlockId> block_hierarchy;
+  rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0], 0, block_hierarchy);
 
   /* Close file handler */
   fp.close();
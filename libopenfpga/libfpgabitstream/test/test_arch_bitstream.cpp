@@ -2,18 +2,107 @@
  * Unit test functions to validate the correctness of 
  * 1. parser of data structures
  * 2. writer of data structures
+ * 3. writer and reader of the binary format, against the XML format
  *******************************************************************/
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
 /* Headers from vtrutils */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
 /* Headers from fabric key */
 #include "read_xml_arch_bitstream.h"
 #include "write_xml_arch_bitstream.h"
+#include "read_binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+#include "binary_arch_bitstream_reader.h"
+#include "bitstream_manager_utils.h"
+
+/********************************************************************
+ * Compare a block of two bitstream databases, and all its child blocks,
+ * including names, hierarchy, net ids, path ids and bits
+ *******************************************************************/
+static
+void compare_bitstream_blocks(const openfpga::BitstreamManager& ref_bitstream,
+                              const openfpga::ConfigBlockId& ref_block,
+                              const openfpga::BitstreamManager& test_bitstream,
+                              const openfpga::ConfigBlockId& test_block) {
+  VTR_ASSERT(ref_bitstream.block_name(ref_block) == test_bitstream.block_name(test_block));
+  VTR_ASSERT(ref_bitstream.block_path_id(ref_block) == test_bitstream.block_path_id(test_block));
+  VTR_ASSERT(ref_bitstream.block_input_net_ids(ref_block) == test_bitstream.block_input_net_ids(test_block));
+  VTR_ASSERT(ref_bitstream.block_output_net_ids(ref_block) == test_bitstream.block_output_net_ids(test_block));
+
+  std::vector<openfpga::ConfigBitId> ref_bits = ref_bitstream.block_bits(ref_block);
+  std::vector<openfpga::ConfigBitId> test_bits = test_bitstream.block_bits(test_block);
+  VTR_ASSERT(ref_bits.size() == test_bits.size());
+  for (size_t ibit = 0; ibit < ref_bits.size(); ++ibit) {
+    VTR_ASSERT(ref_bitstream.bit_value(ref_bits[ibit]) == test_bitstream.bit_value(test_bits[ibit]));
+  }
+
+  const std::vector<openfpga::ConfigBlockId>& ref_children = ref_bitstream.block_children(ref_block);
+  const std::vector<openfpga::ConfigBlockId>& test_children = test_bitstream.block_children(test_block);
+  VTR_ASSERT(ref_children.size() == test_children.size());
+  for (size_t ichild = 0; ichild < ref_children.size(); ++ichild) {
+    VTR_ASSERT(ref_block == ref_bitstream.block_parent(ref_children[ichild]));
+    VTR_ASSERT(test_block == test_bitstream.block_parent(test_children[ichild]));
+    compare_bitstream_blocks(ref_bitstream, ref_children[ichild],
+                             test_bitstream, test_children[ichild]);
+  }
+}
+
+/********************************************************************
+ * Compare two bitstream databases from their top blocks
+ *******************************************************************/
+static
+void compare_bitstreams(const openfpga::BitstreamManager& ref_bitstream,
+                        const openfpga::BitstreamManager& test_bitstream) {
+  VTR_ASSERT(ref_bitstream.num_blocks() == test_bitstream.num_blocks());
+  VTR_ASSERT(ref_bitstream.num_bits() == test_bitstream.num_bits());
+
+  std::vector<openfpga::ConfigBlockId> ref_top_blocks = openfpga::find_bitstream_manager_top_blocks(ref_bitstream);
+  std::vector<openfpga::ConfigBlockId> test_top_blocks = openfpga::find_bitstream_manager_top_blocks(test_bitstream);
+  VTR_ASSERT(1 == ref_top_blocks.size());
+  VTR_ASSERT(1 == test_top_blocks.size());
+  compare_bitstream_blocks(ref_bitstream, ref_top_blocks[0],
+                           test_bitstream, test_top_blocks[0]);
+}
+
+/********************************************************************
+ * Truncate a binary architecture bitstream at a given size,
+ * and ensure that the reader rejects it
+ *******************************************************************/
+static
+void test_truncated_binary_arch_bitstream(const std::vector<char>& file_content,
+                                          const size_t& truncated_size,
+                                          const std::string& fname) {
+  VTR_ASSERT(truncated_size < file_content.size());
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  VTR_ASSERT(fp.is_open());
+  fp.write(file_content.data(), truncated_size);
+  fp.close();
+
+  bool rejected = false;
+  try {
+    openfpga::BinaryArchBitstreamReader reader(fname);
+  } catch (const ArchFpgaError&) {
+    rejected = true;
+  }
+  VTR_ASSERT(true == rejected);
+  VTR_LOG("Reject binary architecture bitstream truncated to %lu bytes.\n",
+          truncated_size);
+}
 
 int main(int argc, const char** argv) {
-  /* Ensure we have only one or two argument */
-  VTR_ASSERT((2 == argc) || (3 == argc));
+  /* Ensure we have one, two or three arguments */
+  VTR_ASSERT((2 == argc) || (3 == argc) || (4 == argc));
 
   /* Parse the bitstream from an XML file */
   openfpga::BitstreamManager test_bitstream = openfpga::read_xml_architecture_bitstream(argv[1]);
@@ -28,6 +117,48 @@ int main(int argc, const char** argv) {
     VTR_LOG("Echo the bitstream to an XML file: %s.\n",
             argv[2]);
   }
-}
 
+  /* Output the bitstream to a binary file, and compare what is read back
+   * with the XML round trip
+   * This is optional only used when there is a third argument
+   */
+  if (4 <= argc) {
+    int status = openfpga::write_binary_architecture_bitstream(test_bitstream, argv[3]);
+    VTR_ASSERT(0 == status);
+    VTR_LOG("Echo the bitstream to a binary file: %s.\n",
+            argv[3]);
+
+    openfpga::BitstreamManager xml_bitstream = openfpga::read_xml_architecture_bitstream(argv[2]);
+    openfpga::BitstreamManager binary_bitstream = openfpga::read_binary_architecture_bitstream(argv[3]);
+    compare_bitstreams(xml_bitstream, binary_bitstream);
+    compare_bitstreams(test_bitstream, binary_bitstream);
+    VTR_LOG("Read back the bitstream from the binary file, which is the same as the XML file.\n");
+
+    /* Truncate the file in each section: header, block table,
+     * data bits and string table
+     */
+    std::ifstream ifp(argv[3], std::ifstream::binary);
+    std::vector<char> file_content((std::istreambuf_iterator<char>(ifp)),
+                                   std::istreambuf_iterator<char>());
+    ifp.close();
+
+    std::string truncated_fname = std::string(argv[3]) + std::string(".truncated");
+    size_t data_offset = openfpga::BINARY_ARCH_BITSTREAM_HEADER_SIZE
+                       + test_bitstream.num_blocks() * openfpga::BINARY_ARCH_BITSTREAM_BLOCK_SIZE;
+    size_t string_table_offset = data_offset + (test_bitstream.num_bits() + 7) / 8;
+    std::vector<size_t> truncated_sizes = {0,
+                                           openfpga::BINARY_ARCH_BITSTREAM_HEADER_SIZE - 1,
+                                           data_offset - openfpga::BINARY_ARCH_BITSTREAM_BLOCK_SIZE / 2,
+                                           string_table_offset,
+                                           file_content.size() - 1};
+    if (0 < test_bitstream.num_bits()) {
+      truncated_sizes.push_back(string_table_offset - 1);
+    }
+    for (const size_t& truncated_size : truncated_sizes) {
+      test_truncated_binary_arch_bitstream(file_content, truncated_size, truncated_fname);
+    }
+  }
+
+  return 0;
+}
 
@@ -0,0 +1,86 @@
+/********************************************************************
+ * Unit test functions to validate the correctness of
+ * 1. writer of binary fabric bitstream
+ * 2. reader of binary fabric bitstream
+ *******************************************************************/
+#include <cstdlib>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from fabric bitstream */
+#include "binary_fabric_bitstream_writer.h"
+#include "binary_fabric_bitstream_reader.h"
+
+/********************************************************************
+ * Convert an integer to an address, where the first character is the LSB
+ *******************************************************************/
+static
+std::vector<char> itoa_test_address(const size_t& value, const size_t& width) {
+  std::vector<char> address(width, '0');
+  for (size_t ibit = 0; ibit < width; ++ibit) {
+    if (value & (size_t(1) << ibit)) {
+      address[ibit] = '1';
+    }
+  }
+  return address;
+}
+
+int main(int argc, const char** argv) {
+  /* Ensure we have only one argument */
+  VTR_ASSERT(2 == argc);
+
+  /* Create a memory-bank-like bitstream with non-monotonic addresses,
+   * which spans a few address blocks
+   */
+  const size_t bl_width = 12;
+  const size_t wl_width = 7;
+  const size_t num_bits = 3 * openfpga::BINARY_FABRIC_BITSTREAM_ADDRESS_BLOCK_SIZE + 5;
+
+  openfpga::BinaryFabricBitstreamWriter writer(CONFIG_MEM_MEMORY_BANK, bl_width, wl_width);
+  std::vector<size_t> bl_addresses;
+  std::vector<size_t> wl_addresses;
+  std::vector<bool> bit_values;
+  for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+    if (0 == ibit % 1000) {
+      writer.add_region();
+    }
+    bl_addresses.push_back((ibit * 37) % (1 << bl_width));
+    wl_addresses.push_back((num_bits - ibit) % (1 << wl_width));
+    bit_values.push_back(0 == ibit % 3);
+    writer.add_bit(bit_values.back(),
+                   itoa_test_address(bl_addresses.back(), bl_width),
+                   itoa_test_address(wl_addresses.back(), wl_width));
+  }
+  VTR_ASSERT(0 == writer.write_to_file(argv[1]));
+  VTR_LOG("Write binary fabric bitstream to file: %s.\n",
+          argv[1]);
+
+  /* Read back and compare */
+  openfpga::BinaryFabricBitstreamReader reader(argv[1]);
+  VTR_ASSERT(CONFIG_MEM_MEMORY_BANK == reader.config_protocol_type());
+  VTR_ASSERT(num_bits == reader.num_bits());
+  VTR_ASSERT(4 == reader.num_regions());
+  VTR_ASSERT(3000 == reader.region_first_bit(3));
+  VTR_ASSERT(num_bits - 3000 == reader.region_num_bits(3));
+
+  /* Sequential access */
+  for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+    VTR_ASSERT(bit_values[ibit] == reader.bit_value(ibit));
+    VTR_ASSERT(itoa_test_address(bl_addresses[ibit], bl_width) == reader.bit_bl_address(ibit));
+    VTR_ASSERT(itoa_test_address(wl_addresses[ibit], wl_width) == reader.bit_wl_address(ibit));
+  }
+
+  /* Random access */
+  for (size_t itry = 0; itry < 1000; ++itry) {
+    size_t ibit = std::rand() % num_bits;
+    VTR_ASSERT(itoa_test_address(bl_addresses[ibit], bl_width) == reader.bit_bl_address(ibit));
+    VTR_ASSERT(itoa_test_address(wl_addresses[ibit], wl_width) == reader.bit_wl_address(ibit));
+  }
+
+  VTR_LOG("Read back binary fabric bitstream from file: %s.\n",
+          argv[1]);
+
+  return 0;
+}
@@ -0,0 +1,186 @@
+/*********************************************************************
+ * Member functions for class CommandProfiler
+ ********************************************************************/
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include <malloc.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "command_profiler.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * Get the resource usage of the current process
+ ********************************************************************/
+t_resource_usage query_resource_usage() {
+  t_resource_usage usage;
+
+  usage.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  struct rusage self_usage;
+  getrusage(RUSAGE_SELF, &self_usage);
+  usage.cpu_time = self_usage.ru_utime.tv_sec + self_usage.ru_utime.tv_usec / 1e6
+                 + self_usage.ru_stime.tv_sec + self_usage.ru_stime.tv_usec / 1e6;
+  /* ru_maxrss is in KB on Linux */
+  usage.peak_rss = self_usage.ru_maxrss;
+
+  /* Current resident set size is the second field of /proc/self/statm in pages */
+  usage.rss = 0;
+  std::ifstream statm("/proc/self/statm");
+  size_t num_pages = 0;
+  size_t num_rss_pages = 0;
+  if (statm >> num_pages >> num_rss_pages) {
+    usage.rss = num_rss_pages * (sysconf(_SC_PAGESIZE) / 1024);
+  }
+
+  usage.heap_size = 0;
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33)))
+  struct mallinfo2 heap_info = mallinfo2();
+  usage.heap_size = heap_info.uordblks + heap_info.hblkhd;
+#endif
+
+  return usage;
+}
+
+/*********************************************************************
+ * Escape a string to be a JSON string
+ ********************************************************************/
+static 
+std::string escape_json_string(const std::string& str) {
+  std::string escaped;
+  for (const char& c : str) {
+    if (('"' == c) || ('\\' == c)) {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if ('\t' == c) {
+      escaped += std::string("\\t");
+    } else if ('\n' == c) {
+      escaped += std::string("\\n");
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+/*********************************************************************
+ * Public constructors
+ ********************************************************************/
+CommandProfiler::CommandProfiler() {
+  start_usage_ = query_resource_usage();
+}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+size_t CommandProfiler::num_profiles() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cmd_names_.size();
+}
+
+std::string CommandProfiler::json_file() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return json_file_;
+}
+
+void CommandProfiler::print_report() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  VTR_LOG("\nProfile of %lu executed commands:\n", cmd_names_.size());
+  VTR_LOG("%-32s %12s %12s %14s %14s %16s %8s\n",
+          "Command", "Wall (s)", "CPU (s)", "RSS delta(KB)", "Peak RSS(KB)", "Heap delta(B)", "Status");
+  for (size_t icmd = 0; icmd < cmd_names_.size(); ++icmd) {
+    const t_resource_usage& begin = begin_usages_[icmd];
+    const t_resource_usage& end = end_usages_[icmd];
+    VTR_LOG("%-32s %12.3f %12.3f %14ld %14lu %16ld %8d\n",
+            cmd_names_[icmd].c_str(),
+            end.wall_time - begin.wall_time,
+            end.cpu_time - begin.cpu_time,
+            long(end.rss) - long(begin.rss),
+            end.peak_rss,
+            long(end.heap_size) - long(begin.heap_size),
+            cmd_status_[icmd]);
+  }
+  VTR_LOG("\n");
+}
+
+int CommandProfiler::write_json_file(const std::string& fname) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s' to write command profiles!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  t_resource_usage now = query_resource_usage();
+
+  fp << "{" << std::endl;
+  fp << "  \"total_wall_time\": " << now.wall_time - start_usage_.wall_time << "," << std::endl;
+  fp << "  \"total_cpu_time\": " << now.cpu_time - start_usage_.cpu_time << "," << std::endl;
+  fp << "  \"peak_rss\": " << now.peak_rss << "," << std::endl;
+  fp << "  \"commands\": [";
+  for (size_t icmd = 0; icmd < cmd_names_.size(); ++icmd) {
+    const t_resource_usage& begin = begin_usages_[icmd];
+    const t_resource_usage& end = end_usages_[icmd];
+    if (0 < icmd) {
+      fp << ",";
+    }
+    fp << std::endl;
+    fp << "    {" << std::endl;
+    fp << "      \"name\": \"" << escape_json_string(cmd_names_[icmd]) << "\"," << std::endl;
+    fp << "      \"command_line\": \"" << escape_json_string(cmd_lines_[icmd]) << "\"," << std::endl;
+    fp << "      \"status\": " << cmd_status_[icmd] << "," << std::endl;
+    fp << "      \"start_time\": " << begin.wall_time - start_usage_.wall_time << "," << std::endl;
+    fp << "      \"wall_time\": " << end.wall_time - begin.wall_time << "," << std::endl;
+    fp << "      \"cpu_time\": " << end.cpu_time - begin.cpu_time << "," << std::endl;
+    fp << "      \"rss_begin\": " << begin.rss << "," << std::endl;
+    fp << "      \"rss_end\": " << end.rss << "," << std::endl;
+    fp << "      \"peak_rss\": " << end.peak_rss << "," << std::endl;
+    fp << "      \"heap_begin\": " << begin.heap_size << "," << std::endl;
+    fp << "      \"heap_end\": " << end.heap_size << std::endl;
+    fp << "    }";
+  }
+  fp << std::endl << "  ]" << std::endl;
+  fp << "}" << std::endl;
+
+  fp.close();
+
+  VTR_LOG("Write profiles of %lu commands to JSON file '%s'\n",
+          cmd_names_.size(), fname.c_str());
+
+  return 0;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void CommandProfiler::add_profile(const std::string& cmd_name,
+                                  const std::string& cmd_line,
+                                  const int& status,
+                                  const t_resource_usage& begin,
+                                  const t_resource_usage& end) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cmd_names_.push_back(cmd_name);
+  cmd_lines_.push_back(cmd_line);
+  cmd_status_.push_back(status);
+  begin_usages_.push_back(begin);
+  end_usages_.push_back(end);
+}
+
+void CommandProfiler::set_json_file(const std::string& fname) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  json_file_ = fname;
+}
+
+} /* End namespace openfpga */
@@ -0,0 +1,84 @@
+#ifndef COMMAND_PROFILER_H
+#define COMMAND_PROFILER_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * Resource usage of the process at a moment
+ * - wall_time: seconds since an arbitrary epoch (steady clock)
+ * - cpu_time: user and system CPU time of the process in seconds
+ * - rss: resident set size in KB
+ * - peak_rss: peak resident set size in KB
+ * - heap_size: bytes of heap memory in use
+ * Memory statistics are zero when they are not available on the platform
+ ********************************************************************/
+struct t_resource_usage {
+  double wall_time;
+  double cpu_time;
+  size_t rss;
+  size_t peak_rss;
+  size_t heap_size;
+};
+
+t_resource_usage query_resource_usage();
+
+/*********************************************************************
+ * Data structure to collect the profiles of the commands executed in a shell
+ *
+ * Each profile is built from the resource usage of the process before
+ * and after executing a command. 
+ * Note that the CPU time and memory are measured on the whole process,
+ * so they include all the threads of the command, as well as 
+ * other commands running concurrently (e.g., in the batch mode of the shell)
+ *
+ * An example of how to use
+ * -----------------------
+ * t_resource_usage begin = query_resource_usage();
+ * // execute a command
+ * profiler.add_profile("read_arch", "read_arch -f arch.xml", status, begin, query_resource_usage());
+ * profiler.print_report();
+ * profiler.write_json_file("profile.json");
+ *
+ * Profiles can be added by multiple threads
+ ********************************************************************/
+class CommandProfiler {
+  public: /* Public constructor */
+    CommandProfiler();
+  public: /* Public accessors */
+    size_t num_profiles() const;
+    std::string json_file() const;
+    /* Print a table of all the profiles to the log */
+    void print_report() const;
+    /* Output all the profiles to a JSON file. Return 0 if succeed, otherwise 1 */
+    int write_json_file(const std::string& fname) const;
+  public: /* Public mutators */
+    void add_profile(const std::string& cmd_name,
+                     const std::string& cmd_line,
+                     const int& status,
+                     const t_resource_usage& begin,
+                     const t_resource_usage& end);
+    /* Set the file where the profiles are written to when the shell exits */
+    void set_json_file(const std::string& fname);
+  private: /* Internal data */
+    std::vector<std::string> cmd_names_;
+    std::vector<std::string> cmd_lines_;
+    std::vector<int> cmd_status_;
+    std::vector<t_resource_usage> begin_usages_;
+    std::vector<t_resource_usage> end_usages_;
+
+    std::string json_file_;
+
+    /* Resource usage when the profiler is created */
+    t_resource_usage start_usage_;
+
+    mutable std::mutex mutex_;
+};
+
+} /* End namespace openfpga */
+
+#endif
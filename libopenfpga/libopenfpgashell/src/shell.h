@@ -5,6 +5,7 @@
 #include <map>
 #include <vector>
 #include <functional>
+#include <memory>
 #include <ctime>
 
 #include "vtr_vector.h"
@@ -12,6 +13,7 @@
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
+#include "command_profiler.h"
 #include "shell_fwd.h"
 
 /* Begin namespace openfpga */
@@ -136,16 +138,23 @@ class Shell {
     void set_command_dependency(const ShellCommandId& cmd_id,
                                 const std::vector<ShellCommandId>& cmd_dependency);
     ShellCommandClassId add_command_class(const char* name);
+    /* Set the JSON file where the profile of each command is written to when the shell exits */
+    void set_profile_file(const std::string& fname);
   public: /* Public validators */
     bool valid_command_id(const ShellCommandId& cmd_id) const;
     bool valid_command_class_id(const ShellCommandClassId& cmd_class_id) const;
   public: /* Public executors */
     /* Start the interactive mode, where users will type-in command by command */
     void run_interactive_mode(T& context, const bool& quiet_mode = false);
-    /* Start the script mode, where users provide a file which includes all the commands to run */
-    void run_script_mode(const char* script_file_name, T& context);
+    /* Start the script mode, where users provide a file which includes all the commands to run 
+     * In batch mode, independent commands which do not modify the data exchange <T> 
+     * are executed concurrently (see run_batch_commands() for details)
+     */
+    void run_script_mode(const char* script_file_name, T& context, const bool& batch_mode = false);
     /* Print all the commands by their classes. This is actually the help desk */
     void print_commands() const;
+    /* Print the profile of each command which has been executed */
+    void print_profile() const;
     /* Quit the shell */
     void exit() const;
   private: /* Private executors */
@@ -153,6 +162,32 @@ class Shell {
      * The common_context is the data structure to exchange data between commands
      */
     int execute_command(const char* cmd_line, T& common_context);
+
+    /* Execute a valid command with the tokens of its command line, without profiling */
+    int execute_command(const ShellCommandId& cmd_id,
+                        const std::vector<std::string>& tokens,
+                        T& common_context);
+
+    /* Read all the command lines from a script file, where comments are removed 
+     * and continued lines are merged. Return false if the file cannot be opened
+     */
+    bool read_script_command_lines(const char* script_file_name, std::vector<std::string>& cmd_lines) const;
+
+    /* Check if all the commands that a command depends on have been executed successfully */
+    bool check_command_dependency(const ShellCommandId& cmd_id) const;
+
+    /* Check if a command only requires read-only access to the data exchange <T> */
+    bool is_const_command(const ShellCommandId& cmd_id) const;
+
+    /* Execute a const command with a given parsing result, without updating its execution status
+     * This is safe to be called by multiple threads
+     */
+    int execute_const_command(const ShellCommandId& cmd_id,
+                              const CommandContext& cmd_context,
+                              const T& common_context) const;
+
+    /* Execute a list of command lines in batch mode */
+    void run_batch_commands(const std::vector<std::string>& cmd_lines, T& common_context);
   private: /* Internal data */ 
     /* Name of the shell, this will appear in the interactive mode */
     std::string name_;
@@ -215,6 +250,12 @@ class Shell {
 
     /* Timer */
     std::clock_t time_start_;
+
+    /* Profiles of the executed commands
+     * This is shared with the copies of the shell (e.g., captured by built-in commands),
+     * so that they can report the profiles of all the commands
+     */
+    std::shared_ptr<CommandProfiler> profiler_;
 };
 
 } /* End namespace openfpga */
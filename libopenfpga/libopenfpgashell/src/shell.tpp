@@ -3,6 +3,8 @@
  ********************************************************************/
 #include <fstream>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -29,6 +31,7 @@ template<class T>
 Shell<T>::Shell(const char* name) {
   name_ = std::string(name);
   time_start_ = 0;
+  profiler_ = std::make_shared<CommandProfiler>();
 }
 
 /************************************************************************
@@ -272,7 +275,7 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
 }
 
 template <class T>
-void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
+void Shell<T>::run_script_mode(const char* script_file_name, T& context, const bool& batch_mode) {
 
   time_start_ = std::clock();
 
@@ -283,78 +286,20 @@ void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
     VTR_LOG("%s\n", title().c_str());
   } 
 
-  std::string line;
-
-  /* Create an input file stream */
-  std::ifstream fp(script_file_name);
-
-  if (!fp.is_open()) {
+  std::vector<std::string> cmd_lines;
+  if (false == read_script_command_lines(script_file_name, cmd_lines)) {
     /* Fail to open the file, ask user to check */
     VTR_LOG("Fail to open the script file: %s! Please check its location\n",
             script_file_name);
     return; 
   }
 
-  /* Consider that each line may not end due to the continued line charactor 
-   * Use cmd_line to conjunct multiple lines 
-   */
-  std::string cmd_line;
-
-  /* Read line by line */
-  while (getline(fp, line)) {
-    /* Skip empty line */
-    if (true == line.empty()) {
-      continue;
-    }
-
-    /* If the line that starts with '#', it is commented, we can skip */ 
-    if ('#' == line.front()) {
-      continue;
-    }
-    /* Try to split the line with '#', the string before '#' is the read command we want */
-    std::string cmd_part = line;
-    std::size_t cmd_end_pos = line.find_first_of('#');
-    /* If the full line has '#', we need the part before it */
-    if (cmd_end_pos != std::string::npos) {
-      cmd_part = line.substr(0, cmd_end_pos);
-    }
-
-    /* Remove the space at the end of the line
-     * So that we can check easily if there is a continued line in the end  
-     */
-    StringToken cmd_part_tokenizer(cmd_part);
-    cmd_part_tokenizer.rtrim(std::string(" "));
-    cmd_part = cmd_part_tokenizer.data();
-
-    /* If the line ends with '\', this is a continued line, parse the next until it ends */
-    if ('\\' == cmd_part.back()) {
-      /* Pop up the last charactor and conjunct to cmd_line */
-      cmd_part.pop_back();
- 
-      if (!cmd_part.empty()) {
-        cmd_line += cmd_part; 
-      }
-      /* Not finished yet. Parse the next line */
-      continue;
-    } else {
-      /* End of this line, if cmd_line is empty, 
-       * there is no previous lines, cache the part we have
-       * and then execute the command 
-       */
-      cmd_line += cmd_part;
-    }
-
-    /* Remove the space at the beginning of the line */
-    StringToken cmd_line_tokenizer(cmd_line);
-    cmd_line_tokenizer.ltrim(std::string(" "));
-    cmd_line = cmd_line_tokenizer.data();
-
-    /* Process the command only when the full command line in ended */
-    if (!cmd_line.empty()) {
+  if (true == batch_mode) {
+    run_batch_commands(cmd_lines, context);
+  } else {
+    for (const std::string& cmd_line : cmd_lines) {
       VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
       int status = execute_command(cmd_line.c_str(), context);
-      /* Empty the line ready to start a new line */
-      cmd_line.clear();
 
       /* Check the execution status of the command, if fatal error happened, we should abort immediately */
       if (CMD_EXEC_FATAL_ERROR == status) {
@@ -363,7 +308,6 @@ void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
       }
     }
   }
-  fp.close();
 
   /* Return to interactive mode, stay tuned */
   run_interactive_mode(context, true); 
@@ -391,6 +335,16 @@ void Shell<T>::print_commands() const {
   VTR_LOG("\n");
 }
 
+template <class T>
+void Shell<T>::print_profile() const {
+  profiler_->print_report();
+}
+
+template <class T>
+void Shell<T>::set_profile_file(const std::string& fname) {
+  profiler_->set_json_file(fname);
+}
+
 template <class T>
 void Shell<T>::exit() const {
   /* Check all the command status, if we see fatal errors or minor errors, we drop an error code */
@@ -425,6 +379,11 @@ void Shell<T>::exit() const {
   VTR_LOG("\nFinish execution with %d errors\n",
             num_err);
 
+  /* Dump the profiles of executed commands if requested */
+  if (false == profiler_->json_file().empty()) {
+    profiler_->write_json_file(profiler_->json_file());
+  }
+
   VTR_LOG("\nThe entire OpenFPGA flow took %g seconds\n",
           (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC);
 
@@ -452,16 +411,22 @@ int Shell<T>::execute_command(const char* cmd_line,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* Profile the execution of the command */
+  t_resource_usage usage_begin = query_resource_usage();
+  int status = execute_command(cmd_id, tokens, common_context);
+  profiler_->add_profile(commands_[cmd_id].name(), std::string(cmd_line),
+                         status, usage_begin, query_resource_usage());
+
+  return status;
+}
+
+template <class T>
+int Shell<T>::execute_command(const ShellCommandId& cmd_id,
+                              const std::vector<std::string>& tokens,
+                              T& common_context) {
   /* Check the dependency graph to see if all the prequistics have been met */
-  for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
-    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
-      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
-      VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
-              commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
-      /* Echo the command help desk */
-      print_command_options(commands_[cmd_id]);
-      return CMD_EXEC_FATAL_ERROR;
-    } 
+  if (false == check_command_dependency(cmd_id)) {
+    return CMD_EXEC_FATAL_ERROR;
   }
 
   /* Find the command! Parse the options 
@@ -537,6 +502,261 @@ int Shell<T>::execute_command(const char* cmd_line,
   return command_status_[cmd_id];
 }
 
+template <class T>
+bool Shell<T>::read_script_command_lines(const char* script_file_name,
+                                         std::vector<std::string>& cmd_lines) const {
+  std::string line;
+
+  /* Create an input file stream */
+  std::ifstream fp(script_file_name);
+
+  if (!fp.is_open()) {
+    return false; 
+  }
+
+  /* Consider that each line may not end due to the continued line charactor 
+   * Use cmd_line to conjunct multiple lines 
+   */
+  std::string cmd_line;
+
+  /* Read line by line */
+  while (getline(fp, line)) {
+    /* Skip empty line */
+    if (true == line.empty()) {
+      continue;
+    }
+
+    /* If the line that starts with '#', it is commented, we can skip */ 
+    if ('#' == line.front()) {
+      continue;
+    }
+    /* Try to split the line with '#', the string before '#' is the read command we want */
+    std::string cmd_part = line;
+    std::size_t cmd_end_pos = line.find_first_of('#');
+    /* If the full line has '#', we need the part before it */
+    if (cmd_end_pos != std::string::npos) {
+      cmd_part = line.substr(0, cmd_end_pos);
+    }
+
+    /* Remove the space at the end of the line
+     * So that we can check easily if there is a continued line in the end  
+     */
+    StringToken cmd_part_tokenizer(cmd_part);
+    cmd_part_tokenizer.rtrim(std::string(" "));
+    cmd_part = cmd_part_tokenizer.data();
+
+    /* If the line ends with '\', this is a continued line, parse the next until it ends */
+    if ('\\' == cmd_part.back()) {
+      /* Pop up the last charactor and conjunct to cmd_line */
+      cmd_part.pop_back();
+ 
+      if (!cmd_part.empty()) {
+        cmd_line += cmd_part; 
+      }
+      /* Not finished yet. Parse the next line */
+      continue;
+    } else {
+      /* End of this line, if cmd_line is empty, 
+       * there is no previous lines, cache the part we have
+       * and then execute the command 
+       */
+      cmd_line += cmd_part;
+    }
+
+    /* Remove the space at the beginning of the line */
+    StringToken cmd_line_tokenizer(cmd_line);
+    cmd_line_tokenizer.ltrim(std::string(" "));
+    cmd_line = cmd_line_tokenizer.data();
+
+    /* Keep the command only when the full command line in ended */
+    if (!cmd_line.empty()) {
+      cmd_lines.push_back(cmd_line);
+      /* Empty the line ready to start a new line */
+      cmd_line.clear();
+    }
+  }
+  fp.close();
+
+  return true;
+}
+
+template <class T>
+bool Shell<T>::check_command_dependency(const ShellCommandId& cmd_id) const {
+  for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
+    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
+      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
+      VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
+              commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
+      /* Echo the command help desk */
+      print_command_options(commands_[cmd_id]);
+      return false;
+    } 
+  }
+  return true;
+}
+
+template <class T>
+bool Shell<T>::is_const_command(const ShellCommandId& cmd_id) const {
+  return (CONST_STANDARD == command_execute_function_types_[cmd_id])
+      || (CONST_SHORT == command_execute_function_types_[cmd_id]);
+}
+
+template <class T>
+int Shell<T>::execute_const_command(const ShellCommandId& cmd_id,
+                                    const CommandContext& cmd_context,
+                                    const T& common_context) const {
+  if (CONST_STANDARD == command_execute_function_types_[cmd_id]) {
+    return command_const_execute_functions_[cmd_id](common_context, commands_[cmd_id], cmd_context);
+  }
+  VTR_ASSERT(CONST_SHORT == command_execute_function_types_[cmd_id]);
+  return command_short_const_execute_functions_[cmd_id](common_context);
+}
+
+/************************************************************************
+ * Execute a list of command lines in batch mode
+ * The commands are scheduled in the order of the command lines:
+ * - A command which may modify the data exchange <T> (including built-in
+ *   and macro commands) is executed alone, after all the commands before it 
+ *   are finished. It is a barrier for the commands after it.
+ * - Consecutive const commands, which only read the data exchange <T>,
+ *   are grouped and executed concurrently, one thread per command.
+ *   A const command starts a new group if it depends on a command 
+ *   in the current group, so that the dependency is always met.
+ * Each command line owns its parsing results, so that the same command 
+ * can be executed more than once in a group.
+ *
+ * Commands whose dependencies are not met are skipped with a fatal error. 
+ * The execution is aborted after a group in which any fatal error occurs.
+ * The runtime of each command is reported in the end, or before a built-in
+ * command (e.g., exit) is executed, as it may quit the shell.
+ *
+ * Note: the log messages of concurrent commands may be interleaved
+ ***********************************************************************/
+template <class T>
+void Shell<T>::run_batch_commands(const std::vector<std::string>& cmd_lines,
+                                  T& common_context) {
+  /* Wall-clock runtime of each command line which has been executed */
+  std::vector<std::pair<std::string, double>> cmd_runtimes;
+  auto print_cmd_runtimes = [&]() {
+    VTR_LOG("\nRuntime of commands in batch mode:\n");
+    for (const auto& cmd_runtime : cmd_runtimes) {
+      VTR_LOG("\t%g seconds\t%s\n", cmd_runtime.second, cmd_runtime.first.c_str());
+    }
+    VTR_LOG("\n");
+  };
+
+  bool abort = false;
+  size_t iline = 0;
+  while ((false == abort) && (iline < cmd_lines.size())) {
+    /* Collect a group of const commands starting from the current line */
+    std::vector<size_t> group_lines;
+    std::vector<ShellCommandId> group_cmds;
+    std::vector<CommandContext> group_contexts;
+    for (; iline < cmd_lines.size(); ++iline) {
+      StringToken tokenizer(cmd_lines[iline]);
+      std::vector<std::string> tokens = tokenizer.split(" ");
+      ShellCommandId cmd_id = command(tokens[0]);
+      if ( (ShellCommandId::INVALID() == cmd_id)
+        || (false == is_const_command(cmd_id)) ) {
+        break;
+      }
+      /* A command depending on another command in the group must wait */
+      bool depend_on_group = false;
+      for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
+        if (group_cmds.end() != std::find(group_cmds.begin(), group_cmds.end(), dep_cmd)) {
+          depend_on_group = true;
+          break;
+        }
+      }
+      if (true == depend_on_group) {
+        break;
+      }
+
+      VTR_LOG("\nCommand line to execute: %s\n", cmd_lines[iline].c_str());
+      group_contexts.emplace_back(commands_[cmd_id]);
+      if (false == parse_command(tokens, commands_[cmd_id], group_contexts.back())) {
+        /* Echo the command */
+        print_command_options(commands_[cmd_id]);
+        command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+        group_contexts.pop_back();
+        abort = true;
+        break;
+      }
+      print_command_context(commands_[cmd_id], group_contexts.back());
+      group_lines.push_back(iline);
+      group_cmds.push_back(cmd_id);
+    }
+
+    /* Execute the group of const commands concurrently */
+    if (false == group_cmds.empty()) {
+      VTR_LOG("\nExecute %lu command(s) concurrently\n", group_cmds.size());
+
+      std::vector<int> group_status(group_cmds.size(), CMD_EXEC_FATAL_ERROR);
+      std::vector<double> group_runtimes(group_cmds.size(), 0.);
+      std::vector<std::thread> workers;
+      for (size_t icmd = 0; icmd < group_cmds.size(); ++icmd) {
+        /* Skip the commands whose dependencies are not met */
+        if (false == check_command_dependency(group_cmds[icmd])) {
+          continue;
+        }
+        workers.emplace_back([&, icmd]() {
+          t_resource_usage usage_begin = query_resource_usage();
+          group_status[icmd] = execute_const_command(group_cmds[icmd], group_contexts[icmd],
+                                                     const_cast<const T&>(common_context));
+          t_resource_usage usage_end = query_resource_usage();
+          group_runtimes[icmd] = usage_end.wall_time - usage_begin.wall_time;
+          profiler_->add_profile(commands_[group_cmds[icmd]].name(), cmd_lines[group_lines[icmd]],
+                                 group_status[icmd], usage_begin, usage_end);
+        });
+      }
+      for (std::thread& worker : workers) {
+        worker.join();
+      }
+
+      /* Update the status in the order of command lines */
+      for (size_t icmd = 0; icmd < group_cmds.size(); ++icmd) {
+        command_status_[group_cmds[icmd]] = group_status[icmd];
+        cmd_runtimes.push_back(std::make_pair(cmd_lines[group_lines[icmd]], group_runtimes[icmd]));
+        if (CMD_EXEC_NONE == group_status[icmd]) {
+          VTR_LOG_ERROR("It is illegal to return never-executed status for an executed command!\n");
+          command_status_[group_cmds[icmd]] = CMD_EXEC_FATAL_ERROR;
+        }
+        if (CMD_EXEC_FATAL_ERROR == command_status_[group_cmds[icmd]]) {
+          abort = true;
+        }
+      }
+      continue;
+    }
+
+    if ((true == abort) || (iline == cmd_lines.size())) {
+      break;
+    }
+
+    /* Execute a command which is not const alone */
+    ShellCommandId cmd_id = command(StringToken(cmd_lines[iline]).split(" ")[0]);
+    if ( (true == valid_command_id(cmd_id))
+      && (BUILTIN == command_execute_function_types_[cmd_id]) ) {
+      print_cmd_runtimes();
+    }
+    VTR_LOG("\nCommand line to execute: %s\n", cmd_lines[iline].c_str());
+    auto cmd_start = std::chrono::steady_clock::now();
+    int status = execute_command(cmd_lines[iline].c_str(), common_context);
+    cmd_runtimes.push_back(std::make_pair(cmd_lines[iline], std::chrono::duration<double>(std::chrono::steady_clock::now() - cmd_start).count()));
+    ++iline;
+
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      abort = true;
+    }
+  }
+
+  if (true == abort) {
+    VTR_LOG("Fatal error occurred!\nAbort and enter interactive mode\n");
+  }
+
+  /* Report the runtime of each command */
+  print_cmd_runtimes();
+}
+
 /************************************************************************
  * Public invalidators/validators 
  ***********************************************************************/
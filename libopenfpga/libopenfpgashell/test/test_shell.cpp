@@ -31,6 +31,13 @@ int shell_execute_print(ShellContext& context) {
   return CMD_EXEC_SUCCESS; 
 }
 
+static
+int shell_execute_print_const(const ShellContext& context) {
+  VTR_LOG("a=%d\n", context.a);
+
+  return CMD_EXEC_SUCCESS; 
+}
+
 static
 int shell_execute_print_macro(int argc, char** argv) {
   VTR_LOG("Number of arguments: %d\n", argc);
@@ -56,6 +63,12 @@ int main(int argc, char** argv) {
   start_cmd.set_option_require_value(opt_script_mode, OPT_STRING);
   start_cmd.set_option_short_name(opt_script_mode, "f");
 
+  CommandOptionId opt_batch_exec = start_cmd.add_option("batch_execution", false, "Execute independent read-only commands of a script concurrently");
+  start_cmd.set_option_short_name(opt_batch_exec, "batch");
+
+  CommandOptionId opt_profile_file = start_cmd.add_option("profile_file", false, "Write the runtime and memory usage of each executed command to a JSON file when exiting");
+  start_cmd.set_option_require_value(opt_profile_file, OPT_STRING);
+
   CommandOptionId opt_help = start_cmd.add_option("help", false, "Help desk"); 
   start_cmd.set_option_short_name(opt_help, "h");
 
@@ -114,6 +127,16 @@ int main(int argc, char** argv) {
   shell.set_command_execute_function(shell_cmd_print_id, shell_execute_print);
   shell.set_command_dependency(shell_cmd_print_id, std::vector<ShellCommandId>(1, shell_cmd_set_id));
 
+  /* Create a command of 'print_const' 
+   * This function does the same as 'print' but only requires read-only access to ShellContext
+   * Such commands can be executed concurrently in batch mode
+   */
+  Command shell_cmd_print_const("print_const");
+  ShellCommandId shell_cmd_print_const_id = shell.add_command(shell_cmd_print_const, "Print the value of internal variable 'a' with read-only access");
+  shell.set_command_class(shell_cmd_print_const_id, arith_cmd_class);
+  shell.set_command_const_execute_function(shell_cmd_print_const_id, shell_execute_print_const);
+  shell.set_command_dependency(shell_cmd_print_const_id, std::vector<ShellCommandId>(1, shell_cmd_set_id));
+
   /* Create a macro command of 'print_macro' 
    * This function will print the value of an internal variable of ShellContext 
    */
@@ -130,6 +153,11 @@ int main(int argc, char** argv) {
   shell.set_command_class(shell_cmd_exit_id, basic_cmd_class);
   shell.set_command_execute_function(shell_cmd_exit_id, [shell](){shell.exit();});
 
+  Command shell_cmd_report_profile("report_profile");
+  ShellCommandId shell_cmd_report_profile_id = shell.add_command(shell_cmd_report_profile, "Report runtime and memory usage of each executed command");
+  shell.set_command_class(shell_cmd_report_profile_id, basic_cmd_class);
+  shell.set_command_execute_function(shell_cmd_report_profile_id, [shell](){shell.print_profile();});
+
   /* Note: help must be the last to add because the linking to execute function will do a snapshot on the shell */
   Command shell_cmd_help("help");
   ShellCommandId shell_cmd_help_id = shell.add_command(shell_cmd_help, "Launch help desk");
@@ -152,6 +180,10 @@ int main(int argc, char** argv) {
     print_command_options(start_cmd);
   } else {
     /* Parse succeed. Start a shell */ 
+    if (true == start_cmd_context.option_enable(start_cmd, opt_profile_file)) {
+      shell.set_profile_file(start_cmd_context.option_value(start_cmd, opt_profile_file));
+    }
+
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
       shell.run_interactive_mode(shell_context);
       return 0;
@@ -159,7 +191,8 @@ int main(int argc, char** argv) {
 
     if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
       shell.run_script_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
-                            shell_context);
+                            shell_context,
+                            start_cmd_context.option_enable(start_cmd, opt_batch_exec));
       return 0;
     }
     /* Reach here there is something wrong, show the help desk */
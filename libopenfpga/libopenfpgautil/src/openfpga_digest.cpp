@@ -3,6 +3,8 @@
  * in OpenFPGA framework
  *******************************************************************/
 #include <sys/stat.h>
+#include <chrono>
+#include <ctime>
 #include <vector>
 #include <algorithm>
 
@@ -272,4 +274,22 @@ bool write_tab_to_file(std::fstream& fp,
   return true;
 }
 
+/********************************************************************
+ * Return the current date and time in the format of ctime(),
+ * without the trailing new line, to be printed in file headers
+ *******************************************************************/
+std::string get_current_date() {
+  auto end = std::chrono::system_clock::now(); 
+  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
+
+  /* Use the reentrant version of ctime(), as files may be written by concurrent commands */
+  char end_time_str[26];
+  std::string date(ctime_r(&end_time, end_time_str));
+  if ( (false == date.empty()) && ('\n' == date.back()) ) {
+    date.pop_back();
+  }
+
+  return date;
+}
+
 } /* namespace openfpga ends */
@@ -1,8 +1,13 @@
 /************************************************************************
  * Member functions for class DeviceRRGSB
  ***********************************************************************/
+#include <array>
+#include <map>
+#include <unordered_map>
+
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_time.h"
 #include "device_rr_gsb.h"
 
 /* namespace openfpga begins */
@@ -205,11 +210,21 @@ RRGSB& DeviceRRGSB::get_mutable_gsb(const size_t& x, const size_t& y) {
   return get_mutable_gsb(coordinate);
 }
 
-/* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+/* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors 
+ * To avoid comparing each CB to all the unique modules found so far,
+ * the unique modules are bucketed by their fingerprints.
+ * Mirrors always share the same fingerprint, so the full mirror checking
+ * is only required for the unique modules in the same bucket.
+ * As the unique modules in a bucket are kept in the order of their ids,
+ * the unique module ids are the same as an exhaustive search 
+ */
 void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type) {
   /* Make sure a clean start */
   clear_cb_unique_module(cb_type);
 
+  /* Unique module ids grouped by fingerprints */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
       bool is_unique_module = true;
@@ -220,8 +235,10 @@ void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_typ
         continue;
       }
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_cb_unique_module(cb_type); ++id) {
+      std::vector<size_t>& bucket = unique_module_buckets[rr_gsb_[ix][iy].get_cb_fingerprint(rr_graph, cb_type)];
+
+      /* Traverse the unique_mirror list with the same fingerprint and check it is an mirror of another */
+      for (const size_t& id : bucket) {
         const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
         if (true == rr_gsb_[ix][iy].is_cb_mirror(rr_graph, unique_module, cb_type)) {
           /* This is a mirror, raise the flag and we finish */
@@ -236,24 +253,33 @@ void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_typ
         add_cb_unique_module(cb_type, gsb_coordinate);
         /* Record the id of unique mirror */
         set_cb_unique_module_id(cb_type, gsb_coordinate, get_num_cb_unique_module(cb_type) - 1); 
+        bucket.push_back(get_num_cb_unique_module(cb_type) - 1);
       }
     }
   } 
 }
 
-/* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+/* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors 
+ * Same as the connection blocks, the unique modules are bucketed by fingerprints
+ * so that the full mirror checking is only run on fingerprint collisions
+ */
 void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
   /* Make sure a clean start */
   clear_sb_unique_module();
 
+  /* Unique module ids grouped by fingerprints */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
+
   /* Build the unique module */
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
       bool is_unique_module = true;
       vtr::Point<size_t> sb_coordinate(ix, iy);
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_sb_unique_module(); ++id) {
+      std::vector<size_t>& bucket = unique_module_buckets[rr_gsb_[ix][iy].get_sb_fingerprint(rr_graph)];
+
+      /* Traverse the unique_mirror list with the same fingerprint and check it is an mirror of another */
+      for (const size_t& id : bucket) {
         /* Check if the two modules have the same submodules,
          * if so, these two modules are the same, indicating the sb is not unique.
          * else the sb is unique 
@@ -273,6 +299,7 @@ void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
         sb_unique_module_.push_back(sb_coordinate);
         /* Record the id of unique mirror */
         sb_unique_module_id_[ix][iy] = sb_unique_module_.size() - 1; 
+        bucket.push_back(sb_unique_module_.size() - 1);
       }
     }
   } 
@@ -285,42 +312,46 @@ void DeviceRRGSB::build_gsb_unique_module() {
   /* Make sure a clean start */
   clear_gsb_unique_module();
 
+  /* We have alreay built sb and cb unique module list 
+   * We just need to check if the unique module id of SBs, CBX and CBY are the same or not 
+   * Therefore, the unique GSBs can be indexed directly by the ids
+   */
+  std::map<std::array<size_t, 3>, size_t> unique_module_lookup;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
       vtr::Point<size_t> gsb_coordinate(ix, iy);
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_gsb_unique_module(); ++id) {
-        /* We have alreay built sb and cb unique module list 
-         * We just need to check if the unique module id of SBs, CBX and CBY are the same or not 
-         */
-        const vtr::Point<size_t>& gsb_unique_module_coordinate = gsb_unique_module_[id];
-        if ((sb_unique_module_id_[ix][iy] == sb_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])
-         && (cbx_unique_module_id_[ix][iy] == cbx_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])
-         && (cby_unique_module_id_[ix][iy] == cby_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          gsb_unique_module_id_[ix][iy] = id; 
-          break;
-        }
+      std::array<size_t, 3> gsb_key = {{sb_unique_module_id_[ix][iy],
+                                        cbx_unique_module_id_[ix][iy],
+                                        cby_unique_module_id_[ix][iy]}};
+      auto result = unique_module_lookup.find(gsb_key);
+      if (result != unique_module_lookup.end()) {
+        /* This is a mirror, record the id of unique mirror */
+        gsb_unique_module_id_[ix][iy] = result->second; 
+        continue;
       }
+
       /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        add_gsb_unique_module(gsb_coordinate);
-        /* Record the id of unique mirror */
-        gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
-      }
+      add_gsb_unique_module(gsb_coordinate);
+      /* Record the id of unique mirror */
+      gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
+      unique_module_lookup[gsb_key] = get_num_gsb_unique_module() - 1;
     }
   } 
 }
 
 void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph) {
-  build_sb_unique_module(rr_graph);
+  {
+    vtr::ScopedStartFinishTimer timer("Identify unique switch blocks");
+    build_sb_unique_module(rr_graph);
+  }
 
-  build_cb_unique_module(rr_graph, CHANX);
-  build_cb_unique_module(rr_graph, CHANY);
+  {
+    vtr::ScopedStartFinishTimer timer("Identify unique connection blocks");
+    build_cb_unique_module(rr_graph, CHANX);
+    build_cb_unique_module(rr_graph, CHANY);
+  }
 
   build_gsb_unique_module();
 }
@@ -1,8 +1,6 @@
 /************************************************************************
  * Member functions for class VprDeviceAnnotation
  ***********************************************************************/
-#include <algorithm>
-
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vpr_device_annotation.h"
@@ -17,136 +15,267 @@ VprDeviceAnnotation::VprDeviceAnnotation() {
   return;
 }
 
+/************************************************************************
+ * Internal dense indices
+ ***********************************************************************/
+size_t VprDeviceAnnotation::find_pb_type(const t_pb_type* pb_type) const {
+  auto it = pb_type_indices_.find(pb_type);
+  if (it == pb_type_indices_.end()) {
+    return INVALID_INDEX;
+  }
+  return it->second;
+}
+
+size_t VprDeviceAnnotation::find_port(const t_port* pb_port) const {
+  auto it = port_indices_.find(pb_port);
+  if (it == port_indices_.end()) {
+    return INVALID_INDEX;
+  }
+  return it->second;
+}
+
+size_t VprDeviceAnnotation::find_interconnect(const t_interconnect* pb_interconnect) const {
+  auto it = interconnect_indices_.find(pb_interconnect);
+  if (it == interconnect_indices_.end()) {
+    return INVALID_INDEX;
+  }
+  return it->second;
+}
+
+size_t VprDeviceAnnotation::find_pb_graph_node(const t_pb_graph_node* pb_graph_node) const {
+  auto it = pb_graph_node_indices_.find(pb_graph_node);
+  if (it == pb_graph_node_indices_.end()) {
+    return INVALID_INDEX;
+  }
+  return it->second;
+}
+
+/* Find the cluster type that a pb_graph_pin belongs to */
+static
+const t_pb_graph_node* find_pb_graph_pin_head(const t_pb_graph_pin* pb_graph_pin) {
+  const t_pb_graph_node* pb_graph_head = pb_graph_pin->parent_node;
+  while (nullptr != pb_graph_head->parent_pb_graph_node) {
+    pb_graph_head = pb_graph_head->parent_pb_graph_node;
+  }
+  return pb_graph_head;
+}
+
+size_t VprDeviceAnnotation::find_pb_graph_head(const t_pb_graph_pin* pb_graph_pin) const {
+  const t_pb_graph_node* pb_graph_head = find_pb_graph_pin_head(pb_graph_pin);
+  for (size_t ihead = 0; ihead < pb_graph_heads_.size(); ++ihead) {
+    if (pb_graph_head == pb_graph_heads_[ihead]) {
+      return ihead;
+    }
+  }
+  return INVALID_INDEX;
+}
+
+size_t VprDeviceAnnotation::register_pb_type(const t_pb_type* pb_type) {
+  auto result = pb_type_indices_.emplace(pb_type, physical_pb_types_.size());
+  if (true == result.second) {
+    /* A new pb_type, allocate default annotations */
+    physical_pb_types_.push_back(nullptr);
+    physical_pb_type_index_factors_.push_back(1.);
+    physical_pb_type_index_factor_annotated_.push_back(false);
+    physical_pb_type_index_offsets_.push_back(0);
+    physical_pb_type_index_offset_annotated_.push_back(false);
+    physical_pb_modes_.push_back(nullptr);
+    pb_type_circuit_models_.push_back(CircuitModelId::INVALID());
+    pb_type_mode_bits_.emplace_back();
+    pb_type_mode_bits_annotated_.push_back(false);
+    pb_graph_node_unique_index_.emplace_back();
+  }
+  return result.first->second;
+}
+
+size_t VprDeviceAnnotation::register_port(const t_port* pb_port) {
+  auto result = port_indices_.emplace(pb_port, physical_pb_ports_.size());
+  if (true == result.second) {
+    physical_pb_ports_.emplace_back();
+    physical_pb_port_annotations_.emplace_back();
+    pb_circuit_ports_.push_back(CircuitPortId::INVALID());
+  }
+  return result.first->second;
+}
+
+size_t VprDeviceAnnotation::register_interconnect(const t_interconnect* pb_interconnect) {
+  auto result = interconnect_indices_.emplace(pb_interconnect, interconnect_circuit_models_.size());
+  if (true == result.second) {
+    interconnect_circuit_models_.push_back(CircuitModelId::INVALID());
+    interconnect_physical_types_.push_back(NUM_INTERC_TYPES);
+  }
+  return result.first->second;
+}
+
+size_t VprDeviceAnnotation::register_pb_graph_node(const t_pb_graph_node* pb_graph_node) {
+  auto result = pb_graph_node_indices_.emplace(pb_graph_node, physical_pb_graph_nodes_.size());
+  if (true == result.second) {
+    physical_pb_graph_nodes_.push_back(nullptr);
+    pb_graph_node_unique_ids_.push_back(PbGraphNodeId::INVALID());
+  }
+  return result.first->second;
+}
+
+size_t VprDeviceAnnotation::register_pb_graph_head(const t_pb_graph_pin* pb_graph_pin) {
+  size_t head_index = find_pb_graph_head(pb_graph_pin);
+  if (INVALID_INDEX == head_index) {
+    /* A new cluster type, allocate default annotations */
+    head_index = pb_graph_heads_.size();
+    pb_graph_heads_.push_back(find_pb_graph_pin_head(pb_graph_pin));
+    physical_pb_graph_pins_.emplace_back();
+  }
+  /* Expand the pin annotations to cover the pin */
+  VTR_ASSERT(0 <= pb_graph_pin->pin_count_in_cluster);
+  if (physical_pb_graph_pins_[head_index].size() <= size_t(pb_graph_pin->pin_count_in_cluster)) {
+    physical_pb_graph_pins_[head_index].resize(pb_graph_pin->pin_count_in_cluster + 1, nullptr);
+  }
+  return head_index;
+}
+
+const VprDeviceAnnotation::t_physical_pb_port_annotation* VprDeviceAnnotation::find_physical_pb_port_annotation(t_port* operating_pb_port,
+                                                                                                                t_port* physical_pb_port) const {
+  size_t port_index = find_port(operating_pb_port);
+  if (INVALID_INDEX == port_index) {
+    return nullptr;
+  }
+  for (const t_physical_pb_port_annotation& port_annotation : physical_pb_port_annotations_[port_index]) {
+    if (physical_pb_port == port_annotation.physical_pb_port) {
+      return &port_annotation;
+    }
+  }
+  return nullptr;
+}
+
+VprDeviceAnnotation::t_physical_pb_port_annotation& VprDeviceAnnotation::physical_pb_port_annotation(t_port* operating_pb_port,
+                                                                                                     t_port* physical_pb_port) {
+  std::vector<t_physical_pb_port_annotation>& port_annotations = physical_pb_port_annotations_[register_port(operating_pb_port)];
+  for (t_physical_pb_port_annotation& port_annotation : port_annotations) {
+    if (physical_pb_port == port_annotation.physical_pb_port) {
+      return port_annotation;
+    }
+  }
+  /* Not found, create a new annotation */
+  port_annotations.emplace_back();
+  port_annotations.back().physical_pb_port = physical_pb_port;
+  return port_annotations.back();
+}
+
 /************************************************************************
  * Public accessors
  ***********************************************************************/
 bool VprDeviceAnnotation::is_physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  size_t pb_type_index = find_pb_type(pb_type);
+  if (INVALID_INDEX == pb_type_index) {
     return false;
   }
   /* A physical pb_type should be mapped to itself! Otherwise, it is an operating pb_type */
-  return pb_type == physical_pb_types_.at(pb_type);
+  return pb_type == physical_pb_types_[pb_type_index];
 }
 
 t_mode* VprDeviceAnnotation::physical_mode(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_mode*>::const_iterator it = physical_pb_modes_.find(pb_type);
-  if (it == physical_pb_modes_.end()) {
+  size_t pb_type_index = find_pb_type(pb_type);
+  if (INVALID_INDEX == pb_type_index) {
     return nullptr;
   }
-  return physical_pb_modes_.at(pb_type);
+  return physical_pb_modes_[pb_type_index];
 }
 
 t_pb_type* VprDeviceAnnotation::physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  size_t pb_type_index = find_pb_type(pb_type);
+  if (INVALID_INDEX == pb_type_index) {
     return nullptr;
   }
-  return physical_pb_types_.at(pb_type);
+  return physical_pb_types_[pb_type_index];
 }
 
 std::vector<t_port*> VprDeviceAnnotation::physical_pb_port(t_port* pb_port) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::vector<t_port*>>::const_iterator it = physical_pb_ports_.find(pb_port);
-  if (it == physical_pb_ports_.end()) {
+  size_t port_index = find_port(pb_port);
+  if (INVALID_INDEX == port_index) {
     return std::vector<t_port*>();
   }
-  return physical_pb_ports_.at(pb_port);
+  return physical_pb_ports_[port_index];
 }
 
 BasicPort VprDeviceAnnotation::physical_pb_port_range(t_port* operating_pb_port,
                                                       t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, BasicPort>>::const_iterator it = physical_pb_port_ranges_.find(operating_pb_port);
-  if (it == physical_pb_port_ranges_.end()) {
-    /* Return an invalid port. As such the port width will be 0, which is an invalid value */
-    return BasicPort();
-  }
-  if (0 == physical_pb_port_ranges_.at(operating_pb_port).count(physical_pb_port)) {
+  const t_physical_pb_port_annotation* port_annotation = find_physical_pb_port_annotation(operating_pb_port, physical_pb_port);
+  if ( (nullptr == port_annotation)
+    || (false == port_annotation->port_range_annotated)) {
     /* Return an invalid port. As such the port width will be 0, which is an invalid value */
     return BasicPort();
   }
-  return physical_pb_port_ranges_.at(operating_pb_port).at(physical_pb_port);
+  return port_annotation->port_range;
 }
 
 CircuitModelId VprDeviceAnnotation::pb_type_circuit_model(t_pb_type* physical_pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it = pb_type_circuit_models_.find(physical_pb_type);
-  if (it == pb_type_circuit_models_.end()) {
+  size_t pb_type_index = find_pb_type(physical_pb_type);
+  if (INVALID_INDEX == pb_type_index) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return pb_type_circuit_models_.at(physical_pb_type);
+  return pb_type_circuit_models_[pb_type_index];
 }
 
 CircuitModelId VprDeviceAnnotation::interconnect_circuit_model(t_interconnect* pb_interconnect) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it = interconnect_circuit_models_.find(pb_interconnect);
-  if (it == interconnect_circuit_models_.end()) {
+  /* Ensure that the interconnect is in the list */
+  size_t interc_index = find_interconnect(pb_interconnect);
+  if (INVALID_INDEX == interc_index) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return interconnect_circuit_models_.at(pb_interconnect);
+  return interconnect_circuit_models_[interc_index];
 }
 
 e_interconnect VprDeviceAnnotation::interconnect_physical_type(t_interconnect* pb_interconnect) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it = interconnect_physical_types_.find(pb_interconnect);
-  if (it == interconnect_physical_types_.end()) {
+  /* Ensure that the interconnect is in the list */
+  size_t interc_index = find_interconnect(pb_interconnect);
+  if (INVALID_INDEX == interc_index) {
     /* Return an invalid interconnect type */
     return NUM_INTERC_TYPES;
   }
-  return interconnect_physical_types_.at(pb_interconnect);
+  return interconnect_physical_types_[interc_index];
 }
 
 CircuitPortId VprDeviceAnnotation::pb_circuit_port(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, CircuitPortId>::const_iterator it = pb_circuit_ports_.find(pb_port);
-  if (it == pb_circuit_ports_.end()) {
+  /* Ensure that the port is in the list */
+  size_t port_index = find_port(pb_port);
+  if (INVALID_INDEX == port_index) {
     /* Return an invalid circuit port id */
     return CircuitPortId::INVALID();
   }
-  return pb_circuit_ports_.at(pb_port);
+  return pb_circuit_ports_[port_index];
 }
 
 std::vector<size_t> VprDeviceAnnotation::pb_type_mode_bits(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it = pb_type_mode_bits_.find(pb_type);
-  if (it == pb_type_mode_bits_.end()) {
+  size_t pb_type_index = find_pb_type(pb_type);
+  if (INVALID_INDEX == pb_type_index) {
     /* Return an empty vector */
     return std::vector<size_t>();
   }
-  return pb_type_mode_bits_.at(pb_type);
+  return pb_type_mode_bits_[pb_type_index];
 }
 
 PbGraphNodeId VprDeviceAnnotation::pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_graph_node->pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
-    /* Invalid pb_type, return a null pointer */
-    return PbGraphNodeId::INVALID();
-  }
-
-  /* Try to find the pb_graph_node in the vector */
-  std::vector<t_pb_graph_node*>::const_iterator it_node = std::find(pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin(),
-                                                                    pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end(),
-                                                                    pb_graph_node);
-  /* If it exists, return the index
-   * Otherwise, return an invalid id
+  /* The unique index is stored when the pb_graph_node is added,
+   * so there is no need to search the list of pb_graph_nodes
    */
-  if (it_node == pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end()) {
+  size_t node_index = find_pb_graph_node(pb_graph_node);
+  if (INVALID_INDEX == node_index) {
     return PbGraphNodeId::INVALID();
   }
-  return PbGraphNodeId(it_node - pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin());
+  return pb_graph_node_unique_ids_[node_index];
 }
 
 t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const PbGraphNodeId& unique_index) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
+  size_t pb_type_index = find_pb_type(pb_type);
+  if (INVALID_INDEX == pb_type_index) {
     /* Invalid pb_type, return a null pointer */
     return nullptr;
   }
@@ -154,120 +283,107 @@ t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const Pb
    *  - Out of range: return a null pointer
    *  - In range: return the pointer
    */
-  if ((size_t)unique_index > pb_graph_node_unique_index_.at(pb_type).size() - 1) {
+  if ((size_t)unique_index >= pb_graph_node_unique_index_[pb_type_index].size()) {
     return nullptr;
   }
 
-  return pb_graph_node_unique_index_.at(pb_type)[size_t(unique_index)];
+  return pb_graph_node_unique_index_[pb_type_index][size_t(unique_index)];
 }
 
 t_pb_graph_node* VprDeviceAnnotation::physical_pb_graph_node(t_pb_graph_node* pb_graph_node) const {
   /* Ensure that the pb_graph_node is in the list */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(pb_graph_node);
-  if (it == physical_pb_graph_nodes_.end()) {
+  size_t node_index = find_pb_graph_node(pb_graph_node);
+  if (INVALID_INDEX == node_index) {
     return nullptr;
   }
-  return physical_pb_graph_nodes_.at(pb_graph_node);
+  return physical_pb_graph_nodes_[node_index];
 }
 
 float VprDeviceAnnotation::physical_pb_type_index_factor(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, float>::const_iterator it = physical_pb_type_index_factors_.find(pb_type);
-  if (it == physical_pb_type_index_factors_.end()) {
+  size_t pb_type_index = find_pb_type(pb_type);
+  if (INVALID_INDEX == pb_type_index) {
     /* Default value is 1 */
     return 1.;
   }
-  return physical_pb_type_index_factors_.at(pb_type);
+  return physical_pb_type_index_factors_[pb_type_index];
 }
 
 int VprDeviceAnnotation::physical_pb_type_index_offset(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, int>::const_iterator it = physical_pb_type_index_offsets_.find(pb_type);
-  if (it == physical_pb_type_index_offsets_.end()) {
+  size_t pb_type_index = find_pb_type(pb_type);
+  if (INVALID_INDEX == pb_type_index) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_type_index_offsets_.at(pb_type);
+  return physical_pb_type_index_offsets_[pb_type_index];
 }
 
 int VprDeviceAnnotation::physical_pb_pin_initial_offset(t_port* operating_pb_port,
                                                         t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_initial_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_initial_offsets_.end()) {
-    /* Default value is 0 */
-    return 0;
-  }
-  if (0 == physical_pb_pin_initial_offsets_.at(operating_pb_port).count(physical_pb_port)) {
+  const t_physical_pb_port_annotation* port_annotation = find_physical_pb_port_annotation(operating_pb_port, physical_pb_port);
+  if (nullptr == port_annotation) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_initial_offsets_.at(operating_pb_port).at(physical_pb_port);
+  return port_annotation->pin_initial_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_pin_rotate_offset(t_port* operating_pb_port,
                                                        t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_rotate_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_rotate_offsets_.end()) {
+  const t_physical_pb_port_annotation* port_annotation = find_physical_pb_port_annotation(operating_pb_port, physical_pb_port);
+  if (nullptr == port_annotation) {
     /* Default value is 0 */
     return 0;
   }
-  if (0 == physical_pb_pin_rotate_offsets_.at(operating_pb_port).count(physical_pb_port)) {
-    /* Default value is 0 */
-    return 0;
-  }
-  return physical_pb_pin_rotate_offsets_.at(operating_pb_port).at(physical_pb_port);
+  return port_annotation->pin_rotate_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_pin_offset(t_port* operating_pb_port,
                                                 t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_offsets_.end()) {
-    /* Default value is 0 */
-    return 0;
-  }
-  if (0 == physical_pb_pin_offsets_.at(operating_pb_port).count(physical_pb_port)) {
+  const t_physical_pb_port_annotation* port_annotation = find_physical_pb_port_annotation(operating_pb_port, physical_pb_port);
+  if (nullptr == port_annotation) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_offsets_.at(operating_pb_port).at(physical_pb_port);
+  return port_annotation->pin_offset;
 }
 
 t_pb_graph_pin* VprDeviceAnnotation::physical_pb_graph_pin(const t_pb_graph_pin* pb_graph_pin) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(pb_graph_pin);
-  if (it == physical_pb_graph_pins_.end()) {
+  /* Ensure that the pb_graph_pin is in the list */
+  size_t head_index = find_pb_graph_head(pb_graph_pin);
+  if (INVALID_INDEX == head_index) {
+    return nullptr;
+  }
+  const std::vector<t_pb_graph_pin*>& head_pins = physical_pb_graph_pins_[head_index];
+  if (head_pins.size() <= size_t(pb_graph_pin->pin_count_in_cluster)) {
     return nullptr;
   }
-  return physical_pb_graph_pins_.at(pb_graph_pin);
+  return head_pins[pb_graph_pin->pin_count_in_cluster];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_switch_circuit_model(const RRSwitchId& rr_switch) const {
   /* Ensure that the rr_switch is in the list */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it == rr_switch_circuit_models_.end()) {
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_switch_circuit_models_.at(rr_switch);
+  return rr_switch_circuit_models_[rr_switch];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_segment_circuit_model(const RRSegmentId& rr_segment) const {
-  /* Ensure that the rr_switch is in the list */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it == rr_segment_circuit_models_.end()) {
+  /* Ensure that the rr_segment is in the list */
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_segment_circuit_models_.at(rr_segment);
+  return rr_segment_circuit_models_[rr_segment];
 }
 
 ArchDirectId VprDeviceAnnotation::direct_annotation(const size_t& direct) const {
-  /* Ensure that the rr_switch is in the list */
-  if (0 == direct_annotations_.count(direct)) {
+  /* Ensure that the direct is in the list */
+  if (direct >= direct_annotations_.size()) {
     return ArchDirectId::INVALID();
   }
-  return direct_annotations_.at(direct);
+  return direct_annotations_[direct];
 }
 
 LbRRGraph VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
@@ -282,30 +398,32 @@ LbRRGraph VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_he
  * Public mutators
  ***********************************************************************/
 void VprDeviceAnnotation::add_pb_type_physical_mode(t_pb_type* pb_type, t_mode* physical_mode) {
+  size_t pb_type_index = register_pb_type(pb_type);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_mode*>::const_iterator it = physical_pb_modes_.find(pb_type);
-  if (it != physical_pb_modes_.end()) {
+  if (nullptr != physical_pb_modes_[pb_type_index]) {
     VTR_LOG_WARN("Override the annotation between pb_type '%s' and it physical mode '%s'!\n",
                  pb_type->name, physical_mode->name);
   }
 
-  physical_pb_modes_[pb_type] = physical_mode;
+  physical_pb_modes_[pb_type_index] = physical_mode;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type(t_pb_type* operating_pb_type, t_pb_type* physical_pb_type) {
+  size_t pb_type_index = register_pb_type(operating_pb_type);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(operating_pb_type);
-  if (it != physical_pb_types_.end()) {
+  if (nullptr != physical_pb_types_[pb_type_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type '%s'!\n",
                  operating_pb_type->name, physical_pb_type->name);
   }
 
-  physical_pb_types_[operating_pb_type] = physical_pb_type;
+  physical_pb_types_[pb_type_index] = physical_pb_type;
 }
 
 void VprDeviceAnnotation::add_physical_pb_port(t_port* operating_pb_port,
                                                t_port* physical_pb_port) {
-  physical_pb_ports_[operating_pb_port].push_back(physical_pb_port);
+  physical_pb_ports_[register_port(operating_pb_port)].push_back(physical_pb_port);
 }
 
 void VprDeviceAnnotation::add_physical_pb_port_range(t_port* operating_pb_port,
@@ -314,84 +432,101 @@ void VprDeviceAnnotation::add_physical_pb_port_range(t_port* operating_pb_port,
   /* The port range must satify the port width*/
   VTR_ASSERT((size_t)operating_pb_port->num_pins >= port_range.get_width());
 
+  t_physical_pb_port_annotation& port_annotation = physical_pb_port_annotation(operating_pb_port, physical_pb_port);
+
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, BasicPort>>::const_iterator it = physical_pb_port_ranges_.find(operating_pb_port);
-  if ( (it != physical_pb_port_ranges_.end())
-    && (0 < physical_pb_port_ranges_[operating_pb_port].count(physical_pb_port)) ) {
+  if (true == port_annotation.port_range_annotated) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port range '%s[%ld:%ld]'!\n",
                  operating_pb_port->name,
                  physical_pb_port->name,
                  port_range.get_lsb(), port_range.get_msb());
   }
 
-  physical_pb_port_ranges_[operating_pb_port][physical_pb_port] = port_range;
+  port_annotation.port_range = port_range;
+  port_annotation.port_range_annotated = true;
 }
 
 void VprDeviceAnnotation::add_pb_type_circuit_model(t_pb_type* physical_pb_type, const CircuitModelId& circuit_model) {
+  size_t pb_type_index = register_pb_type(physical_pb_type);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it = pb_type_circuit_models_.find(physical_pb_type);
-  if (it != pb_type_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != pb_type_circuit_models_[pb_type_index]) {
     VTR_LOG_WARN("Override the circuit model for physical pb_type '%s'!\n",
                  physical_pb_type->name);
   }
 
-  pb_type_circuit_models_[physical_pb_type] = circuit_model;
+  pb_type_circuit_models_[pb_type_index] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_circuit_model(t_interconnect* pb_interconnect, const CircuitModelId& circuit_model) {
+  size_t interc_index = register_interconnect(pb_interconnect);
+
   /* Warn any override attempt */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it = interconnect_circuit_models_.find(pb_interconnect);
-  if (it != interconnect_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != interconnect_circuit_models_[interc_index]) {
     VTR_LOG_WARN("Override the circuit model for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
 
-  interconnect_circuit_models_[pb_interconnect] = circuit_model;
+  interconnect_circuit_models_[interc_index] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_physical_type(t_interconnect* pb_interconnect,
                                                          const e_interconnect& physical_type) {
+  size_t interc_index = register_interconnect(pb_interconnect);
+
   /* Warn any override attempt */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it = interconnect_physical_types_.find(pb_interconnect);
-  if (it != interconnect_physical_types_.end()) {
+  if (NUM_INTERC_TYPES != interconnect_physical_types_[interc_index]) {
     VTR_LOG_WARN("Override the physical interconnect for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
 
-  interconnect_physical_types_[pb_interconnect] = physical_type;
+  interconnect_physical_types_[interc_index] = physical_type;
 }
 
 void VprDeviceAnnotation::add_pb_circuit_port(t_port* pb_port, const CircuitPortId& circuit_port) {
+  size_t port_index = register_port(pb_port);
+
   /* Warn any override attempt */
-  std::map<t_port*, CircuitPortId>::const_iterator it = pb_circuit_ports_.find(pb_port);
-  if (it != pb_circuit_ports_.end()) {
+  if (CircuitPortId::INVALID() != pb_circuit_ports_[port_index]) {
     VTR_LOG_WARN("Override the circuit port mapping for pb_type port '%s'!\n",
                  pb_port->name);
   }
 
-  pb_circuit_ports_[pb_port] = circuit_port;
+  pb_circuit_ports_[port_index] = circuit_port;
 }
 
 void VprDeviceAnnotation::add_pb_type_mode_bits(t_pb_type* pb_type, const std::vector<size_t>& mode_bits) {
+  size_t pb_type_index = register_pb_type(pb_type);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it = pb_type_mode_bits_.find(pb_type);
-  if (it != pb_type_mode_bits_.end()) {
+  if (true == pb_type_mode_bits_annotated_[pb_type_index]) {
     VTR_LOG_WARN("Override the mode bits mapping for pb_type '%s'!\n",
                  pb_type->name);
   }
 
-  pb_type_mode_bits_[pb_type] = mode_bits;
+  pb_type_mode_bits_[pb_type_index] = mode_bits;
+  pb_type_mode_bits_annotated_[pb_type_index] = true;
 }
 
 void VprDeviceAnnotation::add_pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) {
-  pb_graph_node_unique_index_[pb_graph_node->pb_type].push_back(pb_graph_node);
+  std::vector<t_pb_graph_node*>& pb_graph_nodes = pb_graph_node_unique_index_[register_pb_type(pb_graph_node->pb_type)];
+  size_t node_index = register_pb_graph_node(pb_graph_node);
+
+  /* The unique index is the position in the list of the pb_type
+   * If the node has been added before, the first position is kept as the unique index
+   */
+  if (PbGraphNodeId::INVALID() == pb_graph_node_unique_ids_[node_index]) {
+    pb_graph_node_unique_ids_[node_index] = PbGraphNodeId(pb_graph_nodes.size());
+  }
+  pb_graph_nodes.push_back(pb_graph_node);
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_pb_graph_node, 
                                                      t_pb_graph_node* physical_pb_graph_node) {
+  size_t node_index = register_pb_graph_node(operating_pb_graph_node);
+
   /* Warn any override attempt */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(operating_pb_graph_node);
-  if (it != physical_pb_graph_nodes_.end()) {
+  if (nullptr != physical_pb_graph_nodes_[node_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_node '%s[%d]' and it physical pb_graph_node '%s[%d]'!\n",
                  operating_pb_graph_node->pb_type->name, 
                  operating_pb_graph_node->placement_index,
@@ -399,71 +534,79 @@ void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_
                  physical_pb_graph_node->placement_index);
   }
 
-  physical_pb_graph_nodes_[operating_pb_graph_node] = physical_pb_graph_node;
+  physical_pb_graph_nodes_[node_index] = physical_pb_graph_node;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_factor(t_pb_type* pb_type, const float& factor) {
+  size_t pb_type_index = register_pb_type(pb_type);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, float>::const_iterator it = physical_pb_type_index_factors_.find(pb_type);
-  if (it != physical_pb_type_index_factors_.end()) {
+  if (true == physical_pb_type_index_factor_annotated_[pb_type_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type index factor '%f'!\n",
                  pb_type->name, factor);
   }
 
-  physical_pb_type_index_factors_[pb_type] = factor;
+  physical_pb_type_index_factors_[pb_type_index] = factor;
+  physical_pb_type_index_factor_annotated_[pb_type_index] = true;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_offset(t_pb_type* pb_type, const int& offset) {
+  size_t pb_type_index = register_pb_type(pb_type);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, int>::const_iterator it = physical_pb_type_index_offsets_.find(pb_type);
-  if (it != physical_pb_type_index_offsets_.end()) {
+  if (true == physical_pb_type_index_offset_annotated_[pb_type_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type index offset '%d'!\n",
                  pb_type->name, offset);
   }
 
-  physical_pb_type_index_offsets_[pb_type] = offset;
+  physical_pb_type_index_offsets_[pb_type_index] = offset;
+  physical_pb_type_index_offset_annotated_[pb_type_index] = true;
 }
 
 void VprDeviceAnnotation::add_physical_pb_pin_initial_offset(t_port* operating_pb_port,
                                                              t_port* physical_pb_port,
                                                              const int& offset) {
+  t_physical_pb_port_annotation& port_annotation = physical_pb_port_annotation(operating_pb_port, physical_pb_port);
+
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_initial_offsets_.find(operating_pb_port);
-  if ( (it != physical_pb_pin_initial_offsets_.end())
-    && (0 < physical_pb_pin_initial_offsets_[operating_pb_port].count(physical_pb_port)) ) {
-    VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port '%s' pin rotate offset '%d'!\n",
-                 operating_pb_port->name, offset);
+  if (true == port_annotation.pin_initial_offset_annotated) {
+    VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port '%s' pin initial offset '%d'!\n",
+                 operating_pb_port->name, physical_pb_port->name, offset);
   }
 
-  physical_pb_pin_initial_offsets_[operating_pb_port][physical_pb_port] = offset;
+  port_annotation.pin_initial_offset = offset;
+  port_annotation.pin_initial_offset_annotated = true;
 }
 
 void VprDeviceAnnotation::add_physical_pb_pin_rotate_offset(t_port* operating_pb_port,
                                                             t_port* physical_pb_port,
                                                             const int& offset) {
+  t_physical_pb_port_annotation& port_annotation = physical_pb_port_annotation(operating_pb_port, physical_pb_port);
+
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_rotate_offsets_.find(operating_pb_port);
-  if ( (it != physical_pb_pin_rotate_offsets_.end())
-    && (0 < physical_pb_pin_rotate_offsets_[operating_pb_port].count(physical_pb_port)) ) {
+  if (true == port_annotation.pin_rotate_offset_annotated) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port '%s' pin rotate offset '%d'!\n",
-                 operating_pb_port->name, offset);
+                 operating_pb_port->name, physical_pb_port->name, offset);
   }
 
-  physical_pb_pin_rotate_offsets_[operating_pb_port][physical_pb_port] = offset;
+  port_annotation.pin_rotate_offset = offset;
+  port_annotation.pin_rotate_offset_annotated = true;
   /* We initialize the accumulated offset to 0 */
-  physical_pb_pin_offsets_[operating_pb_port][physical_pb_port] = 0;
+  port_annotation.pin_offset = 0;
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operating_pb_graph_pin, 
                                                     t_pb_graph_pin* physical_pb_graph_pin) {
+  size_t head_index = register_pb_graph_head(operating_pb_graph_pin);
+  t_pb_graph_pin*& annotated_pin = physical_pb_graph_pins_[head_index][operating_pb_graph_pin->pin_count_in_cluster];
+
   /* Warn any override attempt */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(operating_pb_graph_pin);
-  if (it != physical_pb_graph_pins_.end()) {
+  if (nullptr != annotated_pin) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_pin '%s' and it physical pb_graph_pin '%s'!\n",
                  operating_pb_graph_pin->port->name, physical_pb_graph_pin->port->name);
   }
 
-  physical_pb_graph_pins_[operating_pb_graph_pin] = physical_pb_graph_pin;
+  annotated_pin = physical_pb_graph_pin;
 
   /* Update the accumulated offsets for the operating port 
    * Each time we pair two pins, we update the offset by the pin rotate offset
@@ -481,20 +624,26 @@ void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operat
     return;
   }
 
-  physical_pb_pin_offsets_[operating_pb_graph_pin->port][physical_pb_graph_pin->port] += physical_pb_pin_rotate_offset(operating_pb_graph_pin->port, physical_pb_graph_pin->port);
+  t_physical_pb_port_annotation& port_annotation = physical_pb_port_annotation(operating_pb_graph_pin->port, physical_pb_graph_pin->port);
+
+  port_annotation.pin_offset += port_annotation.pin_rotate_offset;
 
   if ((size_t)physical_pb_graph_pin->port->num_pins - 1 
     < operating_pb_graph_pin->pin_number
     + physical_pb_port_range(operating_pb_graph_pin->port, physical_pb_graph_pin->port).get_lsb() 
-    + physical_pb_pin_offsets_[operating_pb_graph_pin->port][physical_pb_graph_pin->port]) {
-    physical_pb_pin_offsets_[operating_pb_graph_pin->port][physical_pb_graph_pin->port] = 0;
+    + port_annotation.pin_offset) {
+    port_annotation.pin_offset = 0;
   }
 }
 
 void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switch, const CircuitModelId& circuit_model) {
+  /* Grow the list when a new switch is added */
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
+    rr_switch_circuit_models_.resize(size_t(rr_switch) + 1, CircuitModelId::INVALID());
+  }
+
   /* Warn any override attempt */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it != rr_switch_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != rr_switch_circuit_models_[rr_switch]) {
     VTR_LOG_WARN("Override the annotation between rr_switch '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_switch), size_t(circuit_model));
   }
@@ -503,9 +652,13 @@ void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switc
 }
 
 void VprDeviceAnnotation::add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model) {
+  /* Grow the list when a new segment is added */
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
+    rr_segment_circuit_models_.resize(size_t(rr_segment) + 1, CircuitModelId::INVALID());
+  }
+
   /* Warn any override attempt */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it != rr_segment_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != rr_segment_circuit_models_[rr_segment]) {
     VTR_LOG_WARN("Override the annotation between rr_segment '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_segment), size_t(circuit_model));
   }
@@ -514,8 +667,13 @@ void VprDeviceAnnotation::add_rr_segment_circuit_model(const RRSegmentId& rr_seg
 }
 
 void VprDeviceAnnotation::add_direct_annotation(const size_t& direct, const ArchDirectId& arch_direct_id) {
+  /* Grow the list when a new direct is added */
+  if (direct >= direct_annotations_.size()) {
+    direct_annotations_.resize(direct + 1, ArchDirectId::INVALID());
+  }
+
   /* Warn any override attempt */
-  if (0 < direct_annotations_.count(direct)) {
+  if (ArchDirectId::INVALID() != direct_annotations_[direct]) {
     VTR_LOG_WARN("Override the annotation between direct '%ld' and its annotation '%ld'!\n",
                  size_t(direct), size_t(arch_direct_id));
   }
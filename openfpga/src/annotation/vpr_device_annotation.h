@@ -5,8 +5,11 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map> 
+#include <unordered_map>
+#include <vector>
 
 /* Header from vtrutil library */
+#include "vtr_vector.h"
 #include "vtr_strong_id.h"
 
 /* Header from archfpga library */
@@ -110,36 +113,92 @@ class VprDeviceAnnotation {
     void add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model);
     void add_direct_annotation(const size_t& direct, const ArchDirectId& arch_direct_id);
     void add_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head, const LbRRGraph& lb_rr_graph);
+  private: /* Internal dense indices */
+    /* Each pb_type, port, interconnect and pb_graph_node which is
+     * annotated is assigned a dense index at the first time it is added.
+     * All the annotations are stored in flat vectors indexed by the dense indices
+     * The find_*() functions return INVALID_INDEX if the object is not annotated
+     * The register_*() functions assign a new index when required and
+     * allocate default annotations for it
+     *
+     * pb_graph_pins are not hashed: they are indexed by the cluster type,
+     * i.e., the top-level pb_graph_node, and the pin_count_in_cluster,
+     * which VPR numbers uniquely inside a cluster
+     * A placement_index of pb_graph_node is only unique among its siblings,
+     * so pb_graph_nodes are still hashed
+     */
+    static constexpr size_t INVALID_INDEX = size_t(-1);
+
+    size_t find_pb_type(const t_pb_type* pb_type) const;
+    size_t find_port(const t_port* pb_port) const;
+    size_t find_interconnect(const t_interconnect* pb_interconnect) const;
+    size_t find_pb_graph_node(const t_pb_graph_node* pb_graph_node) const;
+    size_t find_pb_graph_head(const t_pb_graph_pin* pb_graph_pin) const;
+
+    size_t register_pb_type(const t_pb_type* pb_type);
+    size_t register_port(const t_port* pb_port);
+    size_t register_interconnect(const t_interconnect* pb_interconnect);
+    size_t register_pb_graph_node(const t_pb_graph_node* pb_graph_node);
+    size_t register_pb_graph_head(const t_pb_graph_pin* pb_graph_pin);
+
+    /* Annotations between an operating pb_port and one of its physical pb_ports */
+    struct t_physical_pb_port_annotation {
+      t_port* physical_pb_port = nullptr;
+      /* LSB and MSB of the physical pb_port, an invalid port means not annotated */
+      BasicPort port_range;
+      bool port_range_annotated = false;
+      int pin_initial_offset = 0;
+      bool pin_initial_offset_annotated = false;
+      int pin_rotate_offset = 0;
+      bool pin_rotate_offset_annotated = false;
+      /* Accumulated offsets for a physical pb_type port, just for internal usage */
+      int pin_offset = 0;
+    };
+    const t_physical_pb_port_annotation* find_physical_pb_port_annotation(t_port* operating_pb_port,
+                                                                          t_port* physical_pb_port) const;
+    t_physical_pb_port_annotation& physical_pb_port_annotation(t_port* operating_pb_port,
+                                                               t_port* physical_pb_port);
   private: /* Internal data */
+    std::unordered_map<const t_pb_type*, size_t> pb_type_indices_;
+    std::unordered_map<const t_port*, size_t> port_indices_;
+    std::unordered_map<const t_interconnect*, size_t> interconnect_indices_;
+    std::unordered_map<const t_pb_graph_node*, size_t> pb_graph_node_indices_;
+    /* Top-level pb_graph_nodes, i.e., cluster types, which have annotated pb_graph_pins
+     * There are only a few cluster types, so a linear search is fast enough
+     */
+    std::vector<const t_pb_graph_node*> pb_graph_heads_;
+
     /* Pair a regular pb_type to its physical pb_type */
-    std::map<t_pb_type*, t_pb_type*> physical_pb_types_;
-    std::map<t_pb_type*, float> physical_pb_type_index_factors_;
-    std::map<t_pb_type*, int> physical_pb_type_index_offsets_;
+    std::vector<t_pb_type*> physical_pb_types_;
+    std::vector<float> physical_pb_type_index_factors_;
+    std::vector<bool> physical_pb_type_index_factor_annotated_;
+    std::vector<int> physical_pb_type_index_offsets_;
+    std::vector<bool> physical_pb_type_index_offset_annotated_;
 
     /* Pair a physical mode for a pb_type
      * Note:
      * - the physical mode MUST be a child mode of the pb_type
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_pb_type*, t_mode*> physical_pb_modes_;
+    std::vector<t_mode*> physical_pb_modes_;
 
     /* Pair a physical pb_type to its circuit model
      * Note:
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_pb_type*, CircuitModelId> pb_type_circuit_models_;
+    std::vector<CircuitModelId> pb_type_circuit_models_;
 
     /* Pair a interconnect of a physical pb_type to its circuit model
      * Note:
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_interconnect*, CircuitModelId> interconnect_circuit_models_;
+    std::vector<CircuitModelId> interconnect_circuit_models_;
 
     /* Physical type of interconnect 
      * Note:
      * - only applicable to an interconnect belongs to physical mode
      */
-    std::map<t_interconnect*, e_interconnect> interconnect_physical_types_;
+    std::vector<e_interconnect> interconnect_physical_types_;
 
     /* Pair a pb_type to its mode selection bits
      * - if the pb_type is a physical pb_type, the mode bits are the default mode 
@@ -147,53 +206,53 @@ class VprDeviceAnnotation {
      * - if the pb_type is an operating pb_type, the mode bits will be applied
      *   when the operating pb_type is used by packer
      */
-    std::map<t_pb_type*, std::vector<size_t>> pb_type_mode_bits_;
+    std::vector<std::vector<size_t>> pb_type_mode_bits_;
+    std::vector<bool> pb_type_mode_bits_annotated_;
 
     /* Pair a pb_port to its physical pb_port 
      * Note:
      * - the parent of physical pb_port MUST be a physical pb_type
      */
-    std::map<t_port*, std::vector<t_port*>> physical_pb_ports_;
-    std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_initial_offsets_;
-    std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_rotate_offsets_;
-
-    /* Accumulated offsets for a physical pb_type port, just for internal usage */
-    std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_offsets_;
+    std::vector<std::vector<t_port*>> physical_pb_ports_;
 
-    /* Pair a pb_port to its LSB and MSB of a physical pb_port 
-     * Note:
-     * - the LSB and MSB MUST be in range of the physical pb_port
+    /* Pin offsets and port ranges for each pair of operating and physical pb_port
+     * An operating pb_port is paired to very few physical pb_ports,
+     * so a linear search in the list is cheap
      */
-    std::map<t_port*, std::map<t_port*, BasicPort>> physical_pb_port_ranges_;
+    std::vector<std::vector<t_physical_pb_port_annotation>> physical_pb_port_annotations_;
 
     /* Pair a pb_port to a circuit port in circuit model
      * Note:
      * - the parent of physical pb_port MUST be a physical pb_type
      */
-    std::map<t_port*, CircuitPortId> pb_circuit_ports_;
+    std::vector<CircuitPortId> pb_circuit_ports_;
 
     /* Pair each pb_graph_node to an unique index in the graph
      * The unique index if the index in the array of t_pb_graph_node*
+     * which is indexed by the dense index of the pb_type
      */ 
-    std::map<t_pb_type*, std::vector<t_pb_graph_node*>> pb_graph_node_unique_index_;
+    std::vector<std::vector<t_pb_graph_node*>> pb_graph_node_unique_index_;
+    std::vector<PbGraphNodeId> pb_graph_node_unique_ids_;
 
     /* Pair a pb_graph_node to a physical pb_graph_node
      * Note:
      * - the pb_type of physical pb_graph_node must be a physical pb_type
      */
-    std::map<t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
+    std::vector<t_pb_graph_node*> physical_pb_graph_nodes_;
 
-    /* Pair a pb_graph_pin to a physical pb_graph_pin */
-    std::map<const t_pb_graph_pin*, t_pb_graph_pin*> physical_pb_graph_pins_;
+    /* Pair a pb_graph_pin to a physical pb_graph_pin
+     * Indexed by [cluster type][pin_count_in_cluster]
+     */
+    std::vector<std::vector<t_pb_graph_pin*>> physical_pb_graph_pins_;
 
     /* Pair a Routing Resource Switch (rr_switch) to a circuit model */
-    std::map<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
+    vtr::vector<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
 
     /* Pair a Routing Segment (rr_segment) to a circuit model */
-    std::map<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
+    vtr::vector<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
 
     /* Pair a direct connection (direct) to a annotation which contains circuit model id */
-    std::map<size_t, ArchDirectId> direct_annotations_;
+    std::vector<ArchDirectId> direct_annotations_;
 
     /* Logical type routing resource graphs built from physical modes */
     std::map<t_pb_graph_node*, LbRRGraph> physical_lb_rr_graphs_;
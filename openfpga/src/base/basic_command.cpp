@@ -1,6 +1,7 @@
 /********************************************************************
  * Add basic commands to the OpenFPGA shell interface, including:
  * - exit
+ * - report_profile
  * - help
  *******************************************************************/
 #include "basic_command.h"
@@ -17,6 +18,11 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   shell.set_command_class(shell_cmd_exit_id, basic_cmd_class);
   shell.set_command_execute_function(shell_cmd_exit_id, [shell](){shell.exit();});
 
+  Command shell_cmd_report_profile("report_profile");
+  ShellCommandId shell_cmd_report_profile_id = shell.add_command(shell_cmd_report_profile, "Report runtime and memory usage of each executed command");
+  shell.set_command_class(shell_cmd_report_profile_id, basic_cmd_class);
+  shell.set_command_execute_function(shell_cmd_report_profile_id, [shell](){shell.print_profile();});
+
   /* Note: help must be the last to add because the linking to execute function will do a snapshot on the shell */
   Command shell_cmd_help("help");
   ShellCommandId shell_cmd_help_id = shell.add_command(shell_cmd_help, "Launch help desk");
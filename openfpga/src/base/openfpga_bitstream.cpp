@@ -14,10 +14,13 @@
 /* Headers from fpgabitstream library */
 #include "read_xml_arch_bitstream.h"
 #include "write_xml_arch_bitstream.h"
+#include "read_binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
 
 #include "build_device_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
+#include "write_binary_fabric_bitstream.h"
 #include "build_fabric_bitstream.h"
 #include "openfpga_bitstream.h"
 
@@ -36,9 +39,29 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_file_format = cmd.option("format");
+
+  /* Check file format requirements */
+  std::string file_format("xml"); 
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+
+  if ( (std::string("xml") != file_format)
+    && (std::string("binary") != file_format) ) {
+    VTR_LOG_ERROR("Invalid file format '%s' of architecture bitstream! Expect [xml|binary]\n",
+                  file_format.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   if (true == cmd_context.option_enable(cmd, opt_read_file)) {
-    openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file).c_str());
+    if (std::string("binary") == file_format) {
+      openfpga_ctx.mutable_bitstream_manager() = read_binary_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file));
+    } else {
+      openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file).c_str());
+    }
+    annotate_device_bitstream_configurable_children(openfpga_ctx.mutable_bitstream_manager(),
+                                                    openfpga_ctx.module_graph());
   } else {
     openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(g_vpr_ctx,
                                                                       openfpga_ctx,
@@ -51,8 +74,15 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
     /* Create directories */
     create_directory(src_dir_path);
 
-    write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
-                                     cmd_context.option_value(cmd, opt_write_file));
+    if (std::string("binary") == file_format) {
+      if (0 != write_binary_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                                   cmd_context.option_value(cmd, opt_write_file))) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    } else {
+      write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                       cmd_context.option_value(cmd, opt_write_file));
+    }
   }
 
   /* TODO: should identify the error code from internal function execution */
@@ -109,6 +139,12 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
                                                 openfpga_ctx.arch().config_protocol,
                                                 cmd_context.option_value(cmd, opt_file),
                                                 cmd_context.option_enable(cmd, opt_verbose));
+  } else if (std::string("binary") == file_format) {
+    status = write_fabric_bitstream_to_binary_file(openfpga_ctx.bitstream_manager(),
+                                                   openfpga_ctx.fabric_bitstream(),
+                                                   openfpga_ctx.arch().config_protocol,
+                                                   cmd_context.option_value(cmd, opt_file),
+                                                   cmd_context.option_enable(cmd, opt_verbose));
   } else {
     /* By default, output in plain text format */
     status = write_fabric_bitstream_to_text_file(openfpga_ctx.bitstream_manager(),
@@ -21,6 +21,12 @@ ShellCommandId add_openfpga_repack_command(openfpga::Shell<OpenfpgaContext>& she
                                            const ShellCommandClassId& cmd_class_id,
                                            const std::vector<ShellCommandId>& dependent_cmds) {
   Command shell_cmd("repack");
+
+  /* Add an option '--jobs' */
+  CommandOptionId opt_jobs = shell_cmd.add_option("jobs", false, "Specify the number of threads to repack clustered blocks");
+  shell_cmd.set_option_short_name(opt_jobs, "j");
+  shell_cmd.set_option_require_value(opt_jobs, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -54,6 +60,9 @@ ShellCommandId add_openfpga_build_arch_bitstream_command(openfpga::Shell<Openfpg
   CommandOptionId opt_read_file = shell_cmd.add_option("read_file", false, "file path to read the bitstream database");
   shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
 
+  /* Add an option '--format'*/
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of the bitstream database to read and write [xml|binary]. Default: xml");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
@@ -111,7 +120,7 @@ ShellCommandId add_openfpga_write_fabric_bitstream_command(openfpga::Shell<Openf
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
   /* Add an option '--file_format'*/
-  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml]. Default: plain_text");
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml|binary]. Default: plain_text");
   shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
   /* Add an option '--verbose' */
@@ -120,7 +129,7 @@ ShellCommandId add_openfpga_write_fabric_bitstream_command(openfpga::Shell<Openf
   /* Add command 'fabric_bitstream' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the fabric-dependent bitstream to a file");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_execute_function(shell_cmd_id, write_fabric_bitstream);
+  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_bitstream);
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
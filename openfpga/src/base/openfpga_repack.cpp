@@ -8,6 +8,7 @@
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "openfpga_parallel_utils.h"
 #include "build_physical_truth_table.h"
 #include "repack.h"
 #include "openfpga_repack.h"
@@ -26,12 +27,23 @@ int repack(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
-  pack_physical_pbs(g_vpr_ctx.device(),
-                    g_vpr_ctx.atom(),
-                    g_vpr_ctx.clustering(),
-                    openfpga_ctx.mutable_vpr_device_annotation(),
-                    openfpga_ctx.mutable_vpr_clustering_annotation(),
-                    cmd_context.option_enable(cmd, opt_verbose));
+  /* Repack clustered blocks serially by default */
+  size_t num_jobs = 1;
+  int status = read_num_jobs_option(cmd, cmd_context, std::string("repacking"), num_jobs);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  status = pack_physical_pbs(g_vpr_ctx.device(),
+                             g_vpr_ctx.atom(),
+                             g_vpr_ctx.clustering(),
+                             openfpga_ctx.mutable_vpr_device_annotation(),
+                             openfpga_ctx.mutable_vpr_clustering_annotation(),
+                             num_jobs,
+                             cmd_context.option_enable(cmd, opt_verbose));
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
 
   build_physical_lut_truth_tables(openfpga_ctx.mutable_vpr_clustering_annotation(),
                                   g_vpr_ctx.atom(),
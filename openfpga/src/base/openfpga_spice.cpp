@@ -8,6 +8,7 @@
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "openfpga_parallel_utils.h"
 #include "spice_api.h"
 #include "openfpga_spice.h"
 
@@ -35,8 +36,15 @@ int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+
+  /* Write netlists serially by default */
+  size_t num_jobs = 1;
+  int status = read_num_jobs_option(cmd, cmd_context, std::string("writing SPICE netlists"), num_jobs);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+  options.set_num_jobs(num_jobs);
   
-  int status = CMD_EXEC_SUCCESS;
   status = fpga_fabric_spice(openfpga_ctx.module_graph(),
                              openfpga_ctx.mutable_spice_netlists(),
                              openfpga_ctx.arch(),
@@ -8,6 +8,7 @@
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "openfpga_parallel_utils.h"
 #include "verilog_api.h"
 #include "openfpga_verilog.h"
 
@@ -43,6 +44,14 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   options.set_print_user_defined_template(cmd_context.option_enable(cmd, opt_print_user_defined_template));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+
+  /* Write netlists serially by default */
+  size_t num_jobs = 1;
+  int status = read_num_jobs_option(cmd, cmd_context, std::string("writing Verilog netlists"), num_jobs);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+  options.set_num_jobs(num_jobs);
   
   fpga_fabric_verilog(openfpga_ctx.mutable_module_graph(),
                       openfpga_ctx.mutable_verilog_netlists(),
@@ -61,7 +70,7 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
 /********************************************************************
  * A wrapper function to call the Verilog testbench generator of FPGA-Verilog 
  *******************************************************************/
-int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
+int write_verilog_testbench(const OpenfpgaContext& openfpga_ctx,
                             const Command& cmd, const CommandContext& cmd_context) {
 
   CommandOptionId opt_output_dir = cmd.option("file");
@@ -69,6 +78,7 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_reference_benchmark = cmd.option("reference_benchmark_file_path");
   CommandOptionId opt_print_top_testbench = cmd.option("print_top_testbench");
   CommandOptionId opt_fast_configuration = cmd.option("fast_configuration");
+  CommandOptionId opt_use_bitstream_memory_file = cmd.option("use_bitstream_memory_file");
   CommandOptionId opt_print_formal_verification_top_netlist = cmd.option("print_formal_verification_top_netlist");
   CommandOptionId opt_print_preconfig_top_testbench = cmd.option("print_preconfig_top_testbench");
   CommandOptionId opt_print_simulation_ini = cmd.option("print_simulation_ini");
@@ -85,6 +95,7 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   options.set_print_formal_verification_top_netlist(cmd_context.option_enable(cmd, opt_print_formal_verification_top_netlist));
   options.set_print_preconfig_top_testbench(cmd_context.option_enable(cmd, opt_print_preconfig_top_testbench));
   options.set_fast_configuration(cmd_context.option_enable(cmd, opt_fast_configuration));
+  options.set_use_bitstream_memory_file(cmd_context.option_enable(cmd, opt_use_bitstream_memory_file));
   options.set_print_top_testbench(cmd_context.option_enable(cmd, opt_print_top_testbench));
   options.set_print_simulation_ini(cmd_context.option_value(cmd, opt_print_simulation_ini));
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
@@ -42,6 +42,11 @@ ShellCommandId add_openfpga_write_fabric_verilog_command(openfpga::Shell<Openfpg
   /* Add an option '--print_user_defined_template' */
   shell_cmd.add_option("print_user_defined_template", false, "Generate a template Verilog files for user-defined circuit models");
 
+  /* Add an option '--jobs' */
+  CommandOptionId opt_jobs = shell_cmd.add_option("jobs", false, "Specify the number of threads to write Verilog netlists of routing modules");
+  shell_cmd.set_option_short_name(opt_jobs, "j");
+  shell_cmd.set_option_require_value(opt_jobs, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -86,6 +91,9 @@ ShellCommandId add_openfpga_write_verilog_testbench_command(openfpga::Shell<Open
   /* Add an option '--fast_configuration' */
   shell_cmd.add_option("fast_configuration", false, "Reduce the period of configuration by skip zero data points");
 
+  /* Add an option '--use_bitstream_memory_file' */
+  shell_cmd.add_option("use_bitstream_memory_file", false, "Load the bitstream in the full testbench and the formal verification top netlist from a memory file with $readmemb rather than per-bit statements");
+
   /* Add an option '--print_formal_verification_top_netlist' */
   shell_cmd.add_option("print_formal_verification_top_netlist", false, "Generate a top-level module which can be used in formal verification");
 
@@ -105,7 +113,7 @@ ShellCommandId add_openfpga_write_verilog_testbench_command(openfpga::Shell<Open
   /* Add command to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "generate Verilog testbenches for full FPGA fabric");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_execute_function(shell_cmd_id, write_verilog_testbench);
+  shell.set_command_const_execute_function(shell_cmd_id, write_verilog_testbench);
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
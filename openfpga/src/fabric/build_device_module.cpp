@@ -138,6 +138,14 @@ int build_device_module_graph(ModuleManager& module_manager,
    */
   rename_primitive_module_port_names(module_manager, openfpga_ctx.arch().circuit_lib);
 
+  /* The connections of the modules are complete. 
+   * Compact the nets so that the writers can walk through them efficiently
+   */
+  {
+    vtr::ScopedStartFinishTimer freeze_timer("Compact nets of module graph");
+    module_manager.freeze_module_nets();
+  }
+
   return status;
 }
 
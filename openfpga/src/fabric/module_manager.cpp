@@ -69,7 +69,7 @@ std::vector<size_t> ModuleManager::child_module_instances(const ModuleId& parent
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::configurable_children(const ModuleId& parent_module) const {
+const std::vector<ModuleId>& ModuleManager::configurable_children(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
@@ -77,7 +77,7 @@ std::vector<ModuleId> ModuleManager::configurable_children(const ModuleId& paren
 }
 
 /* Find all the instances of configurable child modules under a parent module */
-std::vector<size_t> ModuleManager::configurable_child_instances(const ModuleId& parent_module) const {
+const std::vector<size_t>& ModuleManager::configurable_child_instances(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
@@ -88,6 +88,10 @@ std::vector<size_t> ModuleManager::configurable_child_instances(const ModuleId&
 ModuleManager::module_net_src_range ModuleManager::module_net_sources(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  if (true == nets_frozen_[module]) {
+    size_t num_srcs = frozen_net_src_offsets_[module][size_t(net) + 1] - frozen_net_src_offsets_[module][size_t(net)];
+    return vtr::make_range(frozen_net_src_ids_.begin(), frozen_net_src_ids_.begin() + num_srcs);
+  }
   return vtr::make_range(net_src_ids_[module][net].begin(), net_src_ids_[module][net].end());
 }
 
@@ -95,6 +99,10 @@ ModuleManager::module_net_src_range ModuleManager::module_net_sources(const Modu
 ModuleManager::module_net_sink_range ModuleManager::module_net_sinks(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  if (true == nets_frozen_[module]) {
+    size_t num_sinks = frozen_net_sink_offsets_[module][size_t(net) + 1] - frozen_net_sink_offsets_[module][size_t(net)];
+    return vtr::make_range(frozen_net_sink_ids_.begin(), frozen_net_sink_ids_.begin() + num_sinks);
+  }
   return vtr::make_range(net_sink_ids_[module][net].begin(), net_sink_ids_[module][net].end());
 }
 
@@ -135,6 +143,15 @@ std::vector<size_t> ModuleManager::region_configurable_child_instances(const Mod
   return region_config_child_instances;
 }
 
+const std::vector<size_t>& ModuleManager::region_configurable_child_indices(const ModuleId& parent_module,
+                                                                            const ConfigRegionId& region) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(parent_module));
+  VTR_ASSERT(valid_region_id(parent_module, region));
+
+  return config_region_children_[parent_module][region];
+}
+
 /******************************************************************************
  * Public Accessors
  ******************************************************************************/
@@ -150,6 +167,12 @@ size_t ModuleManager::num_nets(const ModuleId& module) const {
   return num_nets_[module];
 }
 
+bool ModuleManager::module_nets_frozen(const ModuleId& module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(module));
+  return nets_frozen_[module];
+}
+
 /* Find the name of a module */
 std::string ModuleManager::module_name(const ModuleId& module_id) const {
   /* Validate the module_id */
@@ -331,7 +354,22 @@ ModuleNetId ModuleManager::module_instance_port_net(const ModuleId& parent_modul
   /* Validate child_pin */
   VTR_ASSERT(child_pin < module_port(child_module, child_port).get_width());
   
-  return net_lookup_[parent_module][child_module][child_instance][child_port][child_pin];
+  if (true == nets_frozen_[parent_module]) {
+    size_t instance_pin_offset = 0;
+    if (child_module != parent_module) {
+      /* Children added after freezing are not connected to any net */
+      size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+      if ( (child_index >= frozen_instance_pin_offsets_[parent_module].size())
+        || (child_instance >= frozen_instance_pin_offsets_[parent_module][child_index].size()) ) {
+        return ModuleNetId::INVALID();
+      }
+      instance_pin_offset = frozen_instance_pin_offsets_[parent_module][child_index][child_instance];
+    }
+    return frozen_pin_nets_[parent_module][instance_pin_offset + frozen_port_pin_offsets_[child_module][child_port] + child_pin];
+  }
+
+  /* Use at() for the maps, so that the look-up never inserts and is safe for concurrent readers */
+  return net_lookup_[parent_module].at(child_module)[child_instance].at(child_port)[child_pin];
 }
 
 /* Find the name of net */
@@ -348,6 +386,13 @@ vtr::vector<ModuleNetSrcId, ModuleId> ModuleManager::net_source_modules(const Mo
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModuleId> src_modules;
+  if (true == nets_frozen_[module]) {
+    for (size_t i = frozen_net_src_offsets_[module][size_t(net)]; i < frozen_net_src_offsets_[module][size_t(net) + 1]; ++i) {
+      src_modules.push_back(net_terminal_storage_[frozen_net_srcs_[module][i].terminal_id].first);
+    }
+    return src_modules;
+  }
+
   src_modules.reserve(net_src_terminal_ids_[module][net].size());
   for (const size_t& id : net_src_terminal_ids_[module][net]) {
     src_modules.push_back(net_terminal_storage_[id].first);
@@ -361,6 +406,14 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_instances(const Mo
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  if (true == nets_frozen_[module]) {
+    vtr::vector<ModuleNetSrcId, size_t> src_instances;
+    for (size_t i = frozen_net_src_offsets_[module][size_t(net)]; i < frozen_net_src_offsets_[module][size_t(net) + 1]; ++i) {
+      src_instances.push_back(frozen_net_srcs_[module][i].instance);
+    }
+    return src_instances;
+  }
+
   return net_src_instance_ids_[module][net];
 }
 
@@ -370,6 +423,13 @@ vtr::vector<ModuleNetSrcId, ModulePortId> ModuleManager::net_source_ports(const
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModulePortId> src_ports;
+  if (true == nets_frozen_[module]) {
+    for (size_t i = frozen_net_src_offsets_[module][size_t(net)]; i < frozen_net_src_offsets_[module][size_t(net) + 1]; ++i) {
+      src_ports.push_back(net_terminal_storage_[frozen_net_srcs_[module][i].terminal_id].second);
+    }
+    return src_ports;
+  }
+
   src_ports.reserve(net_src_terminal_ids_[module][net].size());
   for (const size_t& id : net_src_terminal_ids_[module][net]) {
     src_ports.push_back(net_terminal_storage_[id].second);
@@ -383,6 +443,14 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_pins(const ModuleI
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  if (true == nets_frozen_[module]) {
+    vtr::vector<ModuleNetSrcId, size_t> src_pins;
+    for (size_t i = frozen_net_src_offsets_[module][size_t(net)]; i < frozen_net_src_offsets_[module][size_t(net) + 1]; ++i) {
+      src_pins.push_back(frozen_net_srcs_[module][i].pin);
+    }
+    return src_pins;
+  }
+
   return net_src_pin_ids_[module][net];
 }
 
@@ -397,11 +465,15 @@ bool ModuleManager::net_source_exist(const ModuleId& module, const ModuleNetId&
    * If a net source has the same src_module, instance_id, src_port and src_pin,
    * we can say that the source has already been added to this net!
    */
+  vtr::vector<ModuleNetSrcId, ModuleId> src_modules = net_source_modules(module, net);
+  vtr::vector<ModuleNetSrcId, size_t> src_instances = net_source_instances(module, net);
+  vtr::vector<ModuleNetSrcId, ModulePortId> src_ports = net_source_ports(module, net);
+  vtr::vector<ModuleNetSrcId, size_t> src_pins = net_source_pins(module, net);
   for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
-    if ( (src_module == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].first) 
-      && (instance_id == net_source_instances(module, net)[net_src])   
-      && (src_port == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].second) 
-      && (src_pin == net_source_pins(module, net)[net_src]) ) {
+    if ( (src_module == src_modules[net_src]) 
+      && (instance_id == src_instances[net_src])   
+      && (src_port == src_ports[net_src]) 
+      && (src_pin == src_pins[net_src]) ) {
       return true;
     }
   }
@@ -416,6 +488,13 @@ vtr::vector<ModuleNetSinkId, ModuleId> ModuleManager::net_sink_modules(const Mod
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModuleId> sink_modules;
+  if (true == nets_frozen_[module]) {
+    for (size_t i = frozen_net_sink_offsets_[module][size_t(net)]; i < frozen_net_sink_offsets_[module][size_t(net) + 1]; ++i) {
+      sink_modules.push_back(net_terminal_storage_[frozen_net_sinks_[module][i].terminal_id].first);
+    }
+    return sink_modules;
+  }
+
   sink_modules.reserve(net_sink_terminal_ids_[module][net].size());
   for (const size_t& id : net_sink_terminal_ids_[module][net]) {
     sink_modules.push_back(net_terminal_storage_[id].first);
@@ -429,6 +508,14 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_instances(const Mod
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  if (true == nets_frozen_[module]) {
+    vtr::vector<ModuleNetSinkId, size_t> sink_instances;
+    for (size_t i = frozen_net_sink_offsets_[module][size_t(net)]; i < frozen_net_sink_offsets_[module][size_t(net) + 1]; ++i) {
+      sink_instances.push_back(frozen_net_sinks_[module][i].instance);
+    }
+    return sink_instances;
+  }
+
   return net_sink_instance_ids_[module][net];
 }
 
@@ -438,6 +525,13 @@ vtr::vector<ModuleNetSinkId, ModulePortId> ModuleManager::net_sink_ports(const M
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports;
+  if (true == nets_frozen_[module]) {
+    for (size_t i = frozen_net_sink_offsets_[module][size_t(net)]; i < frozen_net_sink_offsets_[module][size_t(net) + 1]; ++i) {
+      sink_ports.push_back(net_terminal_storage_[frozen_net_sinks_[module][i].terminal_id].second);
+    }
+    return sink_ports;
+  }
+
   sink_ports.reserve(net_sink_terminal_ids_[module][net].size());
   for (const size_t& id : net_sink_terminal_ids_[module][net]) {
     sink_ports.push_back(net_terminal_storage_[id].second);
@@ -451,6 +545,14 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_pins(const ModuleId
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  if (true == nets_frozen_[module]) {
+    vtr::vector<ModuleNetSinkId, size_t> sink_pins;
+    for (size_t i = frozen_net_sink_offsets_[module][size_t(net)]; i < frozen_net_sink_offsets_[module][size_t(net) + 1]; ++i) {
+      sink_pins.push_back(frozen_net_sinks_[module][i].pin);
+    }
+    return sink_pins;
+  }
+
   return net_sink_pin_ids_[module][net];
 }
 
@@ -465,11 +567,15 @@ bool ModuleManager::net_sink_exist(const ModuleId& module, const ModuleNetId& ne
    * If a net sink has the same sink_module, instance_id, sink_port and sink_pin,
    * we can say that the sink has already been added to this net!
    */
+  vtr::vector<ModuleNetSinkId, ModuleId> sink_modules = net_sink_modules(module, net);
+  vtr::vector<ModuleNetSinkId, size_t> sink_instances = net_sink_instances(module, net);
+  vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports = net_sink_ports(module, net);
+  vtr::vector<ModuleNetSinkId, size_t> sink_pins = net_sink_pins(module, net);
   for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
-    if ( (sink_module == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].first) 
-      && (instance_id == net_sink_instances(module, net)[net_sink])   
-      && (sink_port == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].second) 
-      && (sink_pin == net_sink_pins(module, net)[net_sink]) ) {
+    if ( (sink_module == sink_modules[net_sink]) 
+      && (instance_id == sink_instances[net_sink])   
+      && (sink_port == sink_ports[net_sink]) 
+      && (sink_pin == sink_pins[net_sink]) ) {
       return true;
     }
   }
@@ -486,16 +592,28 @@ size_t ModuleManager::find_child_module_index_in_parent_module(const ModuleId& p
   VTR_ASSERT(valid_module_id(parent_module));
   VTR_ASSERT(valid_module_id(child_module));
   /* Try to find the child_module in the children list of parent_module*/
-  for (size_t i = 0; i < children_[parent_module].size(); ++i) {
-    if (child_module == children_[parent_module][i]) {
-      /* Found, return the number of instances */
-      return i; 
-    }
+  std::unordered_map<ModuleId, size_t>::const_iterator it = child_indices_[parent_module].find(child_module);
+  if (it != child_indices_[parent_module].end()) {
+    /* Found, return the index */
+    return it->second;
   }
   /* Not found: return an valid value */
   return size_t(-1);
 }
 
+size_t ModuleManager::find_or_add_net_terminal(const ModuleId& module, const ModulePortId& port) {
+  /* Search in the storage. If found, use the existing pair
+   * Otherwise, add the pair
+   */
+  std::pair<ModuleId, ModulePortId> terminal(module, port);
+  auto result = net_terminal_lookup_.emplace(terminal, net_terminal_storage_.size());
+  if (true == result.second) {
+    net_terminal_storage_.push_back(terminal);
+  }
+  VTR_ASSERT_SAFE(terminal == net_terminal_storage_[result.first->second]);
+  return result.first->second;
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -518,6 +636,7 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   children_.emplace_back();
   num_child_instances_.emplace_back();
   child_instance_names_.emplace_back();
+  child_indices_.emplace_back();
   configurable_children_.emplace_back();
   configurable_child_instances_.emplace_back();
   configurable_child_regions_.emplace_back();
@@ -545,6 +664,16 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   net_sink_instance_ids_.emplace_back();
   net_sink_pin_ids_.emplace_back();
 
+  nets_frozen_.push_back(false);
+  frozen_net_src_offsets_.emplace_back();
+  frozen_net_srcs_.emplace_back();
+  frozen_net_sink_offsets_.emplace_back();
+  frozen_net_sinks_.emplace_back();
+  frozen_pin_nets_.emplace_back();
+  frozen_instance_pin_offsets_.emplace_back();
+  frozen_port_pin_offsets_.emplace_back();
+  frozen_num_pins_.push_back(0);
+
   /* Register in the name-to-id map */
   name_id_map_[name] = module;
 
@@ -566,6 +695,8 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
                                      const BasicPort& port_info, const enum e_module_port_type& port_type) {
   /* Validate the id of module */
   VTR_ASSERT( valid_module_id(module) );
+  /* The pin look-up of frozen modules cannot accept any new port */
+  VTR_ASSERT( false == nets_frozen_[module] );
 
   /* Add port and fill port attributes */
   ModulePortId port = ModulePortId(port_ids_[module].size());
@@ -646,9 +777,10 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
     parents_[child_module].push_back(parent_module);
   }
 
-  std::vector<ModuleId>::iterator child_it = std::find(children_[parent_module].begin(), children_[parent_module].end(), child_module);
-  if (child_it == children_[parent_module].end()) {
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  if (size_t(-1) == child_index) {
     /* Update the child module of parent module */
+    child_indices_[parent_module][child_module] = children_[parent_module].size();
     children_[parent_module].push_back(child_module);
     num_child_instances_[parent_module].push_back(1); /* By default give one */
     /* Update the instance name list */
@@ -656,8 +788,13 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
     child_instance_names_[parent_module].back().emplace_back();
   } else {
     /* Increase the counter of instances */
-    num_child_instances_[parent_module][child_it - children_[parent_module].begin()]++;
-    child_instance_names_[parent_module][child_it - children_[parent_module].begin()].emplace_back();
+    num_child_instances_[parent_module][child_index]++;
+    child_instance_names_[parent_module][child_index].emplace_back();
+  }
+
+  /* Instances added to a frozen module are not connected to any net, no need to update the look-up */
+  if (true == nets_frozen_[parent_module]) {
+    return;
   }
 
   /* Update fast look-up for nets */
@@ -768,6 +905,7 @@ void ModuleManager::reserve_module_nets(const ModuleId& module,
                                         const size_t& num_nets) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
+  VTR_ASSERT ( false == nets_frozen_[module] );
 
   net_names_[module].reserve(num_nets);
   net_src_ids_[module].reserve(num_nets);
@@ -785,6 +923,7 @@ void ModuleManager::reserve_module_nets(const ModuleId& module,
 ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
+  VTR_ASSERT ( false == nets_frozen_[module] );
 
   /* Create an new id */
   ModuleNetId net = ModuleNetId(num_nets_[module]);
@@ -824,6 +963,7 @@ void ModuleManager::reserve_module_net_sources(const ModuleId& module, const Mod
                                                const size_t& num_sources) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(false == nets_frozen_[module]);
 
   net_src_ids_[module][net].reserve(num_sources);
   net_src_terminal_ids_[module][net].reserve(num_sources);
@@ -837,6 +977,7 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
                                                     const ModulePortId& src_port, const size_t& src_pin) {
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(false == nets_frozen_[module]);
 
   /* Create a new id for src node */
   ModuleNetSrcId net_src = ModuleNetSrcId(net_src_ids_[module][net].size());
@@ -848,21 +989,8 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
   /* Validate the port exists in the src module */
   VTR_ASSERT(valid_module_port_id(src_module, src_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_src_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
+  /* Create pair of module and port, which is shared by all the nets */
+  net_src_terminal_ids_[module][net].push_back(find_or_add_net_terminal(src_module, src_port));
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
@@ -889,6 +1017,7 @@ void ModuleManager::reserve_module_net_sinks(const ModuleId& module, const Modul
                                              const size_t& num_sinks) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(false == nets_frozen_[module]);
 
   net_sink_ids_[module][net].reserve(num_sinks);
   net_sink_terminal_ids_[module][net].reserve(num_sinks);
@@ -902,6 +1031,7 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
                                                    const ModulePortId& sink_port, const size_t& sink_pin) {
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(false == nets_frozen_[module]);
 
   /* Create a new id for sink node */
   ModuleNetSinkId net_sink = ModuleNetSinkId(net_sink_ids_[module][net].size());
@@ -913,21 +1043,8 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   /* Validate the port exists in the sink module */
   VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_sink_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
+  /* Create pair of module and port, which is shared by all the nets */
+  net_sink_terminal_ids_[module][net].push_back(find_or_add_net_terminal(sink_module, sink_port));
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
@@ -950,6 +1067,126 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   return net_sink;
 }
 
+/******************************************************************************
+ * Compact the nets of all the modules which are not frozen yet
+ * 1. Assign each pin of each module an offset, so that all the pins of
+ *    an instance can be indexed in a continuous range
+ * 2. Concatenate the sources (and sinks) of all the nets of a module
+ *    into a list, where each net owns a range
+ * 3. Convert the net look-up of each module into a flat list
+ *    with an entry for each pin of the module and its child instances
+ * 4. Release the storage used during construction
+ ******************************************************************************/
+void ModuleManager::freeze_module_nets() {
+  /* Pin offsets of each port */
+  for (const ModuleId& module : modules()) {
+    if (true == nets_frozen_[module]) {
+      continue;
+    }
+    frozen_port_pin_offsets_[module].clear();
+    frozen_port_pin_offsets_[module].reserve(port_ids_[module].size());
+    size_t num_pins = 0;
+    for (const ModulePortId& port : port_ids_[module]) {
+      frozen_port_pin_offsets_[module].push_back(num_pins);
+      num_pins += ports_[module][port].get_width();
+    }
+    frozen_num_pins_[module] = num_pins;
+  }
+
+  for (const ModuleId& module : modules()) {
+    if (true == nets_frozen_[module]) {
+      continue;
+    }
+
+    /* Nets: sources and sinks */
+    size_t num_srcs = 0;
+    size_t num_sinks = 0;
+    for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+      num_srcs += net_src_ids_[module][ModuleNetId(inet)].size();
+      num_sinks += net_sink_ids_[module][ModuleNetId(inet)].size();
+    }
+    frozen_net_src_offsets_[module].reserve(num_nets_[module] + 1);
+    frozen_net_srcs_[module].reserve(num_srcs);
+    frozen_net_sink_offsets_[module].reserve(num_nets_[module] + 1);
+    frozen_net_sinks_[module].reserve(num_sinks);
+    for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+      ModuleNetId net(inet);
+      frozen_net_src_offsets_[module].push_back(frozen_net_srcs_[module].size());
+      for (const ModuleNetSrcId& net_src : net_src_ids_[module][net]) {
+        frozen_net_srcs_[module].push_back({net_src_terminal_ids_[module][net][net_src],
+                                            net_src_instance_ids_[module][net][net_src],
+                                            net_src_pin_ids_[module][net][net_src]});
+      }
+      while (frozen_net_src_ids_.size() < net_src_ids_[module][net].size()) {
+        frozen_net_src_ids_.push_back(ModuleNetSrcId(frozen_net_src_ids_.size()));
+      }
+
+      frozen_net_sink_offsets_[module].push_back(frozen_net_sinks_[module].size());
+      for (const ModuleNetSinkId& net_sink : net_sink_ids_[module][net]) {
+        frozen_net_sinks_[module].push_back({net_sink_terminal_ids_[module][net][net_sink],
+                                             net_sink_instance_ids_[module][net][net_sink],
+                                             net_sink_pin_ids_[module][net][net_sink]});
+      }
+      while (frozen_net_sink_ids_.size() < net_sink_ids_[module][net].size()) {
+        frozen_net_sink_ids_.push_back(ModuleNetSinkId(frozen_net_sink_ids_.size()));
+      }
+    }
+    frozen_net_src_offsets_[module].push_back(frozen_net_srcs_[module].size());
+    frozen_net_sink_offsets_[module].push_back(frozen_net_sinks_[module].size());
+
+    /* Pin look-up: the module itself first and then each child instance */
+    size_t num_pins = frozen_num_pins_[module];
+    frozen_instance_pin_offsets_[module].resize(children_[module].size());
+    for (size_t child_index = 0; child_index < children_[module].size(); ++child_index) {
+      const ModuleId& child = children_[module][child_index];
+      frozen_instance_pin_offsets_[module][child_index].reserve(num_child_instances_[module][child_index]);
+      for (size_t inst = 0; inst < num_child_instances_[module][child_index]; ++inst) {
+        frozen_instance_pin_offsets_[module][child_index].push_back(num_pins);
+        num_pins += frozen_num_pins_[child];
+      }
+    }
+    frozen_pin_nets_[module].resize(num_pins, ModuleNetId::INVALID());
+    for (const auto& child_lookup : net_lookup_[module]) {
+      const ModuleId& child = child_lookup.first;
+      size_t child_index = find_child_module_index_in_parent_module(module, child);
+      for (size_t inst = 0; inst < child_lookup.second.size(); ++inst) {
+        size_t instance_pin_offset = 0;
+        if (child != module) {
+          VTR_ASSERT(child_index < children_[module].size());
+          instance_pin_offset = frozen_instance_pin_offsets_[module][child_index][inst];
+        }
+        for (const auto& port_lookup : child_lookup.second[inst]) {
+          size_t port_pin_offset = instance_pin_offset + frozen_port_pin_offsets_[child][port_lookup.first];
+          for (size_t pin = 0; pin < port_lookup.second.size(); ++pin) {
+            frozen_pin_nets_[module][port_pin_offset + pin] = port_lookup.second[pin];
+          }
+        }
+      }
+    }
+
+    /* Release the storage used during construction */
+    net_src_ids_[module].clear();
+    net_src_ids_[module].shrink_to_fit();
+    net_src_terminal_ids_[module].clear();
+    net_src_terminal_ids_[module].shrink_to_fit();
+    net_src_instance_ids_[module].clear();
+    net_src_instance_ids_[module].shrink_to_fit();
+    net_src_pin_ids_[module].clear();
+    net_src_pin_ids_[module].shrink_to_fit();
+    net_sink_ids_[module].clear();
+    net_sink_ids_[module].shrink_to_fit();
+    net_sink_terminal_ids_[module].clear();
+    net_sink_terminal_ids_[module].shrink_to_fit();
+    net_sink_instance_ids_[module].clear();
+    net_sink_instance_ids_[module].shrink_to_fit();
+    net_sink_pin_ids_[module].clear();
+    net_sink_pin_ids_[module].shrink_to_fit();
+    net_lookup_[module].clear();
+
+    nets_frozen_[module] = true;
+  }
+}
+
 /******************************************************************************
  * Public Deconstructor
  ******************************************************************************/
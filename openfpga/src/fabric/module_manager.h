@@ -8,6 +8,7 @@
 #include <unordered_map>
 
 #include "vtr_vector.h"
+#include "vtr_hash.h"
 #include "module_manager_fwd.h"
 #include "openfpga_port.h"
 
@@ -145,9 +146,9 @@ class ModuleManager {
     /* Find all the instances under a parent module */
     std::vector<size_t> child_module_instances(const ModuleId& parent_module, const ModuleId& child_module) const;
     /* Find all the configurable child modules under a parent module */
-    std::vector<ModuleId> configurable_children(const ModuleId& parent_module) const;
+    const std::vector<ModuleId>& configurable_children(const ModuleId& parent_module) const;
     /* Find all the instances of configurable child modules under a parent module */
-    std::vector<size_t> configurable_child_instances(const ModuleId& parent_module) const;
+    const std::vector<size_t>& configurable_child_instances(const ModuleId& parent_module) const;
     /* Find the source ids of modules */
     module_net_src_range module_net_sources(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the sink ids of modules */
@@ -161,10 +162,17 @@ class ModuleManager {
     /* Find all the instances of configurable child modules under a region of a parent module */
     std::vector<size_t> region_configurable_child_instances(const ModuleId& parent_module,
                                                             const ConfigRegionId& region) const;
+    /* Find the indices of configurable children under a region of a parent module,
+     * which are the indices in the list of configurable_children()
+     */
+    const std::vector<size_t>& region_configurable_child_indices(const ModuleId& parent_module,
+                                                                 const ConfigRegionId& region) const;
     
   public: /* Public accessors */
     size_t num_modules() const;
     size_t num_nets(const ModuleId& module) const;
+    /* Find if the nets of a module have been frozen (see freeze_module_nets()) */
+    bool module_nets_frozen(const ModuleId& module) const;
     std::string module_name(const ModuleId& module_id) const;
     e_module_usage_type module_usage(const ModuleId& module_id) const;
     std::string module_port_type_str(const enum e_module_port_type& port_type) const;
@@ -224,6 +232,8 @@ class ModuleManager {
 
   private: /* Private accessors */
     size_t find_child_module_index_in_parent_module(const ModuleId& parent_module, const ModuleId& child_module) const;
+    /* Find the index of a pair of module and port in the net terminal storage, the pair is added if not found */
+    size_t find_or_add_net_terminal(const ModuleId& module, const ModulePortId& port);
   public: /* Public mutators */
     /* Add a module */
     ModuleId add_module(const std::string& name);
@@ -298,6 +308,14 @@ class ModuleManager {
     ModuleNetSinkId add_module_net_sink(const ModuleId& module, const ModuleNetId& net,
                                         const ModuleId& sink_module, const size_t& instance_id,
                                         const ModulePortId& sink_port, const size_t& sink_pin);
+
+    /* Compact the nets of all the modules which are not frozen yet into flat arrays,
+     * which are much smaller and faster to walk through than the storage used during construction.
+     * After freezing, the ports and nets of the modules can no longer be modified.
+     * Child modules can still be added, but their instances are not connected to any net.
+     * Modules added after freezing can be modified as usual until the next call
+     */
+    void freeze_module_nets();
   public: /* Public deconstructors */
     /* This is a strong function which will remove all the configurable children 
      * under a given parent module
@@ -334,6 +352,7 @@ class ModuleManager {
     vtr::vector<ModuleId, std::vector<ModuleId>> children_;                /* Child modules that this module contain */
     vtr::vector<ModuleId, std::vector<size_t>> num_child_instances_;          /* Number of children instance in each child module */
     vtr::vector<ModuleId, std::vector<std::vector<std::string>>> child_instance_names_;          /* Number of children instance in each child module */
+    vtr::vector<ModuleId, std::unordered_map<ModuleId, size_t>> child_indices_;          /* Fast look-up on the index of a child module in the children_ list */
 
     /* Configurable child modules are used to record the position of configurable modules in bitstream
      * The sequence of children in the list denotes which one is configured first, etc. 
@@ -394,6 +413,45 @@ class ModuleManager {
      * (either source or sink)
      */
     std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+
+    /* Compact storage of nets built by freeze_module_nets()
+     * The sources of a net <net> are stored in a continuous range of the list
+     *   frozen_net_srcs_[module][frozen_net_src_offsets_[module][net] : frozen_net_src_offsets_[module][net + 1]]
+     * Sinks are stored in the same way
+     */
+    struct t_frozen_net_terminal {
+      size_t terminal_id; /* Index in the net_terminal_storage_ */
+      size_t instance;
+      size_t pin;
+    };
+    vtr::vector<ModuleId, bool> nets_frozen_;
+    vtr::vector<ModuleId, std::vector<size_t>> frozen_net_src_offsets_;
+    vtr::vector<ModuleId, std::vector<t_frozen_net_terminal>> frozen_net_srcs_;
+    vtr::vector<ModuleId, std::vector<size_t>> frozen_net_sink_offsets_;
+    vtr::vector<ModuleId, std::vector<t_frozen_net_terminal>> frozen_net_sinks_;
+    /* Ids shared by the source/sink ranges of all the frozen nets */
+    vtr::vector<ModuleNetSrcId, ModuleNetSrcId> frozen_net_src_ids_;
+    vtr::vector<ModuleNetSinkId, ModuleNetSinkId> frozen_net_sink_ids_;
+
+    /* Flat look-up from pins to nets for frozen modules, which replaces the net_lookup_
+     * The pins of the module itself come first, followed by the pins of each child instance:
+     *   frozen_pin_nets_[module][frozen_instance_pin_offsets_[module][child_index][instance] + frozen_port_pin_offsets_[child][port] + pin]
+     */
+    vtr::vector<ModuleId, std::vector<ModuleNetId>> frozen_pin_nets_;
+    vtr::vector<ModuleId, std::vector<std::vector<size_t>>> frozen_instance_pin_offsets_;
+    vtr::vector<ModuleId, vtr::vector<ModulePortId, size_t>> frozen_port_pin_offsets_;
+    vtr::vector<ModuleId, size_t> frozen_num_pins_;
+
+    /* Fast look-up on the index of a pair of a module and a port in the net_terminal_storage_ */
+    struct t_net_terminal_hash {
+      std::size_t operator()(const std::pair<ModuleId, ModulePortId>& terminal) const {
+        std::size_t seed = 0;
+        vtr::hash_combine(seed, terminal.first);
+        vtr::hash_combine(seed, terminal.second);
+        return seed;
+      }
+    };
+    std::unordered_map<std::pair<ModuleId, ModulePortId>, size_t, t_net_terminal_hash> net_terminal_lookup_;
 };
 
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
  * and Look-Up Tables (LUTs) which locate in CLBs and global routing architecture
  *******************************************************************/
 #include <vector>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -14,6 +15,7 @@
 #include "openfpga_naming.h"
 
 #include "module_manager_utils.h"
+#include "bitstream_manager_utils.h"
 
 #include "build_grid_bitstream.h"
 #include "build_routing_bitstream.h"
@@ -98,6 +100,75 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
   return num_bits;
 }
 
+/********************************************************************
+ * Link the child blocks of a block in bitstream manager to 
+ * the configurable children of its module in module manager.
+ * The name of a block is the instance name of a configurable child,
+ * so each name is resolved once here through a hash lookup.
+ * Afterwards, fabric-dependent bitstream builders can walk 
+ * the two hierarchies side by side with child indices only
+ *******************************************************************/
+static 
+void rec_annotate_device_bitstream_configurable_children(BitstreamManager& bitstream_manager,
+                                                         const ConfigBlockId& parent_block,
+                                                         const ModuleManager& module_manager,
+                                                         const ModuleId& parent_module) {
+  /* Leaf blocks contain only configuration bits */
+  if (0 == bitstream_manager.block_children(parent_block).size()) {
+    return;
+  }
+
+  std::unordered_map<std::string, ConfigBlockId> child_block_lookup;
+  child_block_lookup.reserve(bitstream_manager.block_children(parent_block).size());
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(parent_block)) {
+    child_block_lookup[bitstream_manager.block_name(child_block)] = child_block;
+  }
+
+  const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(parent_module);
+  const std::vector<size_t>& configurable_child_instances = module_manager.configurable_child_instances(parent_module);
+
+  /* Configurable children without any block, e.g., decoders, are left invalid */
+  std::vector<ConfigBlockId> configurable_child_blocks(configurable_children.size(), ConfigBlockId::INVALID());
+  for (size_t child_id = 0; child_id < configurable_children.size(); ++child_id) {
+    std::string instance_name = module_manager.instance_name(parent_module, configurable_children[child_id], configurable_child_instances[child_id]);
+    auto result = child_block_lookup.find(instance_name);
+    if (result != child_block_lookup.end()) {
+      configurable_child_blocks[child_id] = result->second;
+    }
+  }
+  bitstream_manager.set_configurable_child_blocks(parent_block, configurable_child_blocks);
+
+  for (size_t child_id = 0; child_id < configurable_children.size(); ++child_id) {
+    if (ConfigBlockId::INVALID() == configurable_child_blocks[child_id]) {
+      continue;
+    }
+    rec_annotate_device_bitstream_configurable_children(bitstream_manager,
+                                                        configurable_child_blocks[child_id],
+                                                        module_manager,
+                                                        configurable_children[child_id]);
+  }
+}
+
+/********************************************************************
+ * Link the blocks of a device bitstream to the configurable children
+ * in module manager, starting from the top-level block and module.
+ * This should be called whenever a device bitstream is built or loaded,
+ * before building the fabric-dependent bitstream
+ *******************************************************************/
+void annotate_device_bitstream_configurable_children(BitstreamManager& bitstream_manager,
+                                                     const ModuleManager& module_manager) {
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  VTR_ASSERT(top_module_name == bitstream_manager.block_name(top_blocks[0]));
+
+  rec_annotate_device_bitstream_configurable_children(bitstream_manager, top_blocks[0],
+                                                      module_manager, top_module);
+}
+
 /********************************************************************
  * A top-level function to build a bistream from the FPGA device
  * 1. It will organize the bitstream w.r.t. the hierarchy of module graphs 
@@ -186,6 +257,10 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   VTR_ASSERT(num_blocks_to_reserve == bitstream_manager.num_blocks());
   VTR_ASSERT(num_bits_to_reserve == bitstream_manager.num_bits());
 
+  /* Link blocks to module graph for building fabric-dependent bitstream */
+  rec_annotate_device_bitstream_configurable_children(bitstream_manager, top_block,
+                                                      openfpga_ctx.module_graph(), top_module);
+
   return bitstream_manager;
 }
 
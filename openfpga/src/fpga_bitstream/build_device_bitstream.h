@@ -19,6 +19,9 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
                                         const bool& verbose);
 
+void annotate_device_bitstream_configurable_children(BitstreamManager& bitstream_manager,
+                                                     const ModuleManager& module_manager);
+
 } /* end namespace openfpga */
 
 #endif
@@ -27,10 +27,9 @@ namespace openfpga {
  * This function aims to build a bitstream for configuration chain-like protocol
  * It will walk through all the configurable children under a module
  * in a recursive way, following a Depth-First Search (DFS) strategy
- * For each configuration child, we use its instance name as a key to spot the 
- * configuration bits in bitstream manager.
- * Note that it is guarentee that the instance name in module manager is 
- * consistent with the block names in bitstream manager
+ * For each configuration child, we find its block in bitstream manager
+ * by the index of the child in the configurable_children() of the module,
+ * which is linked by annotate_device_bitstream_configurable_children()
  * We use this link to reorganize the bitstream in the sequence of memories as we stored
  * in the configurable_children() and configurable_child_instances() of each module of module manager 
  *******************************************************************/
@@ -48,44 +47,32 @@ void rec_build_module_fabric_dependent_chain_bitstream(const BitstreamManager& b
    * we dive to the next level first! 
    */
   if (0 < bitstream_manager.block_children(parent_block).size()) {
+    const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(parent_module);
+    const std::vector<ConfigBlockId>& child_blocks = bitstream_manager.configurable_child_blocks(parent_block);
+    VTR_ASSERT(configurable_children.size() == child_blocks.size());
+
     if (parent_module == top_module) {
-      for (size_t child_id = 0; child_id < module_manager.region_configurable_children(parent_module, config_region).size(); ++child_id) {
-        ModuleId child_module = module_manager.region_configurable_children(parent_module, config_region)[child_id]; 
-        size_t child_instance = module_manager.region_configurable_child_instances(parent_module, config_region)[child_id]; 
-        /* Get the instance name and ensure it is not empty */
-        std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-         
-        /* Find the child block that matches the instance name! */ 
-        ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
+      for (const size_t& child_id : module_manager.region_configurable_child_indices(parent_module, config_region)) {
         /* We must have one valid block id! */
-        if (true != bitstream_manager.valid_block_id(child_block))
-        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_blocks[child_id]));
 
         /* Go recursively */
-        rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block,
+        rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_blocks[child_id],
                                                           module_manager, top_module,
-                                                          child_module,
+                                                          configurable_children[child_id],
                                                           config_region,
                                                           fabric_bitstream,
                                                           fabric_bitstream_region);
       }
     } else { 
-      for (size_t child_id = 0; child_id < module_manager.configurable_children(parent_module).size(); ++child_id) {
-        ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
-        size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
-        /* Get the instance name and ensure it is not empty */
-        std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-         
-        /* Find the child block that matches the instance name! */ 
-        ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
+      for (size_t child_id = 0; child_id < configurable_children.size(); ++child_id) {
         /* We must have one valid block id! */
-        if (true != bitstream_manager.valid_block_id(child_block))
-        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_blocks[child_id]));
 
         /* Go recursively */
-        rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block,
+        rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_blocks[child_id],
                                                           module_manager, top_module,
-                                                          child_module,
+                                                          configurable_children[child_id],
                                                           config_region,
                                                           fabric_bitstream,
                                                           fabric_bitstream_region);
@@ -109,10 +96,9 @@ void rec_build_module_fabric_dependent_chain_bitstream(const BitstreamManager& b
  * This function aims to build a bitstream for memory-bank protocol
  * It will walk through all the configurable children under a module
  * in a recursive way, following a Depth-First Search (DFS) strategy
- * For each configuration child, we use its instance name as a key to spot the 
- * configuration bits in bitstream manager.
- * Note that it is guarentee that the instance name in module manager is 
- * consistent with the block names in bitstream manager
+ * For each configuration child, we find its block in bitstream manager
+ * by the index of the child in the configurable_children() of the module,
+ * which is linked by annotate_device_bitstream_configurable_children()
  * We use this link to reorganize the bitstream in the sequence of memories as we stored
  * in the configurable_children() and configurable_child_instances() of each module of module manager 
  *
@@ -139,7 +125,9 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
    */
   if (0 < bitstream_manager.block_children(parent_block).size()) {
     /* For top module, we will skip the two decoders at the end of the configurable children list */
-    std::vector<ModuleId> configurable_children = module_manager.configurable_children(parent_module);
+    const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(parent_module);
+    const std::vector<ConfigBlockId>& child_blocks = bitstream_manager.configurable_child_blocks(parent_block);
+    VTR_ASSERT(configurable_children.size() == child_blocks.size());
 
     size_t num_configurable_children = configurable_children.size();
     if (parent_module == top_module) {
@@ -155,20 +143,12 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
     }
 
     for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-      ModuleId child_module = configurable_children[child_id]; 
-      size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
-      /* Get the instance name and ensure it is not empty */
-      std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-       
-      /* Find the child block that matches the instance name! */ 
-      ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
       /* We must have one valid block id! */
-      if (true != bitstream_manager.valid_block_id(child_block)) 
-      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_blocks[child_id]));
 
       /* Go recursively */
-      rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, child_block,
-                                                              module_manager, top_module, child_module,
+      rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, child_blocks[child_id],
+                                                              module_manager, top_module, configurable_children[child_id],
                                                               bl_addr_size, wl_addr_size,
                                                               num_bls, num_wls,
                                                               cur_mem_index,
@@ -217,10 +197,9 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
  * This function aims to build a bitstream for frame-based configuration protocol
  * It will walk through all the configurable children under a module
  * in a recursive way, following a Depth-First Search (DFS) strategy
- * For each configuration child, we use its instance name as a key to spot the 
- * configuration bits in bitstream manager.
- * Note that it is guarenteed that the instance name in module manager is 
- * consistent with the block names in bitstream manager
+ * For each configuration child, we find its block in bitstream manager
+ * by the index of the child in the configurable_children() of the module,
+ * which is linked by annotate_device_bitstream_configurable_children()
  * We use this link to reorganize the bitstream in the sequence of memories as we stored
  * in the configurable_children() and configurable_child_instances() of each module of module manager 
  *
@@ -238,9 +217,9 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
  *******************************************************************/
 static 
 void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& bitstream_manager,
-                                                       const std::vector<ConfigBlockId>& parent_blocks,
+                                                       const ConfigBlockId& parent_block,
                                                        const ModuleManager& module_manager,
-                                                       const std::vector<ModuleId>& parent_modules,
+                                                       const ModuleId& parent_module,
                                                        const std::vector<char>& addr_code,
                                                        FabricBitstream& fabric_bitstream,
                                                        FabricBitRegionId& fabric_bitstream_region) {
@@ -248,11 +227,12 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
   /* Depth-first search: if we have any children in the parent_block, 
    * we dive to the next level first! 
    */
-  if (0 < bitstream_manager.block_children(parent_blocks.back()).size()) {
-    const ConfigBlockId& parent_block = parent_blocks.back();
-    const ModuleId& parent_module = parent_modules.back();
+  if (0 < bitstream_manager.block_children(parent_block).size()) {
+    const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(parent_module);
+    const std::vector<ConfigBlockId>& child_blocks = bitstream_manager.configurable_child_blocks(parent_block);
+    VTR_ASSERT(configurable_children.size() == child_blocks.size());
 
-    size_t num_configurable_children = module_manager.configurable_children(parent_modules.back()).size();
+    size_t num_configurable_children = configurable_children.size();
  
     size_t max_child_addr_code_size = 0;
     bool add_addr_code = true;
@@ -277,11 +257,11 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
      */
       VTR_ASSERT(2 < num_configurable_children);
       num_configurable_children--;
-      decoder_module = module_manager.configurable_children(parent_module).back();
+      decoder_module = configurable_children.back();
 
       /* The address code size is the max. of address port of all the configurable children */
       for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-        ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
+        ModuleId child_module = configurable_children[child_id]; 
         const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
         const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
         max_child_addr_code_size = std::max((int)child_addr_port.get_width(), (int)max_child_addr_code_size);
@@ -289,23 +269,9 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
     }
 
     for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-      ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
-      size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
-      /* Get the instance name and ensure it is not empty */
-      std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-       
-      /* Find the child block that matches the instance name! */ 
-      ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
+      ModuleId child_module = configurable_children[child_id]; 
       /* We must have one valid block id! */
-      if (true != bitstream_manager.valid_block_id(child_block))
-      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-      /* Pass on the list of blocks, modules and address lists */
-      std::vector<ConfigBlockId> child_blocks = parent_blocks;
-      child_blocks.push_back(child_block);
-
-      std::vector<ModuleId> child_modules = parent_modules;
-      child_modules.push_back(child_module);
+      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_blocks[child_id]));
 
       /* Set address, apply binary conversion from the first to the last element in the address list */
       std::vector<char> child_addr_code = addr_code;
@@ -358,8 +324,8 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
       }
 
       /* Go recursively */
-      rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager, child_blocks,
-                                                        module_manager, child_modules,
+      rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager, child_blocks[child_id],
+                                                        module_manager, child_module,
                                                         child_addr_code,
                                                         fabric_bitstream,
                                                         fabric_bitstream_region);
@@ -376,16 +342,16 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
    * We will find the address bit and add it to addr_code
    * Then we can add the configuration bits to the fabric_bitstream.
    */
-  if (!(1 < module_manager.configurable_children(parent_modules.back()).size()))
-  VTR_ASSERT(1 < module_manager.configurable_children(parent_modules.back()).size());
-  ModuleId decoder_module = module_manager.configurable_children(parent_modules.back()).back();
+  VTR_ASSERT(1 < module_manager.configurable_children(parent_module).size());
+  ModuleId decoder_module = module_manager.configurable_children(parent_module).back();
   /* Find the address port from the decoder module */
   const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
   const BasicPort& decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
 
-  for (size_t ibit = 0; ibit < bitstream_manager.block_bits(parent_blocks.back()).size(); ++ibit) {
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(parent_block);
+  for (size_t ibit = 0; ibit < block_bits.size(); ++ibit) {
     
-    ConfigBitId config_bit = bitstream_manager.block_bits(parent_blocks.back())[ibit];
+    ConfigBitId config_bit = block_bits[ibit];
     std::vector<char> addr_bits_vec = itobin_charvec(ibit, decoder_addr_port.get_width());
 
     std::vector<char> child_addr_code = addr_code;
@@ -462,7 +428,7 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     BasicPort wl_addr_port_info = module_manager.module_port(top_module, wl_addr_port);
 
     /* Find BL and WL decoders which are the last two configurable children*/
-    std::vector<ModuleId> configurable_children = module_manager.configurable_children(top_module);
+    const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(top_module);
     VTR_ASSERT(2 <= configurable_children.size()); 
     ModuleId bl_decoder_module = configurable_children[configurable_children.size() - 2];
     VTR_ASSERT(0 == module_manager.configurable_child_instances(top_module)[configurable_children.size() - 2]);
@@ -507,8 +473,8 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
 
     /* Reserve bits before build-up */
     fabric_bitstream.set_use_address(true);
-    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
     fabric_bitstream.set_address_length(addr_port_info.get_width());
+    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
     /* TODO: Currently only support 1 region. Will expand later! */
     VTR_ASSERT(1 == module_manager.regions(top_module).size());
@@ -516,9 +482,9 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
       FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
       rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager,
-                                                        std::vector<ConfigBlockId>(1, top_block),
+                                                        top_block,
                                                         module_manager,
-                                                        std::vector<ModuleId>(1, top_module),
+                                                        top_module,
 	  												    std::vector<char>(),
                                                         fabric_bitstream,
                                                         fabric_bitstream_region);
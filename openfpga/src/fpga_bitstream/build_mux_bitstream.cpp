@@ -7,11 +7,7 @@
 #include "vtr_assert.h"
 #include "vtr_vector.h"
 
-/* Headers from openfpgautil library */
-#include "openfpga_decode.h"
-
 #include "mux_utils.h"
-#include "decoder_library_utils.h"
 
 #include "mux_bitstream_constants.h"
 #include "build_mux_bitstream.h"
@@ -52,7 +48,8 @@ size_t find_mux_default_path_id(const CircuitLibrary& circuit_lib,
  * Thanks to MuxGraph object has already describe the internal multiplexing 
  * structure, bitstream generation is simply done by routing the signal
  * to from a given input to the output
- * All the memory bits can be generated by an API of MuxGraph
+ * The memory bits of each input, including the ones encoded by local encoders,
+ * are precomputed by the MuxLibrary, so here is only a look-up
  *
  * To be generic, this function only returns a vector bit values
  * without touching an bitstream-relate data structure
@@ -70,7 +67,7 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
   size_t implemented_mux_size = find_mux_implementation_num_inputs(circuit_lib, mux_model, mux_size);
   /* Note that the mux graph is indexed using datapath MUX size!!!! */
   MuxId mux_graph_id = mux_lib.mux_graph(mux_model, mux_size);
-  const MuxGraph mux_graph = mux_lib.mux_graph(mux_graph_id);
+  const MuxGraph& mux_graph = mux_lib.mux_graph(mux_graph_id);
 
   size_t datapath_id = path_id;
 
@@ -81,66 +78,12 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
     VTR_ASSERT( datapath_id < mux_size);
   }
   /* Path id should makes sense */
-  VTR_ASSERT(datapath_id < mux_graph.inputs().size());
+  VTR_ASSERT(datapath_id < mux_graph.num_inputs());
   /* We should have only one output for this MUX! */
-  VTR_ASSERT(1 == mux_graph.outputs().size());
-
-  /* Generate the memory bits */
-  vtr::vector<MuxMemId, bool> raw_bitstream = mux_graph.decode_memory_bits(MuxInputId(datapath_id), mux_graph.output_id(mux_graph.outputs()[0]));
-
-  std::vector<bool> mux_bitstream;
-  for (const bool& bit : raw_bitstream) {
-    mux_bitstream.push_back(bit);
-  }
-
-  /* Consider local encoder support, we need further encode the bitstream */
-  if (false == circuit_lib.mux_use_local_encoder(mux_model)) {
-    return mux_bitstream;
-  }
+  VTR_ASSERT(1 == mux_graph.num_outputs());
 
-  /* Clear the mux_bitstream, we need to apply encoding */
-  mux_bitstream.clear();
-
-  /* Encode the memory bits level by level,
-   * One local encoder is used for each level of multiplexers 
-   */
-  for (const size_t& level : mux_graph.levels()) {
-    /* The encoder will convert the path_id to a binary number 
-     * For example: when path_id=3 (use the 4th input), using a 2-input encoder 
-     * the sram_bits will be the 2-digit binary number of 3: 10
-     */
-    std::vector<size_t> encoder_data;
-
-    /* Exception: there is only 1 memory at this level, bitstream will not be changed!!! */
-    if (1 == mux_graph.memories_at_level(level).size()) {
-      mux_bitstream.push_back(raw_bitstream[mux_graph.memories_at_level(level)[0]]);
-      continue;
-    }
-
-    /* Otherwise: we follow a regular recipe */
-    for (size_t mem_index = 0; mem_index < mux_graph.memories_at_level(level).size(); ++mem_index) {
-      /* Conversion rule: true = 1, false = 0 */
-      if (true == raw_bitstream[mux_graph.memories_at_level(level)[mem_index]]) {
-        encoder_data.push_back(mem_index);
-      } 
-    }
-    /* There should be at most one '1' */
-    VTR_ASSERT( (0 == encoder_data.size()) || (1 == encoder_data.size()));
-    /* Convert to encoded bits */
-    std::vector<size_t> encoder_addr;
-    if (0 == encoder_data.size()) { 
-      encoder_addr = itobin_vec(0, find_mux_local_decoder_addr_size(mux_graph.memories_at_level(level).size()));
-    } else {
-      VTR_ASSERT(1 == encoder_data.size());
-      encoder_addr = itobin_vec(encoder_data[0], find_mux_local_decoder_addr_size(mux_graph.memories_at_level(level).size()));
-    }
-    /* Build final mux bitstream */
-    for (const size_t& bit : encoder_addr) {
-      mux_bitstream.push_back(1 == bit);
-    }
-  } 
-
-  return mux_bitstream;
+  /* Generate the memory bits, considering local encoder support */
+  return mux_lib.mux_config_bits(mux_graph_id, MuxInputId(datapath_id));
 }
 
 /********************************************************************
@@ -4,7 +4,6 @@
 #include <algorithm>
 
 #include "vtr_assert.h"
-#include "openfpga_decode.h"
 #include "fabric_bitstream.h"
 
 /* begin namespace openfpga */
@@ -16,6 +15,8 @@ namespace openfpga {
 FabricBitstream::FabricBitstream() {
   num_bits_ = 0;
   invalid_bit_ids_.clear();
+  use_address_ = false;
+  use_wl_address_ = false;
   address_length_ = 0;
   wl_address_length_ = 0;
 
@@ -50,7 +51,7 @@ std::vector<FabricBitId> FabricBitstream::region_bits(const FabricBitRegionId& r
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_region_id(region_id));
 
-  return region_bit_ids_[region_id];
+  return region_bit_ids_[region_id].to_vector();
 }
 
 /******************************************************************************
@@ -60,7 +61,7 @@ ConfigBitId FabricBitstream::config_bit(const FabricBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return config_bit_ids_[bit_id];
+  return config_bit_ids_.at(size_t(bit_id));
 }
 
 std::vector<char> FabricBitstream::bit_address(const FabricBitId& bit_id) const {
@@ -68,7 +69,7 @@ std::vector<char> FabricBitstream::bit_address(const FabricBitId& bit_id) const
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
 
-  return itobin_charvec(bit_addresses_[bit_id], address_length_);
+  return get_packed_address(bit_addresses_, size_t(bit_id), address_length_);
 }
 
 std::vector<char> FabricBitstream::bit_bl_address(const FabricBitId& bit_id) const {
@@ -81,7 +82,15 @@ std::vector<char> FabricBitstream::bit_wl_address(const FabricBitId& bit_id) con
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
 
-  return itobin_charvec(bit_wl_addresses_[bit_id], wl_address_length_);
+  return get_packed_address(bit_wl_addresses_, size_t(bit_id), wl_address_length_);
+}
+
+size_t FabricBitstream::address_length() const {
+  return address_length_;
+}
+
+size_t FabricBitstream::wl_address_length() const {
+  return wl_address_length_;
 }
 
 char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
@@ -89,7 +98,7 @@ char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
 
-  return bit_dins_[bit_id];
+  return bit_dins_[size_t(bit_id)];
 }
 
 bool FabricBitstream::use_address() const {
@@ -104,14 +113,15 @@ bool FabricBitstream::use_wl_address() const {
  * Public Mutators
  ******************************************************************************/
 void FabricBitstream::reserve_bits(const size_t& num_bits) {
-  config_bit_ids_.reserve(num_bits);
- 
+  /* Configuration bits are stored in runs, whose number is unknown. 
+   * Only address-related data can be reserved
+   */
   if (true == use_address_) {
-    bit_addresses_.reserve(num_bits);
+    bit_addresses_.reserve(num_bits * address_length_);
     bit_dins_.reserve(num_bits);
  
     if (true == use_wl_address_) {
-      bit_wl_addresses_.reserve(num_bits);
+      bit_wl_addresses_.reserve(num_bits * wl_address_length_);
     }
   }
 }
@@ -122,6 +132,15 @@ FabricBitId FabricBitstream::add_bit(const ConfigBitId& config_bit_id) {
   num_bits_++;
   config_bit_ids_.push_back(config_bit_id);
 
+  if (true == use_address_) {
+    bit_addresses_.resize(num_bits_ * address_length_, false);
+    bit_dins_.push_back(false);
+
+    if (true == use_wl_address_) {
+      bit_wl_addresses_.resize(num_bits_ * wl_address_length_, false);
+    }
+  }
+
   return bit; 
 }
 
@@ -130,7 +149,7 @@ void FabricBitstream::set_bit_address(const FabricBitId& bit_id,
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(address_length_ == address.size());
-  bit_addresses_[bit_id] = bintoi_charvec(address);
+  set_packed_address(bit_addresses_, size_t(bit_id), address);
 }
 
 void FabricBitstream::set_bit_bl_address(const FabricBitId& bit_id,
@@ -144,14 +163,14 @@ void FabricBitstream::set_bit_wl_address(const FabricBitId& bit_id,
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
   VTR_ASSERT(wl_address_length_ == address.size());
-  bit_wl_addresses_[bit_id] = bintoi_charvec(address);
+  set_packed_address(bit_wl_addresses_, size_t(bit_id), address);
 }
 
 void FabricBitstream::set_bit_din(const FabricBitId& bit_id,
                                   const char& din) {
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
-  bit_dins_[bit_id] = din;
+  bit_dins_[size_t(bit_id)] = (0 != din);
 }
 
 void FabricBitstream::set_use_address(const bool& enable) {
@@ -162,9 +181,12 @@ void FabricBitstream::set_use_address(const bool& enable) {
 }
 
 void FabricBitstream::set_address_length(const size_t& length) {
-  if (true == use_address_) {
-    address_length_ = length; 
-  }
+  /* Add a lock, only can be modified when num bits are zero,
+   * as the addresses are packed by the length
+   */
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(0 == num_bits_);
+  address_length_ = length; 
 }
 
 void FabricBitstream::set_bl_address_length(const size_t& length) {
@@ -179,9 +201,12 @@ void FabricBitstream::set_use_wl_address(const bool& enable) {
 }
 
 void FabricBitstream::set_wl_address_length(const size_t& length) {
-  if (true == use_address_) {
-    wl_address_length_ = length; 
-  }
+  /* Add a lock, only can be modified when num bits are zero,
+   * as the addresses are packed by the length
+   */
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(0 == num_bits_);
+  wl_address_length_ = length; 
 }
 
 void FabricBitstream::reserve_regions(const size_t& num_regions) {
@@ -206,14 +231,14 @@ void FabricBitstream::add_bit_to_region(const FabricBitRegionId& region_id,
 }
 
 void FabricBitstream::reverse() {
-  std::reverse(config_bit_ids_.begin(), config_bit_ids_.end());
+  config_bit_ids_.reverse();
 
   if (true == use_address_) {
-    std::reverse(bit_addresses_.begin(), bit_addresses_.end());
+    reverse_packed_addresses(bit_addresses_, address_length_);
     std::reverse(bit_dins_.begin(), bit_dins_.end());
 
     if (true == use_wl_address_) {
-      std::reverse(bit_wl_addresses_.begin(), bit_wl_addresses_.end());
+      reverse_packed_addresses(bit_wl_addresses_, wl_address_length_);
     }
   }
 }
@@ -221,7 +246,46 @@ void FabricBitstream::reverse() {
 void FabricBitstream::reverse_region_bits(const FabricBitRegionId& region_id) {
   VTR_ASSERT(true == valid_region_id(region_id));
 
-  std::reverse(region_bit_ids_[region_id].begin(), region_bit_ids_[region_id].end());
+  region_bit_ids_[region_id].reverse();
+}
+
+/******************************************************************************
+ * Private Accessors/Mutators for packed addresses
+ ******************************************************************************/
+std::vector<char> FabricBitstream::get_packed_address(const std::vector<bool>& addresses,
+                                                      const size_t& index,
+                                                      const size_t& length) const {
+  std::vector<char> address(length, '0');
+  for (size_t i = 0; i < length; ++i) {
+    if (true == addresses[index * length + i]) {
+      address[i] = '1';
+    }
+  }
+  return address;
+}
+
+void FabricBitstream::set_packed_address(std::vector<bool>& addresses,
+                                         const size_t& index,
+                                         const std::vector<char>& address) {
+  for (size_t i = 0; i < address.size(); ++i) {
+    addresses[index * address.size() + i] = ('1' == address[i]);
+  }
+}
+
+/* Reverse the sequence of addresses while keeping the bit order inside each address */
+void FabricBitstream::reverse_packed_addresses(std::vector<bool>& addresses,
+                                               const size_t& length) {
+  if (0 == length) {
+    return;
+  }
+  std::vector<bool> reversed_addresses;
+  reversed_addresses.reserve(addresses.size());
+  for (size_t index = addresses.size() / length; index > 0; --index) {
+    reversed_addresses.insert(reversed_addresses.end(),
+                              addresses.begin() + (index - 1) * length,
+                              addresses.begin() + index * length);
+  }
+  addresses = reversed_addresses;
 }
 
 /******************************************************************************
@@ -29,6 +29,7 @@
 #define FABRIC_BITSTREAM_H
 
 #include <vector>
+#include <algorithm>
 #include <unordered_set>
 #include <unordered_map>
 #include "vtr_vector.h"
@@ -87,6 +88,113 @@ class FabricBitstream {
         const std::unordered_set<ID>& invalid_ids_;
     };
 
+    /*
+     * This class is a template used to store a sequence of IDs in a compact way.
+     * The key assumption made is that most of the IDs in the sequence are consecutive,
+     * e.g., the configuration bits of a block are added to fabric bitstream one after another.
+     * Therefore, the sequence is stored as runs of consecutive IDs,
+     * each of which only requires the position of its head, the first ID and its direction.
+     * An element is found by a binary search on the heads of runs.
+     */
+    template<class ID>
+    class id_run_list {
+      public:
+        id_run_list() : size_(0) {}
+
+        //Number of IDs in the sequence
+        size_t size() const { return size_; }
+
+        //Find the ID at a given position of the sequence
+        ID at(const size_t& index) const {
+            auto run_it = std::upper_bound(run_heads_.begin(), run_heads_.end(), index);
+            size_t irun = std::distance(run_heads_.begin(), run_it) - 1;
+            size_t offset = index - run_heads_[irun];
+            if (true == run_descending_[irun]) {
+              return ID(size_t(run_first_ids_[irun]) - offset);
+            }
+            return ID(size_t(run_first_ids_[irun]) + offset);
+        }
+
+        //Expand the sequence to a plain vector
+        std::vector<ID> to_vector() const {
+            std::vector<ID> ids;
+            ids.reserve(size_);
+            for (size_t irun = 0; irun < run_heads_.size(); ++irun) {
+              for (size_t offset = 0; offset < run_size(irun); ++offset) {
+                if (true == run_descending_[irun]) {
+                  ids.push_back(ID(size_t(run_first_ids_[irun]) - offset));
+                } else {
+                  ids.push_back(ID(size_t(run_first_ids_[irun]) + offset));
+                }
+              }
+            }
+            return ids;
+        }
+
+        void reserve_runs(const size_t& num_runs) {
+            run_heads_.reserve(num_runs);
+            run_first_ids_.reserve(num_runs);
+        }
+
+        //Add an ID to the tail of the sequence, which is merged to the last run if possible
+        void push_back(const ID& id) {
+            if (false == run_heads_.empty()) {
+              size_t last_run = run_heads_.size() - 1;
+              size_t first_id = size_t(run_first_ids_[last_run]);
+              size_t last_run_size = run_size(last_run);
+              /* A run with only one ID can grow in both directions */
+              if (1 == last_run_size) {
+                run_descending_[last_run] = (size_t(id) + 1 == first_id);
+              }
+              if ( ((false == run_descending_[last_run]) && (first_id + last_run_size == size_t(id)))
+                || ((true == run_descending_[last_run]) && (first_id - last_run_size == size_t(id))) ) {
+                size_++;
+                return;
+              }
+            }
+            run_heads_.push_back(size_);
+            run_first_ids_.push_back(id);
+            run_descending_.push_back(false);
+            size_++;
+        }
+
+        //Reverse the sequence, which reverses the runs as well as the direction of each run
+        void reverse() {
+            std::vector<size_t> reversed_heads;
+            std::vector<ID> reversed_first_ids;
+            std::vector<bool> reversed_descending;
+            reversed_heads.reserve(run_heads_.size());
+            reversed_first_ids.reserve(run_heads_.size());
+            for (size_t irun = run_heads_.size(); irun > 0; --irun) {
+              size_t curr_size = run_size(irun - 1);
+              reversed_heads.push_back(size_ - run_heads_[irun - 1] - curr_size);
+              if (true == run_descending_[irun - 1]) {
+                reversed_first_ids.push_back(ID(size_t(run_first_ids_[irun - 1]) - (curr_size - 1)));
+              } else {
+                reversed_first_ids.push_back(ID(size_t(run_first_ids_[irun - 1]) + (curr_size - 1)));
+              }
+              reversed_descending.push_back((1 < curr_size) && (false == run_descending_[irun - 1]));
+            }
+            run_heads_ = reversed_heads;
+            run_first_ids_ = reversed_first_ids;
+            run_descending_ = reversed_descending;
+        }
+
+      private:
+        size_t run_size(const size_t& irun) const {
+            if (irun + 1 < run_heads_.size()) {
+              return run_heads_[irun + 1] - run_heads_[irun];
+            }
+            return size_ - run_heads_[irun];
+        }
+
+      private:
+        size_t size_;
+        std::vector<size_t> run_heads_;
+        std::vector<ID> run_first_ids_;
+        std::vector<bool> run_descending_;
+    };
+
   public: /* Types and ranges */
     //Lazy iterator utility forward declaration
     template<class ID>
@@ -120,6 +228,10 @@ class FabricBitstream {
     std::vector<char> bit_bl_address(const FabricBitId& bit_id) const;
     std::vector<char> bit_wl_address(const FabricBitId& bit_id) const;
 
+    /* Find the number of characters in an address */
+    size_t address_length() const;
+    size_t wl_address_length() const;
+
     /* Find the data-in of bitstream */
     char bit_din(const FabricBitId& bit_id) const;
 
@@ -128,7 +240,9 @@ class FabricBitstream {
     bool use_wl_address() const;
 
   public:  /* Public Mutators */
-    /* Reserve config bits */
+    /* Reserve config bits
+     * The address lengths should be set before, as the addresses are reserved by the lengths
+     */
     void reserve_bits(const size_t& num_bits);
 
     /* Add a new configuration bit to the bitstream manager */
@@ -184,16 +298,28 @@ class FabricBitstream {
     bool valid_bit_id(const FabricBitId& bit_id) const;
     bool valid_region_id(const FabricBitRegionId& bit_id) const;
 
+  private: /* Private Accessors/Mutators */
+    std::vector<char> get_packed_address(const std::vector<bool>& addresses,
+                                         const size_t& index,
+                                         const size_t& length) const;
+    void set_packed_address(std::vector<bool>& addresses,
+                            const size_t& index,
+                            const std::vector<char>& address);
+    void reverse_packed_addresses(std::vector<bool>& addresses,
+                                  const size_t& length);
+
   private: /* Internal data */
     /* Unique id of a region in the Bitstream */
     size_t num_regions_; 
     std::unordered_set<FabricBitRegionId> invalid_region_ids_;
-    vtr::vector<FabricBitRegionId, std::vector<FabricBitId>> region_bit_ids_; 
+    /* Bits of each region, which are mostly consecutive and stored in runs */
+    vtr::vector<FabricBitRegionId, id_run_list<FabricBitId>> region_bit_ids_; 
 
     /* Unique id of a bit in the Bitstream */
     size_t num_bits_; 
     std::unordered_set<FabricBitId> invalid_bit_ids_;
-    vtr::vector<FabricBitId, ConfigBitId> config_bit_ids_; 
+    /* Configuration bit id of each bit, which are mostly consecutive and stored in runs */
+    id_run_list<ConfigBitId> config_bit_ids_; 
 
     /* Flags to indicate if the addresses and din should be enabled */
     bool use_address_;
@@ -206,13 +332,16 @@ class FabricBitstream {
      * Here we store the binary format of the address, which can be loaded
      * to the configuration protocol directly 
      *
-     * We use a 2-element array, as we may have a BL address and a WL address
+     * The addresses are packed in bit vectors, 
+     * where the address of a bit occupies <address_length_> bits starting from
+     * the position <bit_id> * <address_length_>
+     * Same for the WL addresses
      */
-    vtr::vector<FabricBitId, size_t> bit_addresses_;
-    vtr::vector<FabricBitId, size_t> bit_wl_addresses_;
+    std::vector<bool> bit_addresses_;
+    std::vector<bool> bit_wl_addresses_;
 
     /* Data input (Din) bits: this is designed for memory decoders */
-    vtr::vector<FabricBitId, char> bit_dins_;
+    std::vector<bool> bit_dins_;
 };
 
 } /* end namespace openfpga */
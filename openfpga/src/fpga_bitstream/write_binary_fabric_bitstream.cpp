@@ -0,0 +1,99 @@
+/********************************************************************
+ * This file includes functions that output a fabric-dependent
+ * bitstream database to files in binary format
+ *******************************************************************/
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from fpgabitstream library */
+#include "binary_fabric_bitstream_writer.h"
+
+#include "write_binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write the fabric bitstream to a binary file
+ * The bits are outputted in the same order as the plain text file,
+ * while the addresses are compressed (see binary_fabric_bitstream.h)
+ * The file can be loaded by the BinaryFabricBitstreamReader
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_to_binary_file(const BitstreamManager& bitstream_manager,
+                                          const FabricBitstream& fabric_bitstream,
+                                          const ConfigProtocol& config_protocol,
+                                          const std::string& fname,
+                                          const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Only the protocols with addresses require the address streams */
+  size_t bl_address_width = 0;
+  size_t wl_address_width = 0;
+  switch (config_protocol.type()) {
+  case CONFIG_MEM_STANDALONE:
+  case CONFIG_MEM_SCAN_CHAIN:
+    break;
+  case CONFIG_MEM_MEMORY_BANK:
+    bl_address_width = fabric_bitstream.address_length();
+    wl_address_width = fabric_bitstream.wl_address_length();
+    break;
+  case CONFIG_MEM_FRAME_BASED:
+    bl_address_width = fabric_bitstream.address_length();
+    break;
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid configuration protocol type!\n");
+    return 1;
+  }
+
+  BinaryFabricBitstreamWriter writer(config_protocol.type(), bl_address_width, wl_address_width);
+
+  /* Bits of a region have consecutive ids, and regions are created in the order of bits.
+   * Output bits region by region in ascending order, which is the same as FabricBitstream::bits()
+   */
+  const std::vector<char> empty_address;
+  size_t next_bit = 0;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    std::vector<FabricBitId> region_bits = fabric_bitstream.region_bits(region);
+    std::sort(region_bits.begin(), region_bits.end());
+
+    writer.add_region();
+
+    for (const FabricBitId& fabric_bit : region_bits) {
+      VTR_ASSERT(next_bit == size_t(fabric_bit));
+      next_bit++;
+
+      bool bit_value = bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+      writer.add_bit(bit_value,
+                     0 < bl_address_width ? fabric_bitstream.bit_bl_address(fabric_bit) : empty_address,
+                     0 < wl_address_width ? fabric_bitstream.bit_wl_address(fabric_bit) : empty_address);
+    }
+  }
+  VTR_ASSERT(fabric_bitstream.num_bits() == writer.num_bits());
+
+  int status = writer.write_to_file(fname);
+
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits to binary file: %s\n",
+           writer.num_bits(),
+           fname.c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -2,8 +2,6 @@
  * This file includes functions that output a fabric-dependent 
  * bitstream database to files in XML format
  *******************************************************************/
-#include <chrono>
-#include <ctime>
 #include <fstream>
 
 /* Headers from vtrutil library */
@@ -31,14 +29,11 @@ static
 void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
   valid_file_stream(fp);
  
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
   fp << "<!--" << std::endl;
   fp << "\t- Fabric bitstream" << std::endl;
   fp << "\t- Author: Xifan TANG" << std::endl;
   fp << "\t- Organization: University of Utah" << std::endl;
-  fp << "\t- Date: " << std::ctime(&end_time) ;
+  fp << "\t- Date: " << get_current_date() << std::endl;
   fp << "-->" << std::endl;
   fp << std::endl;
 }
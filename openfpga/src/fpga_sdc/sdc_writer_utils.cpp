@@ -1,8 +1,6 @@
 /********************************************************************
  * This file include most utilized functions to be used in SDC writers 
  *******************************************************************/
-#include <chrono>
-#include <ctime>
 #include <iomanip>
 #include <map>
 
@@ -28,16 +26,13 @@ void print_sdc_file_header(std::fstream& fp,
 
   valid_file_stream(fp);
 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
   fp << "#############################################" << std::endl;
   fp << "#\tSynopsys Design Constraints (SDC)" << std::endl;
   fp << "#\tFor FPGA fabric " << std::endl;
   fp << "#\tDescription: " << usage << std::endl;
   fp << "#\tAuthor: Xifan TANG " << std::endl;
   fp << "#\tOrganization: University of Utah " << std::endl;
-  fp << "#\tDate: " << std::ctime(&end_time);
+  fp << "#\tDate: " << get_current_date() << std::endl;
   fp << "#############################################" << std::endl;
   fp << std::endl;
 }
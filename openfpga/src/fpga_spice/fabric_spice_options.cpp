@@ -16,6 +16,7 @@ FabricSpiceOption::FabricSpiceOption() {
   explicit_port_mapping_ = false;
   compress_routing_ = false;
   verbose_output_ = false;
+  num_jobs_ = 1;
 }
 
 /**************************************************
@@ -37,6 +38,10 @@ bool FabricSpiceOption::verbose_output() const {
   return verbose_output_;
 }
 
+size_t FabricSpiceOption::num_jobs() const {
+  return num_jobs_;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -56,4 +61,8 @@ void FabricSpiceOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
 
+void FabricSpiceOption::set_num_jobs(const size_t& num_jobs) {
+  num_jobs_ = num_jobs;
+}
+
 } /* end namespace openfpga */
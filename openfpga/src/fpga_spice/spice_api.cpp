@@ -93,13 +93,15 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
     print_spice_unique_routing_modules(netlist_manager,
                                        module_manager,
                                        device_rr_gsb,
-                                       rr_dir_path);
+                                       rr_dir_path,
+                                       options.num_jobs());
   } else {
     VTR_ASSERT(false == options.compress_routing());
     print_spice_flatten_routing_modules(netlist_manager,
                                         module_manager,
                                         device_rr_gsb,
-                                        rr_dir_path);
+                                        rr_dir_path,
+                                        options.num_jobs());
   }
 
   /* Generate grids */
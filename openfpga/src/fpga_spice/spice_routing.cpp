@@ -2,6 +2,9 @@
  * This file includes functions that are used for 
  * SPICE generation of FPGA routing architecture (global routing) 
  *********************************************************************/
+#include <utility>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
@@ -12,6 +15,7 @@
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
+#include "openfpga_parallel_utils.h"
 #include "spice_constants.h"
 #include "spice_writer_utils.h"
 #include "spice_subckt_writer.h"
@@ -73,13 +77,14 @@ namespace openfpga {
  *
  *  W: routing channel width
  *              
+ * Return the name of the netlist file, which should be added to netlist manager
+ * by the caller. This allows multiple modules to be written in parallel
  ********************************************************************/
 static 
-void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_manager,
-                                                      const ModuleManager& module_manager, 
-                                                      const std::string& subckt_dir, 
-                                                      const RRGSB& rr_gsb,
-                                                      const t_rr_type& cb_type) {
+std::string print_spice_routing_connection_box_unique_module(const ModuleManager& module_manager, 
+                                                             const std::string& subckt_dir, 
+                                                             const RRGSB& rr_gsb,
+                                                             const t_rr_type& cb_type) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
   std::string spice_fname(subckt_dir + generate_connection_block_netlist_name(cb_type, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
@@ -105,10 +110,7 @@ void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_ma
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return spice_fname;
 }
 
 /*********************************************************************
@@ -173,12 +175,13 @@ void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_ma
  *                       right_pins    inputs/outputs      left_pins
  *
  *
+ * Return the name of the netlist file, which should be added to netlist manager
+ * by the caller. This allows multiple modules to be written in parallel
  ********************************************************************/
 static 
-void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manager,
-                                                  const ModuleManager& module_manager, 
-                                                  const std::string& subckt_dir, 
-                                                  const RRGSB& rr_gsb) {
+std::string print_spice_routing_switch_box_unique_module(const ModuleManager& module_manager, 
+                                                         const std::string& subckt_dir, 
+                                                         const RRGSB& rr_gsb) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string spice_fname(subckt_dir + generate_routing_block_netlist_name(SB_SPICE_FILE_NAME_PREFIX, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
@@ -201,22 +204,59 @@ void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manage
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return spice_fname;
+}
+
+/********************************************************************
+ * Write the netlists of a list of routing blocks, each of which
+ * is a switch block (when the type is NUM_RR_TYPES) 
+ * or a connection block (when the type is CHANX or CHANY) of a GSB.
+ *
+ * Each netlist is written to its own file, which only requires 
+ * reading the module manager. Therefore, the netlists can be written
+ * by multiple threads when num_jobs is larger than 1.
+ * The netlists are added to the netlist manager afterwards in the order 
+ * of the routing blocks, so that the netlist manager is the same as 
+ * writing netlists serially
+ *******************************************************************/
+static 
+void print_spice_routing_block_modules(NetlistManager& netlist_manager,
+                                       const ModuleManager& module_manager, 
+                                       const std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_blocks,
+                                       const std::string& subckt_dir,
+                                       const size_t& num_jobs) {
+  std::vector<std::string> netlist_names(routing_blocks.size());
+
+  run_parallel_tasks(routing_blocks.size(), num_jobs, 
+                     [&](const size_t& iblock) {
+    const RRGSB& rr_gsb = *(routing_blocks[iblock].first);
+    if (NUM_RR_TYPES == routing_blocks[iblock].second) {
+      netlist_names[iblock] = print_spice_routing_switch_box_unique_module(module_manager,
+                                                                           subckt_dir,
+                                                                           rr_gsb);
+    } else {
+      netlist_names[iblock] = print_spice_routing_connection_box_unique_module(module_manager,
+                                                                               subckt_dir,
+                                                                               rr_gsb, routing_blocks[iblock].second);
+    }
+  });
+
+  /* Add fnames to the netlist name list */
+  for (const std::string& spice_fname : netlist_names) {
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  }
 }
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
- * and build a module for each of them 
+ * and collect them to build a module for each of them 
  *******************************************************************/
 static 
-void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manager,
-                                                  const ModuleManager& module_manager, 
-                                                  const DeviceRRGSB& device_rr_gsb,
-                                                  const std::string& subckt_dir,
-                                                  const t_rr_type& cb_type) {
+void collect_flatten_connection_blocks(std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_blocks,
+                                       const DeviceRRGSB& device_rr_gsb,
+                                       const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -230,10 +270,7 @@ void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manage
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_spice_routing_connection_box_unique_module(netlist_manager, 
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       rr_gsb, cb_type);
+      routing_blocks.push_back(std::make_pair(&rr_gsb, cb_type));
     }
   }
 }
@@ -246,16 +283,21 @@ void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manage
  * Covering:
  * 1. Connection blocks
  * 2. Switch blocks
+ * The netlists are written by num_jobs threads
  *******************************************************************/
 void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
-                                         const std::string& subckt_dir) {
+                                         const std::string& subckt_dir,
+                                         const size_t& num_jobs) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
+  /* Collect all the switch blocks and connection blocks to be written */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
+
   /* Build unique switch block modules */
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
@@ -263,16 +305,18 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_spice_routing_switch_box_unique_module(netlist_manager,
-                                                   module_manager, 
-                                                   subckt_dir, 
-                                                   rr_gsb);
+      routing_blocks.push_back(std::make_pair(&rr_gsb, NUM_RR_TYPES));
     }
   }
 
-  print_spice_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX);
+  collect_flatten_connection_blocks(routing_blocks, device_rr_gsb, CHANX);
+
+  collect_flatten_connection_blocks(routing_blocks, device_rr_gsb, CHANY);
 
-  print_spice_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY);
+  print_spice_routing_block_modules(netlist_manager, module_manager,
+                                    routing_blocks,
+                                    subckt_dir,
+                                    num_jobs);
 
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
@@ -295,43 +339,42 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
  *
  * Note: this function SHOULD be called only when 
  * the option compact_routing_hierarchy is turned on!!!
+ * The netlists are written by num_jobs threads
  *******************************************************************/
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
-                                          const ModuleManager& module_manager,
-                                          const DeviceRRGSB& device_rr_gsb,
-                                          const std::string& subckt_dir) {
+                                        const ModuleManager& module_manager,
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const std::string& subckt_dir,
+                                        const size_t& num_jobs) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
 
+  /* Collect all the unique switch blocks and connection blocks to be written */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
+
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_spice_routing_switch_box_unique_module(netlist_manager,
-                                                 module_manager,
-                                                 subckt_dir, 
-                                                 unique_mirror);
+    routing_blocks.push_back(std::make_pair(&unique_mirror, NUM_RR_TYPES));
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_spice_routing_connection_box_unique_module(netlist_manager,
-                                                     module_manager,
-                                                     subckt_dir, 
-                                                     unique_mirror, CHANX);
+    routing_blocks.push_back(std::make_pair(&unique_mirror, CHANX));
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_spice_routing_connection_box_unique_module(netlist_manager, 
-                                                     module_manager,
-                                                     subckt_dir, 
-                                                     unique_mirror, CHANY);
+    routing_blocks.push_back(std::make_pair(&unique_mirror, CHANY));
   }
 
+  print_spice_routing_block_modules(netlist_manager, module_manager,
+                                    routing_blocks,
+                                    subckt_dir,
+                                    num_jobs);
+
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
           ROUTING_VERILOG_FILE_NAME);
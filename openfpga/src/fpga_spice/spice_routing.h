@@ -20,12 +20,14 @@ namespace openfpga {
 void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
-                                         const std::string& subckt_dir);
+                                         const std::string& subckt_dir,
+                                         const size_t& num_jobs);
 
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
                                         const ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
-                                        const std::string& subckt_dir);
+                                        const std::string& subckt_dir,
+                                        const size_t& num_jobs);
 
 } /* end namespace openfpga */
 
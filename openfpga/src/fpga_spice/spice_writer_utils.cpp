@@ -2,8 +2,6 @@
  * Include functions for most frequently
  * used Spice writers 
  ***********************************************/
-#include <chrono>
-#include <ctime>
 #include <string>
 #include <fstream>
 #include <iomanip>
@@ -32,15 +30,12 @@ void print_spice_file_header(std::fstream& fp,
                              const std::string& usage) {
   VTR_ASSERT(true == valid_file_stream(fp));
  
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
   fp << "*********************************************" << std::endl;
   fp << "*\tFPGA-SPICE Netlist" << std::endl;
   fp << "*\tDescription: " << usage << std::endl;
   fp << "*\tAuthor: Xifan TANG" << std::endl;
   fp << "*\tOrganization: University of Utah" << std::endl;
-  fp << "*\tDate: " << std::ctime(&end_time) ;
+  fp << "*\tDate: " << get_current_date() << std::endl;
   fp << "*********************************************" << std::endl;
   fp << std::endl;
 }
@@ -20,6 +20,7 @@ FabricVerilogOption::FabricVerilogOption() {
   compress_routing_ = false;
   print_user_defined_template_ = false;
   verbose_output_ = false;
+  num_jobs_ = 1;
 }
 
 /**************************************************
@@ -57,6 +58,10 @@ bool FabricVerilogOption::verbose_output() const {
   return verbose_output_;
 }
 
+size_t FabricVerilogOption::num_jobs() const {
+  return num_jobs_;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -92,4 +97,8 @@ void FabricVerilogOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
 
+void FabricVerilogOption::set_num_jobs(const size_t& num_jobs) {
+  num_jobs_ = num_jobs;
+}
+
 } /* end namespace openfpga */
@@ -25,6 +25,7 @@ class FabricVerilogOption {
     bool compress_routing() const;
     bool print_user_defined_template() const;
     bool verbose_output() const;
+    size_t num_jobs() const;
   public: /* Public mutators */
     void set_output_directory(const std::string& output_dir);
     void set_support_icarus_simulator(const bool& enabled);
@@ -34,6 +35,7 @@ class FabricVerilogOption {
     void set_compress_routing(const bool& enabled);
     void set_print_user_defined_template(const bool& enabled);
     void set_verbose_output(const bool& enabled);
+    void set_num_jobs(const size_t& num_jobs);
   private: /* Internal Data */
     std::string output_directory_;
     bool support_icarus_simulator_;
@@ -43,6 +45,8 @@ class FabricVerilogOption {
     bool compress_routing_;
     bool print_user_defined_template_;
     bool verbose_output_;
+    /* Number of threads to write netlists */
+    size_t num_jobs_;
 };
 
 } /* End namespace openfpga*/
@@ -103,14 +103,16 @@ void fpga_fabric_verilog(ModuleManager &module_manager,
                                          const_cast<const ModuleManager &>(module_manager),
                                          device_rr_gsb,
                                          rr_dir_path,
-                                         options.explicit_port_mapping());
+                                         options.explicit_port_mapping(),
+                                         options.num_jobs());
   } else {
     VTR_ASSERT(false == options.compress_routing());
     print_verilog_flatten_routing_modules(netlist_manager,
                                           const_cast<const ModuleManager &>(module_manager),
                                           device_rr_gsb,
                                           rr_dir_path,
-                                          options.explicit_port_mapping());
+                                          options.explicit_port_mapping(),
+                                          options.num_jobs());
   }
 
   /* Generate grids */
@@ -180,12 +182,18 @@ void fpga_verilog_testbench(const ModuleManager &module_manager,
   /* Generate wrapper module for FPGA fabric (mapped by the input benchmark and pre-configured testbench for verification */
   if (true == options.print_formal_verification_top_netlist()) {
     std::string formal_verification_top_netlist_file_path = src_dir_path + netlist_name + std::string(FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX);
+    /* Bitstream is loaded from a memory file only when it is enabled */
+    std::string formal_verification_bitstream_file_path;
+    if (true == options.use_bitstream_memory_file()) {
+      formal_verification_bitstream_file_path = src_dir_path + netlist_name + std::string(FORMAL_VERIFICATION_BITSTREAM_FILE_POSTFIX);
+    }
     print_verilog_preconfig_top_module(module_manager, bitstream_manager,
                                        circuit_lib, global_ports,
                                        atom_ctx, place_ctx, io_location_map,
                                        netlist_annotation,
                                        netlist_name,
                                        formal_verification_top_netlist_file_path,
+                                       formal_verification_bitstream_file_path,
                                        options.explicit_port_mapping());
   }
 
@@ -203,6 +211,11 @@ void fpga_verilog_testbench(const ModuleManager &module_manager,
   /* Generate full testbench for verification, including configuration phase and operating phase */
   if (true == options.print_top_testbench()) {
     std::string top_testbench_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX);
+    /* Bitstream is loaded from a memory file only when it is enabled */
+    std::string bitstream_memory_file_path;
+    if (true == options.use_bitstream_memory_file()) {
+      bitstream_memory_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_BITSTREAM_FILE_POSTFIX);
+    }
     print_verilog_top_testbench(module_manager,
                                 bitstream_manager, fabric_bitstream,
                                 config_protocol,
@@ -211,6 +224,7 @@ void fpga_verilog_testbench(const ModuleManager &module_manager,
                                 netlist_annotation,
                                 netlist_name,
                                 top_testbench_file_path,
+                                bitstream_memory_file_path,
                                 simulation_setting,
                                 options.fast_configuration(),
                                 options.explicit_port_mapping());
@@ -23,8 +23,10 @@ constexpr char* FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME = "fabric_netlists.v";
 constexpr char* TOP_VERILOG_TESTBENCH_INCLUDE_NETLIST_FILE_NAME_POSTFIX = "_include_netlists.v";
 constexpr char* VERILOG_TOP_POSTFIX = "_top.v";
 constexpr char* FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX = "_top_formal_verification.v"; 
+constexpr char* FORMAL_VERIFICATION_BITSTREAM_FILE_POSTFIX = "_top_formal_verification_bitstream.mem"; 
 constexpr char* TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_top_tb.v"; /* !!! must be consist with the modelsim_testbench_module_postfix */ 
 constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_autocheck_top_tb.v"; /* !!! must be consist with the modelsim_autocheck_testbench_module_postfix */ 
+constexpr char* AUTOCHECK_TOP_TESTBENCH_BITSTREAM_FILE_POSTFIX = "_autocheck_top_tb_bitstream.mem"; 
 constexpr char* RANDOM_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_formal_random_top_tb.v"; 
 constexpr char* DEFINES_VERILOG_FILE_NAME = "fpga_defines.v";
 constexpr char* DEFINES_VERILOG_SIMULATION_FILE_NAME = "define_simulation.v";
@@ -2,12 +2,14 @@
  * This file includes functions that are used to generate
  * a Verilog module of a pre-configured FPGA fabric
  *******************************************************************/
+#include <algorithm>
 #include <fstream>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_vector.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
@@ -27,6 +29,8 @@
 namespace openfpga
 {
 
+  constexpr char *PRECONFIG_TOP_MODULE_BITSTREAM_MEM_REG_NAME = "bitstream_mem";
+
   /********************************************************************
  * Print module declaration and ports for the pre-configured
  * FPGA top module
@@ -181,15 +185,141 @@ namespace openfpga
     fp << std::endl;
   }
 
+  /********************************************************************
+ * Build the hierarchical paths of all the configurable blocks
+ * in a single depth-first search on the bitstream manager.
+ * The path of a block is extended from the path of its parent,
+ * so that each path is built only once.
+ * The top-level block is replaced by the instance name of the FPGA fabric,
+ * and each path ends with a dot, to be appended by a port name, e.g.,
+ *   U0_formal_verification.grid_clb_1__1_.
+ *******************************************************************/
+  static vtr::vector<ConfigBlockId, std::string> build_preconfig_top_module_block_paths(const ModuleManager &module_manager,
+                                                                                        const ModuleId &top_module,
+                                                                                        const BitstreamManager &bitstream_manager)
+  {
+    vtr::vector<ConfigBlockId, std::string> block_paths(bitstream_manager.num_blocks());
+
+    std::vector<ConfigBlockId> block_stack;
+    for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
+    {
+      if (true == bitstream_manager.valid_block_id(bitstream_manager.block_parent(config_block_id)))
+      {
+        continue;
+      }
+      /* Ensure that this is the top module, which is replaced by the instance name here */
+      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(config_block_id)));
+      block_paths[config_block_id] = std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME) + std::string(".");
+      block_stack.push_back(config_block_id);
+    }
+
+    while (!block_stack.empty())
+    {
+      ConfigBlockId parent_block = block_stack.back();
+      block_stack.pop_back();
+      for (const ConfigBlockId &child_block : bitstream_manager.block_children(parent_block))
+      {
+        block_paths[child_block] = block_paths[parent_block] + bitstream_manager.block_name(child_block) + std::string(".");
+        block_stack.push_back(child_block);
+      }
+    }
+
+    return block_paths;
+  }
+
+  /********************************************************************
+ * Assign each configurable block with configuration bits a word
+ * in the bitstream memory, and write the bitstream memory file
+ * to be loaded by $readmemb
+ * Each line of the file contains the bits of a block, padded with
+ * zeros to the width of the widest block.
+ * Return the index table, where blocks without any bit are not in the memory.
+ *******************************************************************/
+  static vtr::vector<ConfigBlockId, size_t> write_preconfig_top_module_bitstream_memory_file(const std::string &bitstream_memory_fname,
+                                                                                            const BitstreamManager &bitstream_manager,
+                                                                                            size_t &memory_word_size)
+  {
+    vtr::vector<ConfigBlockId, size_t> block_memory_words(bitstream_manager.num_blocks(), size_t(-1));
+
+    memory_word_size = 0;
+    size_t num_words = 0;
+    for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
+    {
+      size_t num_block_bits = bitstream_manager.block_bits(config_block_id).size();
+      if (0 == num_block_bits)
+      {
+        continue;
+      }
+      block_memory_words[config_block_id] = num_words;
+      num_words++;
+      memory_word_size = std::max(memory_word_size, num_block_bits);
+    }
+
+    std::fstream mem_fp;
+    mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+
+    std::string line;
+    for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
+    {
+      if (size_t(-1) == block_memory_words[config_block_id])
+      {
+        continue;
+      }
+      line.assign(memory_word_size, '0');
+      size_t ibit = 0;
+      for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id))
+      {
+        if (true == bitstream_manager.bit_value(config_bit))
+        {
+          line[ibit] = '1';
+        }
+        ibit++;
+      }
+      mem_fp << line << "\n";
+    }
+
+    mem_fp.close();
+
+    return block_memory_words;
+  }
+
+  /********************************************************************
+ * Generate the word of the bitstream memory for a configurable block, e.g.,
+ *   bitstream_mem[<word>][0:<num_block_bits>-1]
+ *******************************************************************/
+  static std::string generate_preconfig_top_module_bitstream_memory_word(const size_t &word,
+                                                                         const size_t &num_block_bits)
+  {
+    return std::string(PRECONFIG_TOP_MODULE_BITSTREAM_MEM_REG_NAME) + std::string("[") + std::to_string(word) + std::string("]") + std::string("[0:") + std::to_string(num_block_bits - 1) + std::string("]");
+  }
+
+  /********************************************************************
+ * Load the bitstream memory from file, which should be the first
+ * statement of the initial block imposing the bitstream
+ *******************************************************************/
+  static void print_verilog_preconfig_top_module_read_bitstream_memory(std::fstream &fp,
+                                                                       const std::string &bitstream_memory_fname)
+  {
+    if (true == bitstream_memory_fname.empty())
+    {
+      return;
+    }
+    fp << "\t$readmemb(\"" << bitstream_memory_fname << "\", " << std::string(PRECONFIG_TOP_MODULE_BITSTREAM_MEM_REG_NAME) << ");" << std::endl;
+  }
+
   /********************************************************************
  * Impose the bitstream on the configuration memories
  * This function uses 'assign' syntax to impost the bitstream at mem port
  * while uses 'force' syntax to impost the bitstream at mem_inv port
+ * When a bitstream memory file is used, the values are taken from
+ * the bitstream memory rather than constants
  *******************************************************************/
   static void print_verilog_preconfig_top_module_assign_bitstream(std::fstream &fp,
-                                                                  const ModuleManager &module_manager,
-                                                                  const ModuleId &top_module,
-                                                                  const BitstreamManager &bitstream_manager)
+                                                                  const BitstreamManager &bitstream_manager,
+                                                                  const vtr::vector<ConfigBlockId, std::string> &block_paths,
+                                                                  const std::string &bitstream_memory_fname,
+                                                                  const vtr::vector<ConfigBlockId, size_t> &block_memory_words)
   {
     /* Validate the file stream */
     valid_file_stream(fp);
@@ -203,25 +333,19 @@ namespace openfpga
       {
         continue;
       }
-      /* Build the hierarchical path of the configuration bit in modules */
-      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-      /* Ensure that this is the module we want to drop! */
-      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-      block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
-      {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-      }
-      bit_hierarchy_path += std::string(".");
 
       /* Find the bit index in the parent block */
-      BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
+      BasicPort config_data_port(block_paths[config_block_id] + generate_configurable_memory_data_out_name(),
                                  bitstream_manager.block_bits(config_block_id).size());
 
+      if (false == bitstream_memory_fname.empty())
+      {
+        fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, config_data_port);
+        fp << " = " << generate_preconfig_top_module_bitstream_memory_word(block_memory_words[config_block_id], config_data_port.get_width());
+        fp << ";" << std::endl;
+        continue;
+      }
+
       /* Wire it to the configuration bit: access both data out and data outb ports */
       std::vector<size_t> config_data_values;
       for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id))
@@ -233,6 +357,8 @@ namespace openfpga
 
     fp << "initial begin" << std::endl;
 
+    print_verilog_preconfig_top_module_read_bitstream_memory(fp, bitstream_memory_fname);
+
     for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
     {
       /* We only cares blocks with configuration bits */
@@ -240,25 +366,19 @@ namespace openfpga
       {
         continue;
       }
-      /* Build the hierarchical path of the configuration bit in modules */
-      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-      /* Ensure that this is the module we want to drop! */
-      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-      block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
-      {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-      }
-      bit_hierarchy_path += std::string(".");
 
       /* Find the bit index in the parent block */
-      BasicPort config_datab_port(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(),
+      BasicPort config_datab_port(block_paths[config_block_id] + generate_configurable_memory_inverted_data_out_name(),
                                   bitstream_manager.block_bits(config_block_id).size());
 
+      if (false == bitstream_memory_fname.empty())
+      {
+        fp << "\tforce " << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_port);
+        fp << " = ~" << generate_preconfig_top_module_bitstream_memory_word(block_memory_words[config_block_id], config_datab_port.get_width());
+        fp << ";" << std::endl;
+        continue;
+      }
+
       std::vector<size_t> config_datab_values;
       for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id))
       {
@@ -275,11 +395,14 @@ namespace openfpga
   /********************************************************************
  * Impose the bitstream on the configuration memories
  * This function uses '$deposit' syntax to do so
+ * When a bitstream memory file is used, the values are taken from
+ * the bitstream memory rather than constants
  *******************************************************************/
   static void print_verilog_preconfig_top_module_deposit_bitstream(std::fstream &fp,
-                                                                   const ModuleManager &module_manager,
-                                                                   const ModuleId &top_module,
-                                                                   const BitstreamManager &bitstream_manager)
+                                                                   const BitstreamManager &bitstream_manager,
+                                                                   const vtr::vector<ConfigBlockId, std::string> &block_paths,
+                                                                   const std::string &bitstream_memory_fname,
+                                                                   const vtr::vector<ConfigBlockId, size_t> &block_memory_words)
   {
     /* Validate the file stream */
     valid_file_stream(fp);
@@ -288,6 +411,8 @@ namespace openfpga
 
     fp << "initial begin" << std::endl;
 
+    print_verilog_preconfig_top_module_read_bitstream_memory(fp, bitstream_memory_fname);
+
     for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
     {
       /* We only cares blocks with configuration bits */
@@ -295,28 +420,24 @@ namespace openfpga
       {
         continue;
       }
-      /* Build the hierarchical path of the configuration bit in modules */
-      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-      /* Ensure that this is the module we want to drop! */
-      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-      block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
-      {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-      }
-      bit_hierarchy_path += std::string(".");
 
       /* Find the bit index in the parent block */
-      BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
+      BasicPort config_data_port(block_paths[config_block_id] + generate_configurable_memory_data_out_name(),
                                  bitstream_manager.block_bits(config_block_id).size());
 
-      BasicPort config_datab_port(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(),
+      BasicPort config_datab_port(block_paths[config_block_id] + generate_configurable_memory_inverted_data_out_name(),
                                   bitstream_manager.block_bits(config_block_id).size());
 
+      if (false == bitstream_memory_fname.empty())
+      {
+        std::string memory_word = generate_preconfig_top_module_bitstream_memory_word(block_memory_words[config_block_id], config_data_port.get_width());
+        fp << "\t$deposit(" << generate_verilog_port(VERILOG_PORT_CONKT, config_data_port);
+        fp << ", " << memory_word << ");" << std::endl;
+        fp << "\t$deposit(" << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_port);
+        fp << ", ~" << memory_word << ");" << std::endl;
+        continue;
+      }
+
       /* Wire it to the configuration bit: access both data out and data outb ports */
       std::vector<size_t> config_data_values;
       for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id))
@@ -343,23 +464,45 @@ namespace openfpga
  * We branch here for different simulators:
  * 1. iVerilog Icarus prefers using 'assign' syntax to force the values
  * 2. Mentor Modelsim prefers using '$deposit' syntax to do so
+ * When a bitstream memory file is specified, the bitstream is written 
+ * to the file and loaded by $readmemb, so that the size of netlist
+ * only depends on the number of configurable blocks
  *******************************************************************/
   static void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
                                                                 const ModuleManager &module_manager,
                                                                 const ModuleId &top_module,
-                                                                const BitstreamManager &bitstream_manager)
+                                                                const BitstreamManager &bitstream_manager,
+                                                                const std::string &bitstream_memory_fname)
   {
     print_verilog_comment(fp, std::string("----- Begin load bitstream to configuration memories -----"));
 
+    /* Hierarchical paths are shared by all the simulators */
+    vtr::vector<ConfigBlockId, std::string> block_paths = build_preconfig_top_module_block_paths(module_manager, top_module, bitstream_manager);
+
+    vtr::vector<ConfigBlockId, size_t> block_memory_words;
+    if (false == bitstream_memory_fname.empty())
+    {
+      size_t memory_word_size = 0;
+      block_memory_words = write_preconfig_top_module_bitstream_memory_file(bitstream_memory_fname, bitstream_manager, memory_word_size);
+      size_t num_words = bitstream_manager.num_blocks() - std::count(block_memory_words.begin(), block_memory_words.end(), size_t(-1));
+      if (0 < num_words)
+      {
+        fp << "reg [0:" << memory_word_size - 1 << "] " << std::string(PRECONFIG_TOP_MODULE_BITSTREAM_MEM_REG_NAME);
+        fp << "[0:" << num_words - 1 << "];" << std::endl;
+      }
+    }
+
     print_verilog_preprocessing_flag(fp, std::string(ICARUS_SIMULATOR_FLAG));
 
     /* Use assign syntax for Icarus simulator */
-    print_verilog_preconfig_top_module_assign_bitstream(fp, module_manager, top_module, bitstream_manager);
+    print_verilog_preconfig_top_module_assign_bitstream(fp, bitstream_manager, block_paths,
+                                                        bitstream_memory_fname, block_memory_words);
 
     fp << "`else" << std::endl;
 
     /* Use assign syntax for Icarus simulator */
-    print_verilog_preconfig_top_module_deposit_bitstream(fp, module_manager, top_module, bitstream_manager);
+    print_verilog_preconfig_top_module_deposit_bitstream(fp, bitstream_manager, block_paths,
+                                                         bitstream_memory_fname, block_memory_words);
 
     print_verilog_endif(fp);
 
@@ -408,6 +551,7 @@ namespace openfpga
                                           const VprNetlistAnnotation &netlist_annotation,
                                           const std::string &circuit_name,
                                           const std::string &verilog_fname,
+                                          const std::string &bitstream_memory_fname,
                                           const bool &explicit_port_mapping)
   {
     std::string timer_message = std::string("Write pre-configured FPGA top-level Verilog netlist for design '") + circuit_name + std::string("'");
@@ -459,7 +603,8 @@ namespace openfpga
 
     /* Assign FPGA internal SRAM/Memory ports to bitstream values */
     print_verilog_preconfig_top_module_load_bitstream(fp, module_manager, top_module,
-                                                      bitstream_manager);
+                                                      bitstream_manager,
+                                                      bitstream_memory_fname);
 
     /* Testbench ends*/
     print_verilog_module_end(fp, std::string(circuit_name) + std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX));
@@ -19,6 +19,7 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   print_preconfig_top_testbench_ = false;
   print_formal_verification_top_netlist_ = false;
   print_top_testbench_ = false;
+  use_bitstream_memory_file_ = false;
   simulation_ini_path_.clear();
   explicit_port_mapping_ = false;
   verbose_output_ = false;
@@ -55,6 +56,10 @@ bool VerilogTestbenchOption::fast_configuration() const {
   return fast_configuration_;
 }
 
+bool VerilogTestbenchOption::use_bitstream_memory_file() const {
+  return use_bitstream_memory_file_;
+}
+
 bool VerilogTestbenchOption::print_simulation_ini() const {
   return !simulation_ini_path_.empty();
 }
@@ -99,6 +104,10 @@ void VerilogTestbenchOption::set_fast_configuration(const bool& enabled) {
   fast_configuration_ = enabled;
 }
 
+void VerilogTestbenchOption::set_use_bitstream_memory_file(const bool& enabled) {
+  use_bitstream_memory_file_ = enabled;
+}
+
 void VerilogTestbenchOption::set_print_preconfig_top_testbench(const bool& enabled) {
   print_preconfig_top_testbench_ = enabled
                                  && (!reference_benchmark_file_path_.empty());
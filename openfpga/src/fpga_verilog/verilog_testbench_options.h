@@ -26,6 +26,7 @@ class VerilogTestbenchOption {
     std::string fabric_netlist_file_path() const;
     std::string reference_benchmark_file_path() const;
     bool fast_configuration() const;
+    bool use_bitstream_memory_file() const;
     bool print_formal_verification_top_netlist() const;
     bool print_preconfig_top_testbench() const;
     bool print_top_testbench() const;
@@ -51,6 +52,8 @@ class VerilogTestbenchOption {
     /* The preconfig top testbench generation can be enabled only when formal verification top netlist is enabled */
     void set_print_preconfig_top_testbench(const bool& enabled);
     void set_fast_configuration(const bool& enabled);
+    /* Load bitstream in the full testbench from a memory file rather than a task call per configuration bit */
+    void set_use_bitstream_memory_file(const bool& enabled);
     void set_print_top_testbench(const bool& enabled);
     void set_print_simulation_ini(const std::string& simulation_ini_path);
     void set_explicit_port_mapping(const bool& enabled);
@@ -60,6 +63,7 @@ class VerilogTestbenchOption {
     std::string fabric_netlist_file_path_;
     std::string reference_benchmark_file_path_;
     bool fast_configuration_;
+    bool use_bitstream_memory_file_;
     bool print_formal_verification_top_netlist_;
     bool print_preconfig_top_testbench_;
     bool print_top_testbench_;
@@ -58,6 +58,8 @@ constexpr char* TOP_TB_CONFIG_DONE_PORT_NAME = "config_done";
 constexpr char* TOP_TB_OP_CLOCK_PORT_NAME = "op_clock";
 constexpr char* TOP_TB_PROG_CLOCK_PORT_NAME = "prog_clock";
 constexpr char* TOP_TB_INOUT_REG_POSTFIX = "_reg";
+constexpr char* TOP_TB_BITSTREAM_MEM_REG_NAME = "bitstream_mem";
+constexpr char* TOP_TB_BITSTREAM_INDEX_REG_NAME = "bitstream_index";
 constexpr char* TOP_TB_CLOCK_REG_POSTFIX = "_reg";
 
 constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX = "_autocheck_top_tb";
@@ -1358,6 +1360,151 @@ bool find_bit_value_to_skip_for_fast_configuration(const e_config_protocol_type&
   return bit_value_to_skip;
 }
 
+/********************************************************************
+ * Declare the memory which holds the bitstream loaded from a memory file
+ * Each word of the memory is the data to be fed in a programming cycle
+ * Note that this should be outputted outside any initial block
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_memory_declaration(std::fstream& fp,
+                                                              const size_t& word_size,
+                                                              const size_t& num_words) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Nothing to load, no memory is required */
+  if (0 == num_words) {
+    return;
+  }
+
+  print_verilog_comment(fp, "----- Bitstream memory to be loaded from file -----");
+  fp << "reg [0:" << word_size - 1 << "] " << std::string(TOP_TB_BITSTREAM_MEM_REG_NAME);
+  fp << "[0:" << num_words - 1 << "];" << std::endl;
+  fp << "integer " << std::string(TOP_TB_BITSTREAM_INDEX_REG_NAME) << ";" << std::endl;
+
+  /* Add an empty line as splitter */
+  fp << std::endl;
+}
+
+/********************************************************************
+ * Load the bitstream memory from a file and feed each word to 
+ * the programming task in a loop.
+ * Each word is split into the arguments of the task, 
+ * whose widths are given in the sequence of the arguments
+ * For example, for memory bank protocol:
+ *   $readmemb("<memory_file>", bitstream_mem);
+ *   for (bitstream_index = 0; bitstream_index < <num_words>; bitstream_index = bitstream_index + 1) begin
+ *     prog_cycle_task(bitstream_mem[bitstream_index][0:<bl>-1],
+ *                     bitstream_mem[bitstream_index][<bl>:<bl>+<wl>-1],
+ *                     bitstream_mem[bitstream_index][<bl>+<wl>:<bl>+<wl>]);
+ *   end
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_memory_loop(std::fstream& fp,
+                                                       const std::string& bitstream_memory_fname,
+                                                       const std::vector<size_t>& task_arg_widths,
+                                                       const size_t& num_words) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  if (0 == num_words) {
+    return;
+  }
+
+  std::string mem_word = std::string(TOP_TB_BITSTREAM_MEM_REG_NAME) + std::string("[") + std::string(TOP_TB_BITSTREAM_INDEX_REG_NAME) + std::string("]");
+
+  print_verilog_comment(fp, "----- Load bitstream from memory file -----");
+  fp << "\t\t$readmemb(\"" << bitstream_memory_fname << "\", " << std::string(TOP_TB_BITSTREAM_MEM_REG_NAME) << ");" << std::endl;
+  fp << "\t\tfor (" << std::string(TOP_TB_BITSTREAM_INDEX_REG_NAME) << " = 0; ";
+  fp << std::string(TOP_TB_BITSTREAM_INDEX_REG_NAME) << " < " << num_words << "; ";
+  fp << std::string(TOP_TB_BITSTREAM_INDEX_REG_NAME) << " = " << std::string(TOP_TB_BITSTREAM_INDEX_REG_NAME) << " + 1) begin" << std::endl;
+  fp << "\t\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << "(";
+  size_t lsb = 0;
+  for (size_t iarg = 0; iarg < task_arg_widths.size(); ++iarg) {
+    if (0 < iarg) {
+      fp << ", ";
+    }
+    fp << mem_word << "[" << lsb << ":" << lsb + task_arg_widths[iarg] - 1 << "]";
+    lsb += task_arg_widths[iarg];
+  }
+  fp << ");" << std::endl;
+  fp << "\t\tend" << std::endl;
+}
+
+/********************************************************************
+ * Write the bitstream of a configuration chain protocol to a memory file,
+ * which can be loaded by $readmemb
+ * Each line contains the values to be fed to the heads of 
+ * configuration regions in a programming cycle
+ * Return the number of words (lines) in the memory file
+ *******************************************************************/
+static
+size_t write_configuration_chain_bitstream_memory_file(const std::string& bitstream_memory_fname,
+                                                       const std::vector<std::vector<bool>>& regional_bitstreams,
+                                                       const size_t& num_bits_to_skip,
+                                                       const size_t& regional_bitstream_size) {
+  std::fstream mem_fp;
+  mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+
+  size_t num_words = 0;
+  for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_size; ++ibit) { 
+    for (const auto& region_bitstream : regional_bitstreams) {
+      mem_fp << (region_bitstream[ibit] ? '1' : '0');
+    }
+    mem_fp << "\n";
+    num_words++;
+  }
+
+  mem_fp.close();
+
+  return num_words;
+}
+
+/********************************************************************
+ * Write the bitstream of a memory bank or a frame-based protocol 
+ * to a memory file, which can be loaded by $readmemb
+ * Each line contains the address(es) and data input to be fed 
+ * in a programming cycle:
+ * - Memory bank: <BL address><WL address><din>
+ * - Frame-based: <address><din>
+ * Return the number of words (lines) in the memory file
+ *******************************************************************/
+static
+size_t write_address_bitstream_memory_file(const std::string& bitstream_memory_fname,
+                                           const bool& fast_configuration,
+                                           const bool& bit_value_to_skip,
+                                           const FabricBitstream& fabric_bitstream) {
+  std::fstream mem_fp;
+  mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+
+  size_t num_words = 0;
+  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+    /* When fast configuration is enabled, we skip zero data_in values */
+    if ((true == fast_configuration)
+      && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
+      continue;
+    }
+
+    for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
+      mem_fp << addr_bit;
+    }
+    if (true == fabric_bitstream.use_wl_address()) {
+      for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
+        mem_fp << addr_bit;
+      }
+    }
+    mem_fp << (fabric_bitstream.bit_din(bit_id) ? '1' : '0');
+    mem_fp << "\n";
+    num_words++;
+  }
+
+  mem_fp.close();
+
+  return num_words;
+}
+
 /********************************************************************
  * Print stimulus for a FPGA fabric with a configuration chain protocol
  * where configuration bits are programming in serial (one by one)
@@ -1377,7 +1524,8 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
                                                                const ModuleManager& module_manager,
                                                                const ModuleId& top_module,
                                                                const BitstreamManager& bitstream_manager,
-                                                               const FabricBitstream& fabric_bitstream) {
+                                                               const FabricBitstream& fabric_bitstream,
+                                                               const std::string& bitstream_memory_fname) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1391,16 +1539,6 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
   BasicPort config_chain_head_port = module_manager.module_port(top_module, cc_head_port_id);
   std::vector<size_t> initial_values(config_chain_head_port.get_width(), 0);
 
-  print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
-  print_verilog_comment(fp, "----- Configuration chain default input -----");
-  fp << "\t\t";
-  fp << generate_verilog_port_constant_values(config_chain_head_port, initial_values);
-  fp << ";";
-
-  fp << std::endl;
-
   /* Find the longest bitstream */
   size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
 
@@ -1431,6 +1569,26 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
     regional_bitstreams.push_back(curr_regional_bitstream);
   }
 
+  /* Write the bitstream to a memory file, which will be loaded by the testbench */
+  size_t num_memory_words = 0;
+  if (false == bitstream_memory_fname.empty()) {
+    num_memory_words = write_configuration_chain_bitstream_memory_file(bitstream_memory_fname,
+                                                                       regional_bitstreams,
+                                                                       num_bits_to_skip,
+                                                                       regional_bitstream_max_size);
+    print_verilog_top_testbench_bitstream_memory_declaration(fp, regional_bitstreams.size(), num_memory_words);
+  }
+
+  print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
+  fp << "initial" << std::endl;
+  fp << "\tbegin" << std::endl;
+  print_verilog_comment(fp, "----- Configuration chain default input -----");
+  fp << "\t\t";
+  fp << generate_verilog_port_constant_values(config_chain_head_port, initial_values);
+  fp << ";";
+
+  fp << std::endl;
+
   /* Attention: when the fast configuration is enabled, we will start from the first bit '1'
    * This requires a reset signal (as we forced in the first clock cycle)
    *
@@ -1446,15 +1604,21 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
    *   Zero bits will be added to the head of those bitstreams are shorter 
    *   than the longest bitstream
    */
-  for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size; ++ibit) { 
-    std::vector<size_t> curr_cc_head_val;
-    curr_cc_head_val.reserve(fabric_bitstream.regions().size());
-    for (const auto& region_bitstream : regional_bitstreams) {
-      curr_cc_head_val.push_back((size_t)region_bitstream[ibit]);
-    }
+  if (false == bitstream_memory_fname.empty()) {
+    print_verilog_top_testbench_bitstream_memory_loop(fp, bitstream_memory_fname,
+                                                      std::vector<size_t>(1, regional_bitstreams.size()),
+                                                      num_memory_words);
+  } else {
+    for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size; ++ibit) { 
+      std::vector<size_t> curr_cc_head_val;
+      curr_cc_head_val.reserve(fabric_bitstream.regions().size());
+      for (const auto& region_bitstream : regional_bitstreams) {
+        curr_cc_head_val.push_back((size_t)region_bitstream[ibit]);
+      }
 
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(" << generate_verilog_constant_values(curr_cc_head_val) << ");" << std::endl;
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+      fp << "(" << generate_verilog_constant_values(curr_cc_head_val) << ");" << std::endl;
+    }
   }
 
   /* Raise the flag of configuration done when bitstream loading is complete */
@@ -1485,7 +1649,8 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
                                                        const bool& bit_value_to_skip,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const FabricBitstream& fabric_bitstream) {
+                                                       const FabricBitstream& fabric_bitstream,
+                                                       const std::string& bitstream_memory_fname) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1508,6 +1673,18 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
+  /* Write the bitstream to a memory file, which will be loaded by the testbench */
+  size_t num_memory_words = 0;
+  if (false == bitstream_memory_fname.empty()) {
+    num_memory_words = write_address_bitstream_memory_file(bitstream_memory_fname,
+                                                           fast_configuration,
+                                                           bit_value_to_skip,
+                                                           fabric_bitstream);
+    print_verilog_top_testbench_bitstream_memory_declaration(fp,
+                                                             bl_addr_port.get_width() + wl_addr_port.get_width() + 1,
+                                                             num_memory_words);
+  }
+
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
   fp << "initial" << std::endl;
   fp << "\tbegin" << std::endl;
@@ -1531,36 +1708,42 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
   /* Attention: the configuration chain protcol requires the last configuration bit is fed first
    * We will visit the fabric bitstream in a reverse way
    */
-  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-    /* When fast configuration is enabled, we skip zero data_in values */
-    if ((true == fast_configuration)
-      && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
-      continue;
-    }
+  if (false == bitstream_memory_fname.empty()) {
+    print_verilog_top_testbench_bitstream_memory_loop(fp, bitstream_memory_fname,
+                                                      {bl_addr_port.get_width(), wl_addr_port.get_width(), 1},
+                                                      num_memory_words);
+  } else {
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      /* When fast configuration is enabled, we skip zero data_in values */
+      if ((true == fast_configuration)
+        && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
+        continue;
+      }
 
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(" << bl_addr_port.get_width() << "'b";
-    VTR_ASSERT(bl_addr_port.get_width() == fabric_bitstream.bit_bl_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
-      fp << addr_bit;
-    }
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+      fp << "(" << bl_addr_port.get_width() << "'b";
+      VTR_ASSERT(bl_addr_port.get_width() == fabric_bitstream.bit_bl_address(bit_id).size());
+      for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
+        fp << addr_bit;
+      }
 
-    fp << ", ";
-    fp << wl_addr_port.get_width() << "'b";
-    VTR_ASSERT(wl_addr_port.get_width() == fabric_bitstream.bit_wl_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-      fp << addr_bit;
-    }
+      fp << ", ";
+      fp << wl_addr_port.get_width() << "'b";
+      VTR_ASSERT(wl_addr_port.get_width() == fabric_bitstream.bit_wl_address(bit_id).size());
+      for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
+        fp << addr_bit;
+      }
 
-    fp << ", ";
-    fp <<"1'b";
-    if (true == fabric_bitstream.bit_din(bit_id)) {
-      fp << "1";
-    } else {
-      VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
-      fp << "0";
+      fp << ", ";
+      fp <<"1'b";
+      if (true == fabric_bitstream.bit_din(bit_id)) {
+        fp << "1";
+      } else {
+        VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
+        fp << "0";
+      }
+      fp << ");" << std::endl;
     }
-    fp << ");" << std::endl;
   }
 
   /* Raise the flag of configuration done when bitstream loading is complete */
@@ -1591,7 +1774,8 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
                                                          const bool& bit_value_to_skip,
                                                          const ModuleManager& module_manager,
                                                          const ModuleId& top_module,
-                                                         const FabricBitstream& fabric_bitstream) {
+                                                         const FabricBitstream& fabric_bitstream,
+                                                         const std::string& bitstream_memory_fname) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1609,6 +1793,18 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
+  /* Write the bitstream to a memory file, which will be loaded by the testbench */
+  size_t num_memory_words = 0;
+  if (false == bitstream_memory_fname.empty()) {
+    num_memory_words = write_address_bitstream_memory_file(bitstream_memory_fname,
+                                                           fast_configuration,
+                                                           bit_value_to_skip,
+                                                           fabric_bitstream);
+    print_verilog_top_testbench_bitstream_memory_declaration(fp,
+                                                             addr_port.get_width() + 1,
+                                                             num_memory_words);
+  }
+
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
   fp << "initial" << std::endl;
   fp << "\tbegin" << std::endl;
@@ -1628,28 +1824,34 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   /* Attention: the configuration chain protcol requires the last configuration bit is fed first
    * We will visit the fabric bitstream in a reverse way
    */
-  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-    /* When fast configuration is enabled, we skip zero data_in values */
-    if ((true == fast_configuration)
-      && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
-      continue;
-    }
+  if (false == bitstream_memory_fname.empty()) {
+    print_verilog_top_testbench_bitstream_memory_loop(fp, bitstream_memory_fname,
+                                                      {addr_port.get_width(), 1},
+                                                      num_memory_words);
+  } else {
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      /* When fast configuration is enabled, we skip zero data_in values */
+      if ((true == fast_configuration)
+        && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
+        continue;
+      }
 
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(" << addr_port.get_width() << "'b";
-    VTR_ASSERT(addr_port.get_width() == fabric_bitstream.bit_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
-      fp << addr_bit;
-    }
-    fp << ", ";
-    fp <<"1'b";
-    if (true == fabric_bitstream.bit_din(bit_id)) {
-      fp << "1";
-    } else {
-      VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
-      fp << "0";
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+      fp << "(" << addr_port.get_width() << "'b";
+      VTR_ASSERT(addr_port.get_width() == fabric_bitstream.bit_address(bit_id).size());
+      for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
+        fp << addr_bit;
+      }
+      fp << ", ";
+      fp <<"1'b";
+      if (true == fabric_bitstream.bit_din(bit_id)) {
+        fp << "1";
+      } else {
+        VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
+        fp << "0";
+      }
+      fp << ");" << std::endl;
     }
-    fp << ");" << std::endl;
   }
 
   /* Disable the address and din */
@@ -1693,7 +1895,8 @@ void print_verilog_top_testbench_bitstream(std::fstream& fp,
                                            const ModuleManager& module_manager,
                                            const ModuleId& top_module,
                                            const BitstreamManager& bitstream_manager,
-                                           const FabricBitstream& fabric_bitstream) {
+                                           const FabricBitstream& fabric_bitstream,
+                                           const std::string& bitstream_memory_fname) {
 
   /* Branch on the type of configuration protocol */
   switch (config_protocol_type) {
@@ -1706,19 +1909,22 @@ void print_verilog_top_testbench_bitstream(std::fstream& fp,
     print_verilog_top_testbench_configuration_chain_bitstream(fp, fast_configuration, 
                                                               bit_value_to_skip,
                                                               module_manager, top_module,
-                                                              bitstream_manager, fabric_bitstream);
+                                                              bitstream_manager, fabric_bitstream,
+                                                              bitstream_memory_fname);
     break;
   case CONFIG_MEM_MEMORY_BANK:
     print_verilog_top_testbench_memory_bank_bitstream(fp, fast_configuration,
                                                       bit_value_to_skip,
                                                       module_manager, top_module,
-                                                      fabric_bitstream);
+                                                      fabric_bitstream,
+                                                      bitstream_memory_fname);
     break;
   case CONFIG_MEM_FRAME_BASED:
     print_verilog_top_testbench_frame_decoder_bitstream(fp, fast_configuration,
                                                         bit_value_to_skip,
                                                         module_manager, top_module,
-                                                        fabric_bitstream);
+                                                        fabric_bitstream,
+                                                        bitstream_memory_fname);
     break;
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -1797,6 +2003,7 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const VprNetlistAnnotation& netlist_annotation,
                                  const std::string& circuit_name,
                                  const std::string& verilog_fname,
+                                 const std::string& bitstream_memory_fname,
                                  const SimulationSetting& simulation_parameters,
                                  const bool& fast_configuration,
                                  const bool& explicit_port_mapping) {
@@ -1934,7 +2141,8 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                         apply_fast_configuration,
                                         bit_value_to_skip,
                                         module_manager, top_module,
-                                        bitstream_manager, fabric_bitstream);
+                                        bitstream_manager, fabric_bitstream,
+                                        bitstream_memory_fname);
 
   /* Add stimuli for reset, set, clock and iopad signals */
   print_verilog_testbench_random_stimuli(fp, atom_ctx,
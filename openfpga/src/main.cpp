@@ -40,6 +40,12 @@ int main(int argc, char** argv) {
   start_cmd.set_option_require_value(opt_script_mode, openfpga::OPT_STRING);
   start_cmd.set_option_short_name(opt_script_mode, "f");
 
+  openfpga::CommandOptionId opt_batch_exec = start_cmd.add_option("batch_execution", false, "Execute independent read-only commands of a script concurrently");
+  start_cmd.set_option_short_name(opt_batch_exec, "batch");
+
+  openfpga::CommandOptionId opt_profile_file = start_cmd.add_option("profile_file", false, "Write the runtime and memory usage of each executed command to a JSON file when exiting");
+  start_cmd.set_option_require_value(opt_profile_file, openfpga::OPT_STRING);
+
   openfpga::CommandOptionId opt_help = start_cmd.add_option("help", false, "Help desk"); 
   start_cmd.set_option_short_name(opt_help, "h");
 
@@ -92,6 +98,10 @@ int main(int argc, char** argv) {
     openfpga::print_command_options(start_cmd);
   } else {
     /* Parse succeed. Start a shell */ 
+    if (true == start_cmd_context.option_enable(start_cmd, opt_profile_file)) {
+      shell.set_profile_file(start_cmd_context.option_value(start_cmd, opt_profile_file));
+    }
+
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
 
       shell.run_interactive_mode(openfpga_context);
@@ -100,7 +110,8 @@ int main(int argc, char** argv) {
 
     if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
       shell.run_script_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
-                            openfpga_context);
+                            openfpga_context,
+                            start_cmd_context.option_enable(start_cmd, opt_batch_exec));
       return 0;
     }
     /* Reach here there is something wrong, show the help desk */
@@ -5,6 +5,10 @@
 
 #include "vtr_assert.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_decode.h"
+
+#include "decoder_library_utils.h"
 #include "mux_library.h"
 
 /* begin namespace openfpga */
@@ -56,6 +60,17 @@ size_t MuxLibrary::max_mux_size() const {
   return max_mux_size;
 }
 
+/* Get the bits to be loaded to a MUX which route an input to the output */
+std::vector<bool> MuxLibrary::mux_config_bits(const MuxId& mux_id, const MuxInputId& input_id) const {
+  VTR_ASSERT_SAFE(valid_mux_id(mux_id));
+  /* The table is built only for CMOS routing multiplexers */
+  VTR_ASSERT(size_t(input_id) < mux_graphs_[mux_id].num_inputs());
+  VTR_ASSERT(mux_config_bits_[mux_id].size() == mux_graphs_[mux_id].num_inputs() * mux_num_config_bits_[mux_id]);
+
+  auto begin = mux_config_bits_[mux_id].begin() + size_t(input_id) * mux_num_config_bits_[mux_id];
+  return std::vector<bool>(begin, begin + mux_num_config_bits_[mux_id]);
+}
+
 /**************************************************
  * Private mutators:
  *************************************************/
@@ -74,6 +89,10 @@ void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId
   mux_graphs_.push_back(MuxGraph(circuit_lib, circuit_model, mux_size));
   /* Recorde mux cirucit model id */
   mux_circuit_models_.push_back(circuit_model);
+  /* Precompute the configuration bits */
+  mux_num_config_bits_.push_back(0);
+  mux_config_bits_.emplace_back();
+  build_mux_config_bits(circuit_lib, mux);
 
   /* update mux_lookup*/
   mux_lookup_[circuit_model][mux_size] = mux;
@@ -118,4 +137,85 @@ void MuxLibrary::invalidate_mux_lookup() {
   mux_lookup_.clear();
 }
 
+/**************************************************
+ * Private mutators: configuration bits
+ *************************************************/
+
+/* Precompute the configuration bits of each input of a MUX,
+ * so that the bitstream of each MUX instance in the fabric
+ * is only a look-up in the tables
+ * Only CMOS routing multiplexers are considered, 
+ * as their bitstream is built by routing an input to the output
+ */
+void MuxLibrary::build_mux_config_bits(const CircuitLibrary& circuit_lib, const MuxId& mux) {
+  const CircuitModelId& circuit_model = mux_circuit_models_[mux];
+  if ( (CIRCUIT_MODEL_MUX != circuit_lib.model_type(circuit_model))
+    || (CIRCUIT_MODEL_DESIGN_CMOS != circuit_lib.design_tech_type(circuit_model)) ) {
+    return;
+  }
+
+  const MuxGraph& mux_graph = mux_graphs_[mux];
+  /* We should have only one output for this MUX! */
+  if (1 != mux_graph.num_outputs()) {
+    return;
+  }
+  MuxOutputId output_id = mux_graph.output_id(mux_graph.outputs()[0]);
+
+  bool use_local_encoder = circuit_lib.mux_use_local_encoder(circuit_model);
+
+  /* Find the number of bits of each input */
+  mux_num_config_bits_[mux] = 0;
+  for (const size_t& level : mux_graph.levels()) {
+    size_t num_mems = mux_graph.memories_at_level(level).size();
+    if ( (false == use_local_encoder) || (1 == num_mems) ) {
+      mux_num_config_bits_[mux] += num_mems;
+    } else {
+      mux_num_config_bits_[mux] += find_mux_local_decoder_addr_size(num_mems);
+    }
+  }
+
+  mux_config_bits_[mux].reserve(mux_graph.num_inputs() * mux_num_config_bits_[mux]);
+
+  for (size_t input = 0; input < mux_graph.num_inputs(); ++input) {
+    vtr::vector<MuxMemId, bool> raw_bits = mux_graph.decode_memory_bits(MuxInputId(input), output_id);
+    VTR_ASSERT(mux_graph.num_memory_bits() == raw_bits.size());
+
+    /* Encode the memory bits level by level,
+     * One local encoder is used for each level of multiplexers 
+     */
+    for (const size_t& level : mux_graph.levels()) {
+      std::vector<MuxMemId> mems = mux_graph.memories_at_level(level);
+
+      /* Without local encoders or with only 1 memory at this level, bitstream will not be changed!!! */
+      if ( (false == use_local_encoder) || (1 == mems.size()) ) {
+        for (const MuxMemId& mem : mems) {
+          mux_config_bits_[mux].push_back(raw_bits[mem]);
+        }
+        continue;
+      }
+
+      /* The encoder will convert the index of the memory bit '1' to a binary number 
+       * For example: when the 4th memory bit is '1', using a 2-input encoder 
+       * the sram_bits will be the 2-digit binary number of 3: 11
+       * There should be at most one '1'
+       */
+      size_t encoder_data = 0;
+      size_t num_ones = 0;
+      for (size_t mem_index = 0; mem_index < mems.size(); ++mem_index) {
+        if (true == raw_bits[mems[mem_index]]) {
+          encoder_data = mem_index;
+          num_ones++;
+        }
+      }
+      VTR_ASSERT(1 >= num_ones);
+
+      for (const size_t& bit : itobin_vec(encoder_data, find_mux_local_decoder_addr_size(mems.size()))) {
+        mux_config_bits_[mux].push_back(1 == bit);
+      }
+    }
+  }
+
+  VTR_ASSERT(mux_config_bits_[mux].size() == mux_graph.num_inputs() * mux_num_config_bits_[mux]);
+}
+
 } /* end namespace openfpga */
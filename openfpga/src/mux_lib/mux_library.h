@@ -32,6 +32,11 @@ class MuxLibrary {
     CircuitModelId mux_circuit_model(const MuxId& mux_id) const;
     /* Find the mux sizes */
     size_t max_mux_size() const;
+    /* Get the configuration bits to be loaded to a MUX which route an input to its output,
+     * which are the memory bits of the MUX graph encoded level by level when local encoders are used
+     * Note: only available for CMOS routing multiplexers with a single output
+     */
+    std::vector<bool> mux_config_bits(const MuxId& mux_id, const MuxInputId& input_id) const;
   public:  /* Public mutators */
     /* Add a mux to the library */
     void add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model, const size_t& mux_size); 
@@ -45,12 +50,21 @@ class MuxLibrary {
     void build_mux_lookup();
     /* Invalidate (empty) the mux fast lookup*/
     void invalidate_mux_lookup();
+  private:  /* Private mutators: configuration bits */
+    /* Precompute the configuration bits of each input of a MUX */
+    void build_mux_config_bits(const CircuitLibrary& circuit_lib, const MuxId& mux);
   private:  /* Internal data */
     /* MUX graph-based desription */
     vtr::vector<MuxId, MuxId> mux_ids_; /* Unique identifier for each mux graph */
     vtr::vector<MuxId, MuxGraph> mux_graphs_; /* Graphs describing MUX internal structures */
     vtr::vector<MuxId, CircuitModelId> mux_circuit_models_; /* circuit model id in circuit library */
 
+    /* Configuration bits of each input of a MUX, 
+     * the bits of input i are [i * num_bits, (i + 1) * num_bits) of the table
+     */
+    vtr::vector<MuxId, size_t> mux_num_config_bits_;
+    vtr::vector<MuxId, std::vector<bool>> mux_config_bits_;
+
     /* Local encoder description */
     //vtr::vector<MuxLocalDecoderId, Decoder> mux_local_encoders_; /* Graphs describing MUX internal structures */
 
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Memember functions for data structure LbRouteCache
+ ******************************************************************************/
+#include "vtr_assert.h"
+#include "vtr_hash.h"
+
+#include "lb_route_cache.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Accessors 
+ *************************************************/
+LbRouteCache::Signature LbRouteCache::signature(const t_pb_graph_node* pb_graph_head,
+                                                const LbRouter& lb_router) {
+  Signature signature;
+
+  signature.push_back(reinterpret_cast<size_t>(pb_graph_head));
+
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    signature.push_back(lb_router.net_sources(net).size());
+    for (const LbRRNodeId& node : lb_router.net_sources(net)) {
+      signature.push_back(size_t(node));
+    }
+    signature.push_back(lb_router.net_sinks(net).size());
+    for (const LbRRNodeId& node : lb_router.net_sinks(net)) {
+      signature.push_back(size_t(node));
+    }
+  }
+
+  return signature;
+}
+
+size_t LbRouteCache::num_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+size_t LbRouteCache::num_misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_misses_;
+}
+
+size_t LbRouteCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return net_routed_nodes_.size();
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+bool LbRouteCache::find(const Signature& signature,
+                        std::vector<std::vector<LbRRNodeId>>& net_routed_nodes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto result = net_routed_nodes_.find(signature);
+  if (result == net_routed_nodes_.end()) {
+    num_misses_++;
+    return false;
+  }
+
+  num_hits_++;
+  net_routed_nodes = result->second;
+  return true;
+}
+
+void LbRouteCache::add(const Signature& signature,
+                       const std::vector<std::vector<LbRRNodeId>>& net_routed_nodes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  /* Another thread may have routed the same problem in the meantime,
+   * the results are the same so we keep the first one
+   */
+  net_routed_nodes_.emplace(signature, net_routed_nodes);
+}
+
+/**************************************************
+ * Private Accessors
+ *************************************************/
+size_t LbRouteCache::SignatureHash::operator()(const Signature& signature) const {
+  size_t seed = signature.size();
+  for (const size_t& value : signature) {
+    vtr::hash_combine(seed, value);
+  }
+  return seed;
+}
+
+} /* end namespace openfpga */
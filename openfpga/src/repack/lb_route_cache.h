@@ -0,0 +1,85 @@
+#ifndef LB_ROUTE_CACHE_H
+#define LB_ROUTE_CACHE_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/* Headers from readarch library */
+#include "physical_types.h"
+
+#include "lb_rr_graph.h"
+#include "lb_router.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * LbRouteCache object stores the routing results of the LbRouter
+ * for each distinct routing problem met during repacking.
+ *
+ * Most clustered blocks of a design are the same routing problem
+ * for the LbRouter: the same pb_graph head (and hence lb_rr_graph),
+ * and the same source/sink nodes for each net in the same order.
+ * The router results only depend on these, so the routed nodes of each
+ * net can be reused for any clustered block with the same signature,
+ * no matter which atom nets are mapped to it.
+ *
+ * How to use the cache:
+ *
+ *  LbRouteCache::Signature signature = LbRouteCache::signature(pb_graph_head, lb_router);
+ *  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
+ *  if (false == route_cache.find(signature, net_routed_nodes)) {
+ *    // Run the router and collect the routed nodes of each net
+ *    route_cache.add(signature, net_routed_nodes);
+ *  }
+ *
+ * Note:
+ *  - The cache can be shared by multiple threads
+ *******************************************************************/
+class LbRouteCache {
+  public: /* Types */
+    /* Flattened routing problem:
+     * pb_graph head, followed by [num_sources, sources..., num_sinks, sinks...] of each net
+     */
+    typedef std::vector<size_t> Signature;
+  public: /* Public accessors */
+    static Signature signature(const t_pb_graph_node* pb_graph_head,
+                               const LbRouter& lb_router);
+
+    /* Return the number of lookups which are found/not found in the cache */
+    size_t num_hits() const;
+    size_t num_misses() const;
+
+    /* Return the number of distinct routing problems stored in the cache */
+    size_t size() const;
+
+  public: /* Public mutators */
+    /* Find the routed nodes of each net for a signature, 
+     * return false if the signature is not in the cache
+     */
+    bool find(const Signature& signature,
+              std::vector<std::vector<LbRRNodeId>>& net_routed_nodes);
+
+    void add(const Signature& signature,
+             const std::vector<std::vector<LbRRNodeId>>& net_routed_nodes);
+
+  private: /* Internal data */
+    struct SignatureHash {
+      size_t operator()(const Signature& signature) const;
+    };
+
+    mutable std::mutex mutex_;
+
+    std::unordered_map<Signature, std::vector<std::vector<LbRRNodeId>>, SignatureHash> net_routed_nodes_;
+
+    size_t num_hits_ = 0;
+    size_t num_misses_ = 0;
+};
+
+} /* End namespace openfpga*/
+
+#endif
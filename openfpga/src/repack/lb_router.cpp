@@ -48,6 +48,16 @@ AtomNetId LbRouter::net_atom_net_id(const NetId& net) const {
   return lb_net_atom_net_ids_[net]; 
 }
 
+const std::vector<LbRRNodeId>& LbRouter::net_sources(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sources_[net]; 
+}
+
+const std::vector<LbRRNodeId>& LbRouter::net_sinks(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sinks_[net]; 
+}
+
 std::vector<LbRRNodeId> LbRouter::find_congested_rr_nodes(const LbRRGraph& lb_rr_graph) const {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
@@ -74,8 +84,8 @@ std::vector<LbRRNodeId> LbRouter::net_routed_nodes(const NetId& net) const {
   std::vector<LbRRNodeId> routed_nodes;
 
   for (size_t isrc = 0; isrc < lb_net_sources_[net].size(); ++isrc) { 
-    t_trace* rt_tree = lb_net_rt_trees_[net][isrc];
-    if (nullptr == rt_tree) {
+    TraceId rt_tree = lb_net_rt_trees_[net][isrc];
+    if (TraceId::INVALID() == rt_tree) {
       return routed_nodes;
     }
     /* Walk through the routing tree of the net */
@@ -106,31 +116,30 @@ bool LbRouter::is_route_success(const LbRRGraph& lb_rr_graph) const {
   return true;
 }
 
-LbRouter::t_trace* LbRouter::find_node_in_rt(t_trace* rt, const LbRRNodeId& rt_index) {
-  t_trace* cur;
-  if (rt->current_node == rt_index) {
+LbRouter::TraceId LbRouter::find_node_in_rt(const TraceId& rt, const LbRRNodeId& rt_index) const {
+  if (traces_[rt].current_node == rt_index) {
     return rt;
   } else {
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-      cur = find_node_in_rt(&rt->next_nodes[i], rt_index);
-      if (cur != nullptr) {
+    for (TraceId next = traces_[rt].first_child; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+      TraceId cur = find_node_in_rt(next, rt_index);
+      if (cur != TraceId::INVALID()) {
         return cur;
       }
     }
   }
-  return nullptr;
+  return TraceId::INVALID();
 }
 
-bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) const {
+bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, const TraceId& rt) const {
   t_mode* cur_mode = nullptr;
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    std::vector<LbRREdgeId> edges = lb_rr_graph.find_edge(rt->current_node, rt->next_nodes[i].current_node);
+  for (TraceId next = traces_[rt].first_child; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    std::vector<LbRREdgeId> edges = lb_rr_graph.find_edge(traces_[rt].current_node, traces_[next].current_node);
     VTR_ASSERT(1 == edges.size());
     t_mode* new_mode = lb_rr_graph.edge_mode(edges[0]);
     if (cur_mode != nullptr && cur_mode != new_mode) {
       return true;
     }
-    if (route_has_conflict(lb_rr_graph, &rt->next_nodes[i]) == true) {
+    if (route_has_conflict(lb_rr_graph, next) == true) {
       return true;
     }
     cur_mode = new_mode;
@@ -139,13 +148,13 @@ bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) con
   return false;
 }
 
-void LbRouter::rec_collect_trace_nodes(const t_trace* trace, std::vector<LbRRNodeId>& routed_nodes) const {
-  if (routed_nodes.end() == std::find(routed_nodes.begin(), routed_nodes.end(), trace->current_node)) {
-    routed_nodes.push_back(trace->current_node);
+void LbRouter::rec_collect_trace_nodes(const TraceId& trace, std::vector<LbRRNodeId>& routed_nodes) const {
+  if (routed_nodes.end() == std::find(routed_nodes.begin(), routed_nodes.end(), traces_[trace].current_node)) {
+    routed_nodes.push_back(traces_[trace].current_node);
   }
 
-  for (const t_trace& next : trace->next_nodes) {
-    rec_collect_trace_nodes(&next, routed_nodes);
+  for (TraceId next = traces_[trace].first_child; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    rec_collect_trace_nodes(next, routed_nodes);
   }
 }
 
@@ -165,7 +174,7 @@ LbRouter::NetId LbRouter::create_net_to_route(const std::vector<LbRRNodeId>& sou
   
   lb_net_sources_.push_back(sources);
   lb_net_sinks_.push_back(terminals);
-  lb_net_rt_trees_.push_back(std::vector<t_trace*>(sources.size(), nullptr));
+  lb_net_rt_trees_.push_back(std::vector<TraceId>(sources.size(), TraceId::INVALID()));
 
   return net;
 }
@@ -181,6 +190,15 @@ void LbRouter::add_net_atom_pins(const NetId& net, const AtomPinId& src_pin, con
   lb_net_atom_source_pins_[net] = std::vector<AtomPinId>(1, src_pin);
 }
 
+void LbRouter::reset() {
+  clear_nets();
+  reset_illegal_modes();
+
+  is_routed_ = false;
+  explore_id_index_ = 1;
+  pres_con_fac_ = 1;
+}
+
 void LbRouter::set_physical_pb_modes(const LbRRGraph& lb_rr_graph,
                                      const VprDeviceAnnotation& device_annotation) {
   /* Go through each node in the routing resource graph
@@ -238,7 +256,7 @@ bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
 
     commit_remove_rt(lb_rr_graph, lb_net_rt_trees_[net_idx][isrc], RT_REMOVE, mode_map);
     free_net_rt(lb_net_rt_trees_[net_idx][isrc]);
-    lb_net_rt_trees_[net_idx][isrc] = nullptr;
+    lb_net_rt_trees_[net_idx][isrc] = TraceId::INVALID();
     add_source_to_rt(net_idx, isrc);
 
     /* Route each sink of net */
@@ -552,16 +570,16 @@ bool LbRouter::check_edge_for_route_conflicts(std::unordered_map<const t_pb_grap
 }
 
 void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
-                                t_trace* rt,
+                                const TraceId& rt,
                                 const e_commit_remove& op,
                                 std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map) {
   int incr;
 
-  if (nullptr == rt) {
+  if (TraceId::INVALID() == rt) {
     return;
   }
 
-  LbRRNodeId inode = rt->current_node;
+  LbRRNodeId inode = traces_[rt].current_node;
 
   /* Determine if node is being used or removed */
   if (op == RT_COMMIT) {
@@ -580,12 +598,12 @@ void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
   t_pb_graph_pin* driver_pin = lb_rr_graph.node_pb_graph_pin(inode);
 
   /* Recursively update route tree */
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
+  for (TraceId next = traces_[rt].first_child; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
     // Check to see if there is no mode conflict between previous nets.
     // A conflict is present if there are differing modes between a pb_graph_node
     // and its children.
     if (op == RT_COMMIT && mode_status_.try_expand_all_modes) {
-      const LbRRNodeId& node = rt->next_nodes[i].current_node;
+      const LbRRNodeId& node = traces_[next].current_node;
       t_pb_graph_pin* pin = lb_rr_graph.node_pb_graph_pin(node);
 
       if (check_edge_for_route_conflicts(mode_map, driver_pin, pin)) {
@@ -593,20 +611,20 @@ void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
       }
     }
 
-    commit_remove_rt(lb_rr_graph, &rt->next_nodes[i], op, mode_map);
+    commit_remove_rt(lb_rr_graph, next, op, mode_map);
   }
 }
 
 bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
-                                 t_trace* rt) {
+                                 const TraceId& rt) {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
 
-  if (rt == nullptr) {
+  if (rt == TraceId::INVALID()) {
     return false; /* Net is not routed, therefore must route net */
   }
 
-  LbRRNodeId inode = rt->current_node;
+  LbRRNodeId inode = traces_[rt].current_node;
 
   /* Determine if node is overused */
   if (routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) {
@@ -615,8 +633,8 @@ bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
   }
 
   /* Recursively check that rest of route tree does not have a conflict */
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    if (!is_skip_route_net(lb_rr_graph, &rt->next_nodes[i])) {
+  for (TraceId next = traces_[rt].first_child; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    if (!is_skip_route_net(lb_rr_graph, next)) {
       return false;
     }
   }
@@ -625,10 +643,9 @@ bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
   return true;
 }
 
-bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId& irt_net) {
+bool LbRouter::add_to_rt(const TraceId& rt, const LbRRNodeId& node_index, const NetId& irt_net) {
   std::vector<LbRRNodeId> trace_forward;
-  t_trace* link_node;
-  t_trace curr_node;
+  TraceId link_node;
 
   /* Store path all the way back to route tree */
   LbRRNodeId rt_index = node_index;
@@ -640,7 +657,7 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId&
 
   /* Find rt_index on the route tree */
   link_node = find_node_in_rt(rt, rt_index);
-  if (link_node == nullptr) {
+  if (link_node == TraceId::INVALID()) {
     VTR_LOG("Link node is nullptr. Routing impossible");
     return true;
   }
@@ -649,9 +666,15 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId&
   LbRRNodeId trace_index;
   while (!trace_forward.empty()) {
     trace_index = trace_forward.back();
-    curr_node.current_node = trace_index;
-    link_node->next_nodes.push_back(curr_node);
-    link_node = &link_node->next_nodes.back();
+    /* The pool may grow here, so only ids are kept across the allocation */
+    TraceId curr_node = alloc_trace(trace_index);
+    if (TraceId::INVALID() == traces_[link_node].last_child) {
+      traces_[link_node].first_child = curr_node;
+    } else {
+      traces_[traces_[link_node].last_child].next_sibling = curr_node;
+    }
+    traces_[link_node].last_child = curr_node;
+    link_node = curr_node;
     trace_forward.pop_back();
   }
 
@@ -660,12 +683,11 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId&
 
 void LbRouter::add_source_to_rt(const NetId& inet, const size_t& isrc) {
   /* TODO: Validate net id */
-  VTR_ASSERT(nullptr == lb_net_rt_trees_[inet][isrc]);
-  lb_net_rt_trees_[inet][isrc] = new t_trace;
-  lb_net_rt_trees_[inet][isrc]->current_node = lb_net_sources_[inet][isrc];
+  VTR_ASSERT(TraceId::INVALID() == lb_net_rt_trees_[inet][isrc]);
+  lb_net_rt_trees_[inet][isrc] = alloc_trace(lb_net_sources_[inet][isrc]);
 }
 
-void LbRouter::expand_rt_rec(t_trace* rt,
+void LbRouter::expand_rt_rec(const TraceId& rt,
                              const LbRRNodeId& prev_index, 
                              const NetId& irt_net,
                              const int& explore_id_index) {
@@ -673,7 +695,7 @@ void LbRouter::expand_rt_rec(t_trace* rt,
 
   /* Perhaps should use a cost other than zero */
   enode.cost = 0;
-  enode.node_index = rt->current_node;
+  enode.node_index = traces_[rt].current_node;
   enode.prev_index = prev_index;
   pq_.push(enode);
   explored_node_tb_[enode.node_index].inet = irt_net;
@@ -682,8 +704,8 @@ void LbRouter::expand_rt_rec(t_trace* rt,
   explored_node_tb_[enode.node_index].enqueue_cost = 0;
   explored_node_tb_[enode.node_index].prev_index = prev_index;
 
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    expand_rt_rec(&rt->next_nodes[i], rt->current_node, irt_net, explore_id_index);
+  for (TraceId next = traces_[rt].first_child; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    expand_rt_rec(next, traces_[rt].current_node, irt_net, explore_id_index);
   }
 }
 
@@ -995,7 +1017,7 @@ void LbRouter::reset_net_rt() {
   for (const NetId& inet : lb_net_ids_) {
     for (size_t isrc = 0; isrc < lb_net_sources_[inet].size(); ++isrc) {
       free_net_rt(lb_net_rt_trees_[inet][isrc]);
-      lb_net_rt_trees_[inet][isrc] = nullptr;
+      lb_net_rt_trees_[inet][isrc] = TraceId::INVALID();
     }
   }
 }
@@ -1008,7 +1030,6 @@ void LbRouter::reset_routing_status() {
 }
 
 void LbRouter::clear_nets() {
-  /* TODO: Trace should no longer use pointers */
   reset_net_rt();
 
   lb_net_ids_.clear();
@@ -1018,24 +1039,36 @@ void LbRouter::clear_nets() {
   lb_net_sources_.clear();
   lb_net_sinks_.clear();
   lb_net_rt_trees_.clear();
+
+  /* All the route trees are gone, the whole pool is free */
+  traces_.clear();
+  free_traces_.clear();
 }
 
-void LbRouter::free_net_rt(t_trace* lb_trace) {
-  if (lb_trace != nullptr) {
-    for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-      free_lb_trace(&lb_trace->next_nodes[i]);
-    }
-    lb_trace->next_nodes.clear();
-    delete lb_trace;
+LbRouter::TraceId LbRouter::alloc_trace(const LbRRNodeId& node) {
+  TraceId trace;
+  if (!free_traces_.empty()) {
+    trace = free_traces_.back();
+    free_traces_.pop_back();
+  } else {
+    trace = TraceId(traces_.size());
+    traces_.emplace_back();
   }
+
+  traces_[trace].current_node = node;
+  traces_[trace].first_child = TraceId::INVALID();
+  traces_[trace].last_child = TraceId::INVALID();
+  traces_[trace].next_sibling = TraceId::INVALID();
+
+  return trace;
 }
 
-void LbRouter::free_lb_trace(t_trace* lb_trace) {
-  if (lb_trace != nullptr) {
-    for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-      free_lb_trace(&lb_trace->next_nodes[i]);
+void LbRouter::free_net_rt(const TraceId& lb_trace) {
+  if (lb_trace != TraceId::INVALID()) {
+    for (TraceId next = traces_[lb_trace].first_child; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+      free_net_rt(next);
     }
-    lb_trace->next_nodes.clear();
+    free_traces_.push_back(lb_trace);
   }
 }
 
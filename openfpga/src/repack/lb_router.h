@@ -66,6 +66,10 @@ namespace openfpga {
  *  // Here is an example to check which nodes are mapped to the 'net' created before
  *  std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
  *
+ *  // Reuse the router for another logical block on the same lb_rr_graph
+ *  // The modes set before are kept
+ *  lb_router.reset();
+ *
  *******************************************************************/
 
 
@@ -73,6 +77,8 @@ class LbRouter {
   public: /* Strong ids */
     struct net_id_tag;
     typedef vtr::StrongId<net_id_tag> NetId;
+    struct trace_id_tag;
+    typedef vtr::StrongId<trace_id_tag> TraceId;
   public: /* Types and ranges */
     typedef vtr::vector<NetId, NetId>::const_iterator net_iterator;
     typedef vtr::Range<net_iterator> net_range;
@@ -99,10 +105,15 @@ class LbRouter {
      * A net is implemented using routing resource nodes. 
      * The t_lb_trace data structure records one of the nodes used by the net and the connections
      * to other nodes
+     * The nodes of all the route trees live in a pool owned by the router
+     * and are linked by their ids in the pool.
+     * The children of a node are kept in the order they are added
      ***************************************************************************/
     struct t_trace {
-      LbRRNodeId current_node;            /* current t_lb_type_rr_node used by net */
-      std::vector<t_trace> next_nodes; /* index of previous edge that drives current node */
+      LbRRNodeId current_node; /* current t_lb_type_rr_node used by net */
+      TraceId first_child;     /* first node driven by current node */
+      TraceId last_child;      /* last node driven by current node */
+      TraceId next_sibling;    /* next node driven by the same parent node */
     };
 
     /**************************************************************************
@@ -216,6 +227,10 @@ class LbRouter {
     /* Return the atom net id for a net to be routed */
     AtomNetId net_atom_net_id(const NetId& net) const;    
 
+    /* Return the source and sink nodes of a net to be routed */
+    const std::vector<LbRRNodeId>& net_sources(const NetId& net) const;
+    const std::vector<LbRRNodeId>& net_sinks(const NetId& net) const;
+
     /**
      * Find all the routing resource nodes that are over-used, which they are used more than their capacity
      * This function is call to collect the nodes and router can reroute these net
@@ -239,6 +254,13 @@ class LbRouter {
     void add_net_atom_net_id(const NetId& net, const AtomNetId& atom_net);
     void add_net_atom_pins(const NetId& net, const AtomPinId& src_pin, const std::vector<AtomPinId>& terminal_pins);
 
+    /* Remove all the nets and routing results, so that the router can be reused
+     * for another logical block on the same lb_rr_graph
+     * The memory of the router is kept for the next routing
+     * and the modes in routing status are not changed
+     */
+    void reset();
+
     /* TODO: Initialize all the modes in routing status with the mode set in pb
      * This is function used for general purpose packing
      */
@@ -268,12 +290,12 @@ class LbRouter {
      * Try to find a node in the routing traces recursively
      * If not found, will return an empty pointer
      */
-    t_trace* find_node_in_rt(t_trace* rt, const LbRRNodeId& rt_index);
+    TraceId find_node_in_rt(const TraceId& rt, const LbRRNodeId& rt_index) const;
 
-    bool route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) const;
+    bool route_has_conflict(const LbRRGraph& lb_rr_graph, const TraceId& rt) const;
 
     /* Recursively find all the nodes in the trace */
-    void rec_collect_trace_nodes(const t_trace* trace, std::vector<LbRRNodeId>& routed_nodes) const;
+    void rec_collect_trace_nodes(const TraceId& trace, std::vector<LbRRNodeId>& routed_nodes) const;
 
   private : /* Private mutators */
     /*It is possible that a net may connect multiple times to a logically equivalent set of primitive pins.
@@ -290,13 +312,13 @@ class LbRouter {
                                         const t_pb_graph_pin* driver_pin,
                                         const t_pb_graph_pin* pin);
     void commit_remove_rt(const LbRRGraph& lb_rr_graph,
-                          t_trace* rt,
+                          const TraceId& rt,
                           const e_commit_remove& op,
                           std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map);
-    bool is_skip_route_net(const LbRRGraph& lb_rr_graph, t_trace* rt);
-    bool add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId& irt_net);
+    bool is_skip_route_net(const LbRRGraph& lb_rr_graph, const TraceId& rt);
+    bool add_to_rt(const TraceId& rt, const LbRRNodeId& node_index, const NetId& irt_net);
     void add_source_to_rt(const NetId& inet, const size_t& isrc);
-    void expand_rt_rec(t_trace* rt,
+    void expand_rt_rec(const TraceId& rt,
                        const LbRRNodeId& prev_index, 
                        const NetId& irt_net,
                        const int& explore_id_index);
@@ -353,8 +375,10 @@ class LbRouter {
     void reset_illegal_modes();
 
     void clear_nets();
-    void free_net_rt(t_trace* lb_trace);
-    void free_lb_trace(t_trace* lb_trace);
+
+    /* Take a trace node from the pool, reusing the nodes of freed route trees first */
+    TraceId alloc_trace(const LbRRNodeId& node);
+    void free_net_rt(const TraceId& lb_trace);
 
   private : /* Stores all data needed by intra-logic cluster_ctx.blocks router */
     /* Logical Netlist Info */
@@ -377,7 +401,13 @@ class LbRouter {
     vtr::vector<NetId, std::vector<LbRRNodeId>> lb_net_sinks_;
 
     /* Route tree head for each source of each net */
-    vtr::vector<NetId, std::vector<t_trace*>> lb_net_rt_trees_;
+    vtr::vector<NetId, std::vector<TraceId>> lb_net_rt_trees_;
+
+    /* Pool of the route tree nodes of all the nets */
+    vtr::vector<TraceId, t_trace> traces_;
+
+    /* Nodes in the pool which are not used by any route tree */
+    std::vector<TraceId> free_traces_;
 
     /* Logical-to-physical mapping info */
     vtr::vector<LbRRNodeId, t_routing_status> routing_status_; /* [0..lb_type_graph->size()-1] Stats for each logic cluster_ctx.blocks rr node instance */
@@ -74,9 +74,30 @@ void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
                                            const LbRouter& lb_router,
                                            const LbRRGraph& lb_rr_graph) {
   /* Get mapping routing nodes per net */
+  std::vector<AtomNetId> net_atom_nets;
+  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
   for (const LbRouter::NetId& net : lb_router.nets()) {
-    std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
-    for (const LbRRNodeId& node : routed_nodes) {
+    net_atom_nets.push_back(lb_router.net_atom_net_id(net));
+    net_routed_nodes.push_back(lb_router.net_routed_nodes(net));
+  }
+
+  save_lb_router_results_to_physical_pb(phy_pb, net_atom_nets, net_routed_nodes, lb_rr_graph);
+}
+
+/***************************************************************************************
+ * Load the routed nodes of each net to a physical pb data structure
+ * The routed nodes may come from another clustered block which has
+ * the same routing problem, so the atom nets are given separately
+ ***************************************************************************************/
+void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
+                                           const std::vector<AtomNetId>& net_atom_nets,
+                                           const std::vector<std::vector<LbRRNodeId>>& net_routed_nodes,
+                                           const LbRRGraph& lb_rr_graph) {
+  VTR_ASSERT(net_atom_nets.size() == net_routed_nodes.size());
+
+  for (size_t inet = 0; inet < net_routed_nodes.size(); ++inet) {
+    const AtomNetId& atom_net = net_atom_nets[inet];
+    for (const LbRRNodeId& node : net_routed_nodes[inet]) {
       t_pb_graph_pin* pb_graph_pin = lb_rr_graph.node_pb_graph_pin(node);
       if (nullptr == pb_graph_pin) {
         continue;
@@ -85,8 +106,6 @@ void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
       const PhysicalPbId& pb_id = phy_pb.find_pb(pb_graph_pin->parent_node);
       VTR_ASSERT(true == phy_pb.valid_pb_id(pb_id));
 
-      const AtomNetId& atom_net = lb_router.net_atom_net_id(net);
-
       /* Print info to help debug 
       bool verbose = true;
       VTR_LOGV(verbose,
@@ -2,11 +2,18 @@
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
 /* Headers from vpr library */
 #include "vpr_utils.h"
 
@@ -14,7 +21,9 @@
 #include "build_physical_lb_rr_graph.h"
 #include "lb_router.h"
 #include "lb_router_utils.h"
+#include "lb_route_cache.h"
 #include "physical_pb_utils.h"
+#include "openfpga_parallel_utils.h"
 #include "repack.h"
 
 /* begin namespace openfpga */
@@ -532,18 +541,31 @@ void add_lb_router_nets(LbRouter& lb_router,
  * This function will do 
  * - Find the lb_rr_graph that is affiliated to the clustered block 
  *   and initilize the logcial tile router 
+ *   The router of each lb_rr_graph is created once and reset for the next clustered block
  * - Create nets to be routed, including the source nodes and terminals
  *   This should consider the net remapping in the clustering_annotation 
  * - Run the router to finish the repacking
- * - Output routing results to data structure PhysicalPb and store it in clustering annotation
+ *   If a clustered block with the same routing problem has been routed,
+ *   its routing results are reused from the route cache
+ * - Output routing results to data structure PhysicalPb
+ *
+ * Return CMD_EXEC_FATAL_ERROR if the clustered block cannot be routed,
+ * the caller is in charge of reporting the failure
+ *
+ * Note: 
+ *  - This function only reads the shared data structures except the route cache, 
+ *    so that it can be called by multiple threads at the same time
  ***************************************************************************************/
 static 
-void repack_cluster(const AtomContext& atom_ctx,
-                    const ClusteringContext& clustering_ctx,
-                    const VprDeviceAnnotation& device_annotation,
-                    VprClusteringAnnotation& clustering_annotation,
-                    const ClusterBlockId& block_id,
-                    const bool& verbose) {
+int repack_cluster_to_physical_pb(PhysicalPb& phy_pb,
+                                  std::map<const t_pb_graph_node*, LbRouter>& lb_routers,
+                                  LbRouteCache& route_cache,
+                                  const AtomContext& atom_ctx,
+                                  const ClusteringContext& clustering_ctx,
+                                  const VprDeviceAnnotation& device_annotation,
+                                  const VprClusteringAnnotation& clustering_annotation,
+                                  const ClusterBlockId& block_id,
+                                  const bool& verbose) {
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(block_id);
   t_pb_graph_node* pb_graph_head = lb_type->pb_graph_head;
@@ -553,35 +575,47 @@ void repack_cluster(const AtomContext& atom_ctx,
   const LbRRGraph& lb_rr_graph = device_annotation.physical_lb_rr_graph(pb_graph_head);
   VTR_ASSERT(!lb_rr_graph.empty());
 
-  VTR_LOG("Repack clustered block '%s'...",
-          clustering_ctx.clb_nlist.block_name(block_id).c_str());
-  VTR_LOGV(verbose, "\n");
+  /* Initialize the router, or reuse the one created for the same lb_rr_graph */
+  auto router_result = lb_routers.find(pb_graph_head);
+  if (router_result == lb_routers.end()) {
+    router_result = lb_routers.emplace(pb_graph_head, LbRouter(lb_rr_graph, lb_type)).first;
 
-  /* Initialize the router */
-  LbRouter lb_router(lb_rr_graph, lb_type);
+    /* Initialize the modes to expand routing trees with the physical modes in device annotation
+     * This is a must-do before running the routeri in the purpose of repacking!!!
+     * The modes are kept when the router is reset
+     */
+    router_result->second.set_physical_pb_modes(lb_rr_graph, device_annotation); 
+  }
+  LbRouter& lb_router = router_result->second;
+  lb_router.reset();
 
   /* Add nets to be routed with source and terminals */
   add_lb_router_nets(lb_router, lb_type, lb_rr_graph, atom_ctx, device_annotation,
-                     clustering_ctx, const_cast<const VprClusteringAnnotation&>(clustering_annotation),
+                     clustering_ctx, clustering_annotation,
                      block_id, verbose);
 
-  /* Initialize the modes to expand routing trees with the physical modes in device annotation
-   * This is a must-do before running the routeri in the purpose of repacking!!!
-   */
-  lb_router.set_physical_pb_modes(lb_rr_graph, device_annotation); 
+  /* Reuse the routing results of an identical routing problem if any */
+  LbRouteCache::Signature route_signature = LbRouteCache::signature(pb_graph_head, lb_router);
+  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
+
+  if (true == route_cache.find(route_signature, net_routed_nodes)) {
+    VTR_LOGV(verbose, "Reuse routing results of an identical clustered block\n");
+  } else {
+    /* Run the router */
+    bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
 
-  /* Run the router */
-  bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+    if (false == route_success) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    VTR_LOGV(verbose, "Reroute succeed\n");
 
-  if (false == route_success) {
-    VTR_LOGV(verbose, "Reroute failed\n");
-    exit(1);
+    for (const LbRouter::NetId& net : lb_router.nets()) {
+      net_routed_nodes.push_back(lb_router.net_routed_nodes(net));
+    }
+    route_cache.add(route_signature, net_routed_nodes);
   }
-  VTR_ASSERT(true == route_success);
-  VTR_LOGV(verbose, "Reroute succeed\n");
 
   /* Annotate routing results to physical pb */
-  PhysicalPb phy_pb;
   alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
   rec_update_physical_pb_from_operating_pb(phy_pb,
                                            clustering_ctx.clb_nlist.block_pb(block_id),
@@ -590,31 +624,166 @@ void repack_cluster(const AtomContext& atom_ctx,
                                            device_annotation,
                                            verbose);
   /* Save routing results */
-  save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph);
+  std::vector<AtomNetId> net_atom_nets;
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    net_atom_nets.push_back(lb_router.net_atom_net_id(net));
+  }
+  save_lb_router_results_to_physical_pb(phy_pb, net_atom_nets, net_routed_nodes, lb_rr_graph);
   VTR_LOGV(verbose, "Saved results in physical pb\n");
 
+  return CMD_EXEC_SUCCESS;
+}
+
+/***************************************************************************************
+ * Repack a clustered block in the physical mode
+ * and store the PhysicalPb in clustering annotation
+ ***************************************************************************************/
+static 
+int repack_cluster(std::map<const t_pb_graph_node*, LbRouter>& lb_routers,
+                   LbRouteCache& route_cache,
+                   const AtomContext& atom_ctx,
+                   const ClusteringContext& clustering_ctx,
+                   const VprDeviceAnnotation& device_annotation,
+                   VprClusteringAnnotation& clustering_annotation,
+                   const ClusterBlockId& block_id,
+                   const bool& verbose) {
+  VTR_LOG("Repack clustered block '%s'...",
+          clustering_ctx.clb_nlist.block_name(block_id).c_str());
+  VTR_LOGV(verbose, "\n");
+
+  PhysicalPb phy_pb;
+  int status = repack_cluster_to_physical_pb(phy_pb, lb_routers, route_cache, atom_ctx, clustering_ctx, device_annotation,
+                                             const_cast<const VprClusteringAnnotation&>(clustering_annotation),
+                                             block_id, verbose);
+  if (CMD_EXEC_SUCCESS != status) {
+    VTR_LOG("\n");
+    VTR_LOG_ERROR("Reroute failed for clustered block '%s'\n",
+                  clustering_ctx.clb_nlist.block_name(block_id).c_str());
+    return status;
+  }
+
   /* Add the pb to clustering context */
   clustering_annotation.add_physical_pb(block_id, phy_pb);
 
   VTR_LOG("Done\n");
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/***************************************************************************************
+ * Repack each clustered blocks in the clustering context with multiple threads
+ * - The clustered blocks are repacked by run_parallel_tasks()
+ *   The PhysicalPb and the status of each block are stored in private slots 
+ * - Routers are reused across the blocks: each running task takes a set of routers 
+ *   from a pool and returns it when done, so at most num_jobs sets are created
+ * - The PhysicalPbs are added to the clustering annotation in the order of clustered blocks,
+ *   so that the results are the same as the serial repacking
+ *
+ * Note: 
+ *  - The verbose output of each block is not printed in this mode,
+ *    as the messages from different workers are interleaved 
+ ***************************************************************************************/
+static 
+int repack_clusters_parallel(LbRouteCache& route_cache,
+                             const AtomContext& atom_ctx,
+                             const ClusteringContext& clustering_ctx,
+                             const VprDeviceAnnotation& device_annotation,
+                             VprClusteringAnnotation& clustering_annotation,
+                             const size_t& num_jobs,
+                             const bool& verbose) {
+  std::vector<ClusterBlockId> blocks;
+  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
+    blocks.push_back(blk_id);
+  }
+
+  size_t num_workers = std::min(num_jobs, blocks.size());
+  VTR_LOGV(verbose,
+           "Repack %lu clustered blocks with %lu workers (verbose output of each block is skipped)\n",
+           blocks.size(), num_workers);
+
+  std::vector<PhysicalPb> phy_pbs(blocks.size());
+  std::vector<int> block_status(blocks.size(), CMD_EXEC_SUCCESS);
+
+  /* Router sets which are not used by any running task */
+  std::vector<std::map<const t_pb_graph_node*, LbRouter>> lb_router_pool(num_workers);
+  std::vector<size_t> free_lb_router_ids;
+  for (size_t ipool = 0; ipool < lb_router_pool.size(); ++ipool) {
+    free_lb_router_ids.push_back(ipool);
+  }
+  std::mutex lb_router_pool_mutex;
+
+  const VprClusteringAnnotation& const_clustering_annotation = const_cast<const VprClusteringAnnotation&>(clustering_annotation);
+
+  run_parallel_tasks(blocks.size(), num_jobs,
+                     [&](const size_t& iblk) {
+    size_t lb_router_id;
+    {
+      std::lock_guard<std::mutex> lock(lb_router_pool_mutex);
+      VTR_ASSERT(false == free_lb_router_ids.empty());
+      lb_router_id = free_lb_router_ids.back();
+      free_lb_router_ids.pop_back();
+    }
+
+    block_status[iblk] = repack_cluster_to_physical_pb(phy_pbs[iblk], lb_router_pool[lb_router_id], route_cache,
+                                                       atom_ctx, clustering_ctx, device_annotation,
+                                                       const_clustering_annotation,
+                                                       blocks[iblk], false);
+
+    std::lock_guard<std::mutex> lock(lb_router_pool_mutex);
+    free_lb_router_ids.push_back(lb_router_id);
+  });
+
+  /* Merge the results in a deterministic order */
+  for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+    if (CMD_EXEC_SUCCESS != block_status[iblk]) {
+      VTR_LOG_ERROR("Reroute failed for clustered block '%s'\n",
+                    clustering_ctx.clb_nlist.block_name(blocks[iblk]).c_str());
+      return block_status[iblk];
+    }
+    VTR_LOG("Repack clustered block '%s'...Done\n",
+            clustering_ctx.clb_nlist.block_name(blocks[iblk]).c_str());
+    clustering_annotation.add_physical_pb(blocks[iblk], phy_pbs[iblk]);
+  }
+
+  return CMD_EXEC_SUCCESS;
 }
 
 /***************************************************************************************
  * Repack each clustered blocks in the clustering context
  ***************************************************************************************/
 static 
-void repack_clusters(const AtomContext& atom_ctx,
-                     const ClusteringContext& clustering_ctx,
-                     const VprDeviceAnnotation& device_annotation,
-                     VprClusteringAnnotation& clustering_annotation,
-                     const bool& verbose) {
+int repack_clusters(const AtomContext& atom_ctx,
+                    const ClusteringContext& clustering_ctx,
+                    const VprDeviceAnnotation& device_annotation,
+                    VprClusteringAnnotation& clustering_annotation,
+                    const size_t& num_jobs,
+                    const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Repack clustered blocks to physical implementation of logical tile");
 
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    repack_cluster(atom_ctx, clustering_ctx, 
-                   device_annotation, clustering_annotation, 
-                   blk_id, verbose);
+  /* Routing results shared by the clustered blocks with the same routing problem */
+  LbRouteCache route_cache;
+
+  int status = CMD_EXEC_SUCCESS;
+  if (1 < num_jobs) {
+    status = repack_clusters_parallel(route_cache, atom_ctx, clustering_ctx,
+                                      device_annotation, clustering_annotation,
+                                      num_jobs, verbose);
+  } else {
+    std::map<const t_pb_graph_node*, LbRouter> lb_routers;
+    for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
+      status = repack_cluster(lb_routers, route_cache, atom_ctx, clustering_ctx, 
+                              device_annotation, clustering_annotation, 
+                              blk_id, verbose);
+      if (CMD_EXEC_SUCCESS != status) {
+        break;
+      }
+    }
   }
+
+  VTR_LOG("Repack route cache: %lu hits, %lu misses (%lu distinct routing problems)\n",
+          route_cache.num_hits(), route_cache.num_misses(), route_cache.size());
+
+  return status;
 }
 
 /***************************************************************************************
@@ -625,14 +794,18 @@ void repack_clusters(const AtomContext& atom_ctx,
  *  - annotate nets to be routed for each clustered block from operating modes of pb_graph 
  *    to physical modes of pb_graph
  *  - rerun the routing for each clustered block
+ *    the clustered blocks can be routed by multiple threads when num_jobs is larger than 1
  *  - store the packing results to clustering annotation
+ *
+ * Return CMD_EXEC_FATAL_ERROR if any clustered block cannot be repacked
  ***************************************************************************************/
-void pack_physical_pbs(const DeviceContext& device_ctx,
-                       const AtomContext& atom_ctx,
-                       const ClusteringContext& clustering_ctx,
-                       VprDeviceAnnotation& device_annotation,
-                       VprClusteringAnnotation& clustering_annotation,
-                       const bool& verbose) {
+int pack_physical_pbs(const DeviceContext& device_ctx,
+                      const AtomContext& atom_ctx,
+                      const ClusteringContext& clustering_ctx,
+                      VprDeviceAnnotation& device_annotation,
+                      VprClusteringAnnotation& clustering_annotation,
+                      const size_t& num_jobs,
+                      const bool& verbose) {
 
   /* build the routing resource graph for each logical tile */
   build_physical_lb_rr_graphs(device_ctx,
@@ -640,9 +813,9 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                               verbose);
 
   /* Call the LbRouter to re-pack each clustered block to physical implementation */ 
-  repack_clusters(atom_ctx, clustering_ctx, 
-                  const_cast<const VprDeviceAnnotation&>(device_annotation), clustering_annotation, 
-                  verbose);
+  return repack_clusters(atom_ctx, clustering_ctx, 
+                         const_cast<const VprDeviceAnnotation&>(device_annotation), clustering_annotation, 
+                         num_jobs, verbose);
 }
 
 } /* end namespace openfpga */
@@ -0,0 +1,86 @@
+/********************************************************************
+ * This file includes functions to run independent tasks
+ * with multiple threads
+ *******************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+#include "openfpga_parallel_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Run the tasks indexed from 0 to num_tasks - 1 with a pool of 
+ * at most num_jobs workers. 
+ * Each worker picks the next task to run until all the tasks are done,
+ * so the order in which tasks are finished is not deterministic.
+ * Tasks should only write to their private slots of data, 
+ * and the caller is in charge of merging the results in a deterministic order.
+ *
+ * When num_jobs is no more than 1, the tasks are run in the calling thread in order
+ *******************************************************************/
+void run_parallel_tasks(const size_t& num_tasks,
+                        const size_t& num_jobs,
+                        const std::function<void(const size_t&)>& task) {
+  size_t num_workers = std::min(num_jobs, num_tasks);
+  if (1 >= num_workers) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      task(itask);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_task(0);
+
+  std::vector<std::thread> workers;
+  for (size_t iworker = 0; iworker < num_workers; ++iworker) {
+    workers.emplace_back([&]() {
+      for (size_t itask = next_task++; itask < num_tasks; itask = next_task++) {
+        task(itask);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+/********************************************************************
+ * Read the number of threads from the option '--jobs' of a command
+ * The num_jobs is left unchanged when the option is not enabled,
+ * so that the caller can decide the default value.
+ * The purpose is only used in the error message, e.g., "repacking"
+ *
+ * Return CMD_EXEC_FATAL_ERROR if the number of jobs is not a positive integer
+ *******************************************************************/
+int read_num_jobs_option(const Command& cmd,
+                         const CommandContext& cmd_context,
+                         const std::string& purpose,
+                         size_t& num_jobs) {
+  CommandOptionId opt_jobs = cmd.option("jobs");
+  if (false == cmd_context.option_enable(cmd, opt_jobs)) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  int user_jobs = std::atoi(cmd_context.option_value(cmd, opt_jobs).c_str());
+  if (0 >= user_jobs) {
+    VTR_LOG_ERROR("Invalid number of jobs '%d' for %s! Expect a positive integer\n",
+                  user_jobs, purpose.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  num_jobs = user_jobs;
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
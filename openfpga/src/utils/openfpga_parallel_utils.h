@@ -0,0 +1,32 @@
+#ifndef OPENFPGA_PARALLEL_UTILS_H
+#define OPENFPGA_PARALLEL_UTILS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "command.h"
+#include "command_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void run_parallel_tasks(const size_t& num_tasks,
+                        const size_t& num_jobs,
+                        const std::function<void(const size_t&)>& task);
+
+int read_num_jobs_option(const Command& cmd,
+                         const CommandContext& cmd_context,
+                         const std::string& purpose,
+                         size_t& num_jobs);
+
+} /* end namespace openfpga */
+
+#endif
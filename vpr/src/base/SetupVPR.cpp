@@ -167,6 +167,8 @@ void SetupVPR(const t_options* Options,
     SetupPackerOpts(*Options, PackerOpts);
     RoutingArch->write_rr_graph_filename = Options->write_rr_graph_file;
     RoutingArch->read_rr_graph_filename = Options->read_rr_graph_file;
+    RoutingArch->rr_graph_snapshot_dir = Options->rr_graph_snapshot_dir;
+    RoutingArch->arch_file_name = Options->ArchFile;
 
     //Setup the default flow, if no specific stages specified
     //do all
@@ -371,6 +373,7 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->clock_modeling = Options.clock_modeling;
     RouterOpts->two_stage_clock_routing = Options.two_stage_clock_routing;
     RouterOpts->high_fanout_threshold = Options.router_high_fanout_threshold;
+    RouterOpts->parallel_route_nets = Options.router_parallel_nets;
     RouterOpts->router_debug_net = Options.router_debug_net;
     RouterOpts->router_debug_sink_rr = Options.router_debug_sink_rr;
     RouterOpts->lookahead_type = Options.router_lookahead_type;
@@ -509,6 +512,7 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
 
     PlacerOpts->rlim_escape_fraction = Options.place_rlim_escape_fraction;
     PlacerOpts->move_stats_file = Options.place_move_stats_file;
+    PlacerOpts->parallel_moves = Options.place_parallel_moves;
 
     PlacerOpts->strict_checks = Options.strict_checks;
 
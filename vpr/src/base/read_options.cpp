@@ -1023,9 +1023,19 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.rr_graph_snapshot_dir, "--rr_graph_snapshot_dir")
+        .help(
+            "Directory of the snapshots of tileable routing resource graphs."
+            " A snapshot is loaded instead of building the routing resource graph when the architecture file,"
+            " the device layout and the channel width are the same as the ones it was taken for."
+            " Otherwise, the routing resource graph is built and a snapshot is taken into the directory.")
+        .metavar("RR_GRAPH_SNAPSHOT_DIR")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.read_router_lookahead, "--read_router_lookahead")
         .help(
-            "Reads the lookahead data from the specified file instead of computing it.")
+            "Reads the lookahead data from the specified file instead of computing it."
+            " The file must be written by --write_router_lookahead for the same device and routing resource graph.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.write_router_lookahead, "--write_router_lookahead")
@@ -1304,6 +1314,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("0.0")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_parallel_moves, "--place_parallel_moves")
+        .help(
+            "Number of moves the annealer proposes and evaluates together."
+            " Moves in a batch touch disjoint blocks, locations and nets, so their"
+            " cost changes are computed concurrently and then accepted or rejected"
+            " in proposal order. Results only depend on the seed and this value,"
+            " not on the number of worker threads. 1 uses the serial annealer.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.place_move_stats_file, "--place_move_stats")
         .help(
             "File to write detailed placer move statistics to")
@@ -1591,6 +1611,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("64")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_parallel_nets, "--router_parallel_nets")
+        .help(
+            "Controls whether the router routes nets concurrently."
+            " Nets whose bounding boxes can not share any routing resource are routed in parallel,"
+            " while nets which may compete for a resource are kept in the serial routing order,"
+            " so that the routing result is identical to the serial router."
+            " Requires VPR to be built with the TBB execution engine")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<e_router_lookahead, ParseRouterLookahead>(args.router_lookahead_type, "--router_lookahead")
         .help(
             "Controls what lookahead the router uses to calculate cost of completing a connection.\n"
@@ -794,6 +794,7 @@ struct t_placer_opts {
     e_stage_action doPlacement;
     float rlim_escape_fraction;
     std::string move_stats_file;
+    int parallel_moves; //Number of independent moves evaluated concurrently (1 = serial)
 
     PlaceDelayModelType delay_model_type;
     e_reducer delay_model_reducer;
@@ -943,6 +944,7 @@ struct t_router_opts {
     enum e_clock_modeling clock_modeling; //How clock pins and nets should be handled
     bool two_stage_clock_routing;         //How clock nets on dedicated networks should be routed
     int high_fanout_threshold;
+    bool parallel_route_nets; //Route nets with disjoint bounding boxes concurrently
     int router_debug_net;
     int router_debug_sink_rr;
     e_router_lookahead lookahead_type;
@@ -996,6 +998,8 @@ struct t_analysis_opts {
  * read_rr_graph_filename: File to read the RR graph from (overrides        *
  *                         architecture)                                    *
  * write_rr_graph_filename: File to write the RR graph to after generation  *
+ * rr_graph_snapshot_dir: Directory of the snapshots of tileable RR graphs  *
+ * arch_file_name: Architecture file, whose content keys the snapshots      *
  *                                                                          */
 
 struct t_det_routing_arch {
@@ -1023,6 +1027,9 @@ struct t_det_routing_arch {
 
     std::string read_rr_graph_filename;
     std::string write_rr_graph_filename;
+
+    std::string rr_graph_snapshot_dir;
+    std::string arch_file_name;
 };
 
 
@@ -620,6 +620,12 @@ class RRGraph {
     void reserve_switches(const size_t& num_switches);
     void reserve_segments(const size_t& num_segments);
 
+    /* Build the fast look-up for nodes if it is not valid.
+     * find_node() builds the look-up on demand, which is not safe when several threads
+     * query the RRGraph at the same time. Call this function before any concurrent query.
+     */
+    void initialize_fast_node_lookup() const;
+
     /* Add new elements (node, edge, switch, etc.) to RRGraph */
     /* Add a node to the RRGraph with a deposited type 
      * Detailed node-level information should be added using the set_node_* functions
@@ -825,7 +831,6 @@ class RRGraph {
     void build_fast_node_lookup() const;
     void invalidate_fast_node_lookup() const;
     bool valid_fast_node_lookup() const;
-    void initialize_fast_node_lookup() const;
 
     /* Graph property Validation */
     bool validate_sizes() const;
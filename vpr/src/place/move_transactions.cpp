@@ -25,6 +25,10 @@ e_block_move_result record_block_move(t_pl_blocks_to_be_moved& blocks_affected,
 
     // Sets up the blocks moved
     int imoved_blk = blocks_affected.num_moved_blocks;
+    if (imoved_blk == int(blocks_affected.moved_blocks.size())) {
+        //Only the placer's move batches start with small move lists; grow them on demand
+        blocks_affected.moved_blocks.emplace_back();
+    }
     blocks_affected.moved_blocks[imoved_blk].block_num = blk;
     blocks_affected.moved_blocks[imoved_blk].old_loc = from;
     blocks_affected.moved_blocks[imoved_blk].new_loc = to;
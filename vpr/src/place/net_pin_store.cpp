@@ -0,0 +1,99 @@
+#include "net_pin_store.h"
+
+#include <algorithm>
+
+#include "vtr_assert.h"
+
+#include "globals.h"
+#include "vpr_utils.h"
+
+void NetPinStore::load() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& clb_nlist = cluster_ctx.clb_nlist;
+
+    clear();
+
+    net_pin_starts_.reserve(clb_nlist.nets().size() + 1);
+    pin_blocks_.reserve(clb_nlist.pins().size());
+    pin_tile_indices_.reserve(clb_nlist.pins().size());
+    pin_logical_indices_.reserve(clb_nlist.pins().size());
+
+    for (ClusterNetId net_id : clb_nlist.nets()) {
+        VTR_ASSERT(size_t(net_id) == net_pin_starts_.size());
+        net_pin_starts_.push_back(pin_blocks_.size());
+
+        //Net pins are ordered driver first, then sinks
+        for (ClusterPinId pin_id : clb_nlist.net_pins(net_id)) {
+            pin_blocks_.push_back(clb_nlist.pin_block(pin_id));
+            pin_tile_indices_.push_back(tile_pin_index(pin_id));
+            pin_logical_indices_.push_back(clb_nlist.pin_logical_index(pin_id));
+        }
+    }
+    net_pin_starts_.push_back(pin_blocks_.size());
+}
+
+void NetPinStore::clear() {
+    net_pin_starts_.clear();
+    pin_blocks_.clear();
+    pin_tile_indices_.clear();
+    pin_logical_indices_.clear();
+}
+
+CoordHistogram::CoordHistogram(size_t num_coords)
+    : counts_(num_coords, 0)
+    , tree_(num_coords + 1, 0) {
+    top_bit_ = 1;
+    while (size_t(top_bit_) * 2 <= num_coords) {
+        top_bit_ *= 2;
+    }
+}
+
+void CoordHistogram::clear() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    std::fill(tree_.begin(), tree_.end(), 0);
+    total_ = 0;
+}
+
+void CoordHistogram::add(int coord, int delta) {
+    VTR_ASSERT_SAFE(coord >= 0 && size_t(coord) < counts_.size());
+
+    counts_[coord] += delta;
+    total_ += delta;
+    VTR_ASSERT_SAFE(counts_[coord] >= 0);
+
+    for (size_t i = coord + 1; i < tree_.size(); i += i & (~i + 1)) {
+        tree_[i] += delta;
+    }
+}
+
+void CoordHistogram::move(int from, int to) {
+    if (from == to) return;
+
+    add(from, -1);
+    add(to, +1);
+}
+
+int CoordHistogram::min_coord() const {
+    VTR_ASSERT_SAFE(total_ > 0);
+    return find_prefix_count(1);
+}
+
+int CoordHistogram::max_coord() const {
+    VTR_ASSERT_SAFE(total_ > 0);
+    return find_prefix_count(total_);
+}
+
+int CoordHistogram::find_prefix_count(int target) const {
+    //Standard Fenwick tree descent: find the largest position whose prefix
+    //count is below target, the answer is the next coordinate
+    size_t pos = 0;
+    for (size_t step = top_bit_; step > 0; step /= 2) {
+        if (pos + step < tree_.size() && tree_[pos + step] < target) {
+            pos += step;
+            target -= tree_[pos];
+        }
+    }
+
+    VTR_ASSERT_SAFE(pos < counts_.size());
+    return pos; //tree_ is 1-based, so pos is the 0-based coordinate
+}
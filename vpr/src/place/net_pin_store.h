@@ -0,0 +1,87 @@
+#ifndef VPR_NET_PIN_STORE_H
+#define VPR_NET_PIN_STORE_H
+
+#include <vector>
+
+#include "clustered_netlist_fwd.h"
+#include "vtr_vector.h"
+
+//Structure-of-arrays copy of the clustered net pins used by the placer's
+//bounding box and timing cost computations.
+//
+//The pins of each net are stored contiguously (driver first, followed by the
+//sinks in net pin order), so walking a net does not have to go through the
+//netlist's pin -> block and pin -> physical pin lookups.
+class NetPinStore {
+  public:
+    //Builds the store from the clustered netlist and place_ctx.physical_pins
+    void load();
+
+    void clear();
+
+    //Net pins of 'net' are [pins_begin(net), pins_end(net)), the driver is at pins_begin(net)
+    size_t pins_begin(ClusterNetId net) const { return net_pin_starts_[net]; }
+    size_t pins_end(ClusterNetId net) const { return net_pin_starts_[ClusterNetId(size_t(net) + 1)]; }
+
+    ClusterBlockId pin_block(size_t ipin) const { return pin_blocks_[ipin]; }
+
+    //Index of the pin on its physical tile (i.e. tile_pin_index())
+    int pin_tile_index(size_t ipin) const { return pin_tile_indices_[ipin]; }
+
+    //Index of the pin within its logical block type (i.e. ClusteredNetlist::pin_logical_index())
+    int pin_logical_index(size_t ipin) const { return pin_logical_indices_[ipin]; }
+
+  private:
+    vtr::vector<ClusterNetId, size_t> net_pin_starts_; //[0..num_nets], last entry is the total pin count
+
+    std::vector<ClusterBlockId> pin_blocks_;
+    std::vector<int> pin_tile_indices_;
+    std::vector<int> pin_logical_indices_;
+};
+
+//Number of net pins at each (clipped) grid coordinate along one axis.
+//
+//The counts are mirrored in a Fenwick tree, so that after a pin leaves the
+//edge of a bounding box the new extreme coordinate is found in O(log n)
+//instead of re-scanning every pin of the net.
+class CoordHistogram {
+  public:
+    CoordHistogram() = default;
+    explicit CoordHistogram(size_t num_coords);
+
+    void clear();
+
+    void add(int coord, int delta);
+
+    //Moves one pin from coordinate 'from' to coordinate 'to'
+    void move(int from, int to);
+
+    int count(int coord) const { return counts_[coord]; }
+    int total() const { return total_; }
+
+    //Smallest and largest coordinates holding at least one pin (requires total() > 0)
+    int min_coord() const;
+    int max_coord() const;
+
+  private:
+    //Returns the smallest coordinate whose prefix count is at least 'target'
+    int find_prefix_count(int target) const;
+
+  private:
+    std::vector<int> counts_;
+    std::vector<int> tree_; //1-based Fenwick tree over counts_
+    int total_ = 0;
+    int top_bit_ = 0; //Largest power of two <= counts_.size()
+};
+
+//Per-axis pin histograms of one net
+struct t_net_bb_histogram {
+    t_net_bb_histogram(size_t width, size_t height)
+        : x(width)
+        , y(height) {}
+
+    CoordHistogram x;
+    CoordHistogram y;
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include "vtr_util.h"
 #include "vtr_random.h"
 #include "vtr_geometry.h"
+#include "vtr_time.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
@@ -31,6 +32,7 @@
 #include "place_delay_model.h"
 #include "move_transactions.h"
 #include "move_utils.h"
+#include "net_pin_store.h"
 
 #include "uniform_move_generator.h"
 
@@ -41,6 +43,10 @@
 #include "tatum/echo_writer.hpp"
 #include "tatum/TimingReporter.hpp"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 using std::max;
 using std::min;
 
@@ -51,6 +57,11 @@ using std::min;
 /* To turn off incremental bounding box updates, set this to a huge value */
 #define SMALL_NET 4
 
+/* Nets with at least this many sinks keep per-axis pin coordinate        *
+ * histograms, so their bounding boxes never need a full pin re-scan when *
+ * a pin leaves the edge of the box.                                      */
+#define HIGH_FANOUT_NET 64
+
 /* This defines the error tolerance for floating points variables used in *
  * cost computation. 0.01 means that there is a 1% error tolerance.       */
 #define ERROR_TOL .01
@@ -96,6 +107,41 @@ struct t_placer_prev_inverse_costs {
     double timing_cost;
 };
 
+/* Scratch state for evaluating several moves at once (--place_parallel_moves). *
+ * The moves of a batch touch disjoint locations and (non-ignored) nets, so     *
+ * their cost changes do not depend on each other and can be computed           *
+ * concurrently; they are then accepted or rejected one by one in proposal      *
+ * order. A proposal that conflicts with the batch is kept as the first move    *
+ * of the next batch, unless an accepted move made it stale.                    */
+struct t_pl_move_batch {
+    t_pl_move_batch(size_t num_slots, size_t num_nets)
+        : moves(num_slots, t_pl_blocks_to_be_moved(0))
+        , nets_to_update(num_slots)
+        , num_nets_affected(num_slots, 0)
+        , bb_delta_c(num_slots, 0.)
+        , timing_delta_c(num_slots, 0.)
+        , net_stamps(num_nets, 0) {}
+
+    std::vector<t_pl_blocks_to_be_moved> moves;
+    std::vector<std::vector<ClusterNetId>> nets_to_update;
+    std::vector<int> num_nets_affected;
+    std::vector<double> bb_delta_c;
+    std::vector<double> timing_delta_c;
+
+    //Nets already used by a move of the current batch carry the batch's stamp
+    vtr::vector<ClusterNetId, unsigned> net_stamps;
+    unsigned stamp = 0;
+
+    //Locations used by the moves of the current batch
+    std::unordered_set<t_pl_loc> batch_locs;
+
+    //Locations changed by the moves accepted in the last batch
+    std::unordered_set<t_pl_loc> committed_locs;
+
+    //Whether moves[0] holds a proposal carried over from the last batch
+    bool has_pending_move = false;
+};
+
 constexpr float INVALID_DELAY = std::numeric_limits<float>::quiet_NaN();
 
 constexpr double MAX_INV_TIMING_COST = 1.e9;
@@ -147,6 +193,16 @@ static vtr::vector<ClusterBlockId, std::vector<int>> net_pin_indices;
 
 static vtr::vector<ClusterNetId, t_bb> bb_coords, bb_num_on_edges;
 
+/* Structure-of-arrays copy of the net pins (blocks and pin indices), used *
+ * by the bounding box and point to point delay computations.              */
+static NetPinStore net_pin_store;
+
+/* [0...cluster_ctx.clb_nlist.nets().size()-1]. Pin coordinate histograms   *
+ * of the committed placement for nets with at least HIGH_FANOUT_NET sinks *
+ * (nullptr for all other nets). Moves update them while being assessed,   *
+ * rejected moves undo their updates.                                      */
+static vtr::vector<ClusterNetId, std::unique_ptr<t_net_bb_histogram>> net_bb_histograms;
+
 /* The arrays below are used to precompute the inverse of the average   *
  * number of tracks per channel between [subhigh] and [sublow].  Access *
  * them as chan?_place_cost_fac[subhigh][sublow].  They are used to     *
@@ -280,8 +336,8 @@ static void free_fast_cost_update();
 
 static double comp_bb_cost(e_cost_methods method);
 
-static void update_move_nets(int num_nets_affected);
-static void reset_move_nets(int num_nets_affected);
+static void update_move_nets(int num_nets_affected, const std::vector<ClusterNetId>& nets_to_update);
+static void reset_move_nets(int num_nets_affected, const std::vector<ClusterNetId>& nets_to_update);
 
 static e_move_result try_swap(float t,
                               t_placer_costs* costs,
@@ -294,6 +350,37 @@ static e_move_result try_swap(float t,
                               enum e_place_algorithm place_algorithm,
                               float timing_tradeoff);
 
+static int try_swap_batch(float t,
+                          t_placer_costs* costs,
+                          t_placer_prev_inverse_costs* prev_inverse_costs,
+                          float rlim,
+                          int max_moves,
+                          MoveGenerator& move_generator,
+                          t_pl_move_batch& move_batch,
+                          const PlaceDelayModel* delay_model,
+                          const t_placer_opts& placer_opts,
+                          t_placer_statistics* stats);
+
+static bool claim_batch_move(t_pl_move_batch& move_batch, int islot);
+
+static double comp_delta_cost(const t_placer_prev_inverse_costs* prev_inverse_costs,
+                              enum e_place_algorithm place_algorithm,
+                              float timing_tradeoff,
+                              double bb_delta_c,
+                              double timing_delta_c);
+
+static void finish_move(e_move_result move_outcome,
+                        double delta_c,
+                        double bb_delta_c,
+                        double timing_delta_c,
+                        t_placer_costs* costs,
+                        t_pl_blocks_to_be_moved& blocks_affected,
+                        int num_nets_affected,
+                        const std::vector<ClusterNetId>& nets_to_update,
+                        enum e_place_algorithm place_algorithm);
+
+static void record_swap_outcome(e_move_result swap_result, const t_placer_costs& costs, t_placer_statistics* stats);
+
 static void check_place(const t_placer_costs& costs,
                         const PlaceDelayModel* delay_model,
                         enum e_place_algorithm place_algorithm);
@@ -346,10 +433,11 @@ static void update_bb(ClusterNetId net_id, t_bb* bb_coord_new, t_bb* bb_edge_new
 static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
                                                const t_pl_blocks_to_be_moved& blocks_affected,
                                                const PlaceDelayModel* delay_model,
+                                               std::vector<ClusterNetId>& nets_to_update,
                                                double& bb_delta_c,
                                                double& timing_delta_c);
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets);
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update, int& num_affected_nets);
 
 static void update_net_bb(const ClusterNetId net,
                           const t_pl_blocks_to_be_moved& blocks_affected,
@@ -362,6 +450,16 @@ static double get_net_cost(ClusterNetId net_id, t_bb* bb_ptr);
 
 static void get_bb_from_scratch(ClusterNetId net_id, t_bb* coords, t_bb* num_on_edges);
 
+static void load_net_bb_histogram(ClusterNetId net_id);
+
+static void get_bb_from_histogram(ClusterNetId net_id, t_bb* coords, t_bb* num_on_edges);
+
+static void update_bb_from_histogram(ClusterNetId net_id, const t_pl_moved_block& moved_block, int iblk_pin, t_bb* bb_coord_new, t_bb* bb_edge_new);
+
+static void revert_net_bb_histograms(const t_pl_blocks_to_be_moved& blocks_affected);
+
+static void get_pin_bb_coords(t_pl_loc loc, int iblk_pin, int* x, int* y);
+
 static double get_net_wirelength_estimate(ClusterNetId net_id, t_bb* bbptr);
 
 static void free_try_swap_arrays();
@@ -390,6 +488,7 @@ static void placement_inner_loop(float t,
                                  const PlaceDelayModel* delay_model,
                                  MoveGenerator& move_generator,
                                  t_pl_blocks_to_be_moved& blocks_affected,
+                                 t_pl_move_batch* move_batch,
                                  SetupTimingInfo& timing_info);
 
 static void recompute_costs_from_scratch(const t_placer_opts& placer_opts, const PlaceDelayModel* delay_model, t_placer_costs* costs);
@@ -457,6 +556,11 @@ void try_place(const t_placer_opts& placer_opts,
 
     t_pl_blocks_to_be_moved blocks_affected(cluster_ctx.clb_nlist.blocks().size());
 
+    std::unique_ptr<t_pl_move_batch> move_batch;
+    if (placer_opts.parallel_moves > 1) {
+        move_batch = std::make_unique<t_pl_move_batch>(placer_opts.parallel_moves, cluster_ctx.clb_nlist.nets().size());
+    }
+
     /* Allocated here because it goes into timing critical code where each memory allocation is expensive */
     IntraLbPbPinLookup pb_gpin_lookup(device_ctx.logical_block_types);
 
@@ -492,6 +596,9 @@ void try_place(const t_placer_opts& placer_opts,
         place_sync_external_block_connections(block_id);
     }
 
+    //The net pin store caches the physical pins, so it is loaded once they are known
+    net_pin_store.load();
+
     init_draw_coords((float)width_fac);
     //Enables fast look-up of atom pins connect to CLB pins
     ClusteredPinAtomPinsLookup netlist_pin_lookup(cluster_ctx.clb_nlist, pb_gpin_lookup);
@@ -611,6 +718,9 @@ void try_place(const t_placer_opts& placer_opts,
     final_rlim = 1;
     inverse_delta_rlim = 1 / (first_rlim - final_rlim);
 
+    //Times all annealing moves (including the starting temperature ones) for the swap rate
+    vtr::Timer anneal_timer;
+
     t = starting_t(&costs, &prev_inverse_costs,
                    annealing_sched, move_lim, rlim,
                    place_delay_model.get(),
@@ -650,6 +760,7 @@ void try_place(const t_placer_opts& placer_opts,
                              place_delay_model.get(),
                              *move_generator,
                              blocks_affected,
+                             move_batch.get(),
                              *timing_info);
 
         tot_iter += move_lim;
@@ -712,11 +823,14 @@ void try_place(const t_placer_opts& placer_opts,
                          place_delay_model.get(),
                          *move_generator,
                          blocks_affected,
+                         move_batch.get(),
                          *timing_info);
 
     tot_iter += move_lim;
     ++num_temps;
 
+    float anneal_time = anneal_timer.elapsed_sec();
+
     calc_placer_stats(stats, success_rat, std_dev, costs, move_lim);
 
     if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
@@ -743,6 +857,7 @@ void try_place(const t_placer_opts& placer_opts,
     //Some stats
     VTR_LOG("\n");
     VTR_LOG("Swaps called: %d\n", num_ts_called);
+    VTR_LOG("Placement swap rate: %.0f swaps/s\n", num_ts_called / std::max(anneal_time, std::numeric_limits<float>::min()));
 
     if (placer_opts.enable_timing_computations
         && placer_opts.place_algorithm == BOUNDING_BOX_PLACE) {
@@ -878,6 +993,7 @@ static void placement_inner_loop(float t,
                                  const PlaceDelayModel* delay_model,
                                  MoveGenerator& move_generator,
                                  t_pl_blocks_to_be_moved& blocks_affected,
+                                 t_pl_move_batch* move_batch,
                                  SetupTimingInfo& timing_info) {
     int inner_crit_iter_count, inner_iter;
 
@@ -890,71 +1006,82 @@ static void placement_inner_loop(float t,
     inner_crit_iter_count = 1;
 
     /* Inner loop begins */
-    for (inner_iter = 0; inner_iter < move_lim; inner_iter++) {
-        e_move_result swap_result = try_swap(t, costs, prev_inverse_costs, rlim,
-                                             move_generator,
-                                             blocks_affected,
-                                             delay_model,
-                                             placer_opts.rlim_escape_fraction,
-                                             placer_opts.place_algorithm,
-                                             placer_opts.timing_tradeoff);
-
-        if (swap_result == ACCEPTED) {
-            /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
-            stats->success_sum++;
-            stats->av_cost += costs->cost;
-            stats->av_bb_cost += costs->bb_cost;
-            stats->av_timing_cost += costs->timing_cost;
-            stats->sum_of_squares += (costs->cost) * (costs->cost);
-            num_swap_accepted++;
-        } else if (swap_result == ABORTED) {
-            num_swap_aborted++;
-        } else { // swap_result == REJECTED
-            num_swap_rejected++;
+    for (inner_iter = 0; inner_iter < move_lim;) {
+        int num_moves = 1;
+        if (move_batch) {
+            /* A batch never runs past a criticality or cost recompute, since
+             * the cost changes of its moves are all computed up front. */
+            int max_moves = std::min(placer_opts.parallel_moves, move_lim - inner_iter);
+            if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+                max_moves = std::min(max_moves, std::max(inner_recompute_limit - inner_crit_iter_count, 0) + 1);
+            }
+            max_moves = std::min(max_moves, std::max(MAX_MOVES_BEFORE_RECOMPUTE - *moves_since_cost_recompute, 0) + 1);
+
+            num_moves = try_swap_batch(t, costs, prev_inverse_costs, rlim, max_moves,
+                                       move_generator,
+                                       *move_batch,
+                                       delay_model,
+                                       placer_opts,
+                                       stats);
+        } else {
+            e_move_result swap_result = try_swap(t, costs, prev_inverse_costs, rlim,
+                                                 move_generator,
+                                                 blocks_affected,
+                                                 delay_model,
+                                                 placer_opts.rlim_escape_fraction,
+                                                 placer_opts.place_algorithm,
+                                                 placer_opts.timing_tradeoff);
+
+            record_swap_outcome(swap_result, *costs, stats);
         }
 
-        if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
-            /* Do we want to re-timing analyze the circuit to get updated slack and criticality values?
-             * We do this only once in a while, since it is expensive.
-             */
-            if (inner_crit_iter_count >= inner_recompute_limit
-                && inner_iter != move_lim - 1) { /*on last iteration don't recompute */
+        for (int imove = 0; imove < num_moves; ++imove, ++inner_iter) {
+            if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+                /* Do we want to re-timing analyze the circuit to get updated slack and criticality values?
+                 * We do this only once in a while, since it is expensive.
+                 */
+                if (inner_crit_iter_count >= inner_recompute_limit
+                    && inner_iter != move_lim - 1) { /*on last iteration don't recompute */
 
-                inner_crit_iter_count = 0;
+                    inner_crit_iter_count = 0;
 #ifdef VERBOSE
-                VTR_LOG("Inner loop recompute criticalities\n");
+                    VTR_LOG("Inner loop recompute criticalities\n");
 #endif
-                /* Using the delays in net_delay, do a timing analysis to update slacks and
-                 * criticalities; then update the timing cost since it will change.
-                 */
-                //Inner loop timing update
-                timing_info.update();
-                load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
-
-                comp_td_costs(delay_model, &costs->timing_cost);
+                    /* Using the delays in net_delay, do a timing analysis to update slacks and
+                     * criticalities; then update the timing cost since it will change.
+                     */
+                    //Inner loop timing update
+                    timing_info.update();
+                    load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
+
+                    comp_td_costs(delay_model, &costs->timing_cost);
+                }
+                inner_crit_iter_count++;
             }
-            inner_crit_iter_count++;
-        }
 #ifdef VERBOSE
-        VTR_LOG("t = %g  cost = %g   bb_cost = %g timing_cost = %g move = %d\n",
-                t, costs->cost, costs->bb_cost, costs->timing_cost, inner_iter);
-        if (fabs((costs->bb_cost) - comp_bb_cost(CHECK)) > (costs->bb_cost) * ERROR_TOL)
-            VPR_ERROR(VPR_ERROR_PLACE,
-                      "fabs((*bb_cost) - comp_bb_cost(CHECK)) > (*bb_cost) * ERROR_TOL");
+            VTR_LOG("t = %g  cost = %g   bb_cost = %g timing_cost = %g move = %d\n",
+                    t, costs->cost, costs->bb_cost, costs->timing_cost, inner_iter);
+            if (fabs((costs->bb_cost) - comp_bb_cost(CHECK)) > (costs->bb_cost) * ERROR_TOL)
+                VPR_ERROR(VPR_ERROR_PLACE,
+                          "fabs((*bb_cost) - comp_bb_cost(CHECK)) > (*bb_cost) * ERROR_TOL");
 #endif
 
-        /* Lines below prevent too much round-off error from accumulating
-         * in the cost over many iterations (due to incremental updates).
-         * This round-off can lead to  error checks failing because the cost
-         * is different from what you get when you recompute from scratch.
-         */
-        ++(*moves_since_cost_recompute);
-        if (*moves_since_cost_recompute > MAX_MOVES_BEFORE_RECOMPUTE) {
-            recompute_costs_from_scratch(placer_opts, delay_model, costs);
-            *moves_since_cost_recompute = 0;
+            /* Lines below prevent too much round-off error from accumulating
+             * in the cost over many iterations (due to incremental updates).
+             * This round-off can lead to  error checks failing because the cost
+             * is different from what you get when you recompute from scratch.
+             */
+            ++(*moves_since_cost_recompute);
+            if (*moves_since_cost_recompute > MAX_MOVES_BEFORE_RECOMPUTE) {
+                recompute_costs_from_scratch(placer_opts, delay_model, costs);
+                *moves_since_cost_recompute = 0;
+            }
         }
     }
     /* Inner loop ends */
+
+    //Batches are sized so that a carried over proposal is always evaluated in this loop
+    VTR_ASSERT(!move_batch || !move_batch->has_pending_move);
 }
 
 static void recompute_costs_from_scratch(const t_placer_opts& placer_opts, const PlaceDelayModel* delay_model, t_placer_costs* costs) {
@@ -1143,11 +1270,11 @@ static float starting_t(t_placer_costs* costs,
     return (20. * std_dev);
 }
 
-static void update_move_nets(int num_nets_affected) {
+static void update_move_nets(int num_nets_affected, const std::vector<ClusterNetId>& nets_to_update) {
     /* update net cost functions and reset flags. */
     auto& cluster_ctx = g_vpr_ctx.clustering();
     for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+        ClusterNetId net_id = nets_to_update[inet_affected];
 
         bb_coords[net_id] = ts_bb_coord_new[net_id];
         if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET)
@@ -1161,10 +1288,10 @@ static void update_move_nets(int num_nets_affected) {
     }
 }
 
-static void reset_move_nets(int num_nets_affected) {
+static void reset_move_nets(int num_nets_affected, const std::vector<ClusterNetId>& nets_to_update) {
     /* Reset the net cost function flags first. */
     for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+        ClusterNetId net_id = nets_to_update[inet_affected];
         temp_net_cost[net_id] = -1;
         bb_updated_before[net_id] = NOT_UPDATED_YET;
     }
@@ -1240,46 +1367,14 @@ static e_move_result try_swap(float t,
         apply_move_blocks(blocks_affected);
 
         // Find all the nets affected by this swap and update their costs
-        int num_nets_affected = find_affected_nets_and_update_costs(place_algorithm, blocks_affected, delay_model, bb_delta_c, timing_delta_c);
-        if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
-            /*in this case we redefine delta_c as a combination of timing and bb.  *
-             *additionally, we normalize all values, therefore delta_c is in       *
-             *relation to 1*/
-
-            delta_c = (1 - timing_tradeoff) * bb_delta_c * prev_inverse_costs->bb_cost
-                      + timing_tradeoff * timing_delta_c * prev_inverse_costs->timing_cost;
-        } else {
-            delta_c = bb_delta_c;
-        }
+        int num_nets_affected = find_affected_nets_and_update_costs(place_algorithm, blocks_affected, delay_model, ts_nets_to_update, bb_delta_c, timing_delta_c);
+        delta_c = comp_delta_cost(prev_inverse_costs, place_algorithm, timing_tradeoff, bb_delta_c, timing_delta_c);
 
         /* 1 -> move accepted, 0 -> rejected. */
         move_outcome = assess_swap(delta_c, t);
 
-        if (move_outcome == ACCEPTED) {
-            costs->cost += delta_c;
-            costs->bb_cost += bb_delta_c;
-
-            if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
-                /*update the point_to_point_timing_cost and point_to_point_delay
-                 * values from the temporary values */
-                costs->timing_cost += timing_delta_c;
-
-                update_td_cost(blocks_affected);
-            }
-
-            /* update net cost functions and reset flags. */
-            update_move_nets(num_nets_affected);
-
-            /* Update clb data structures since we kept the move. */
-            commit_move_blocks(blocks_affected);
-
-        } else { /* Move was rejected.  */
-                 /* Reset the net cost function flags first. */
-            reset_move_nets(num_nets_affected);
-
-            /* Restore the place_ctx.block_locs data structures to their state before the move. */
-            revert_move_blocks(blocks_affected);
-        }
+        finish_move(move_outcome, delta_c, bb_delta_c, timing_delta_c, costs,
+                    blocks_affected, num_nets_affected, ts_nets_to_update, place_algorithm);
 
         move_outcome_stats.delta_cost_norm = delta_c;
         move_outcome_stats.delta_bb_cost_norm = bb_delta_c * prev_inverse_costs->bb_cost;
@@ -1307,6 +1402,301 @@ static e_move_result try_swap(float t,
     return (move_outcome);
 }
 
+//Proposes up to max_moves moves, evaluates the independent ones concurrently
+//and then accepts or rejects them in proposal order.
+//
+//Returns the number of moves attempted (including aborted ones).
+static int try_swap_batch(float t,
+                          t_placer_costs* costs,
+                          t_placer_prev_inverse_costs* prev_inverse_costs,
+                          float rlim,
+                          int max_moves,
+                          MoveGenerator& move_generator,
+                          t_pl_move_batch& move_batch,
+                          const PlaceDelayModel* delay_model,
+                          const t_placer_opts& placer_opts,
+                          t_placer_statistics* stats) {
+    /* Every random number is drawn by this thread in a fixed order (proposals  *
+     * first, then acceptance tests), so the placement only depends on the seed *
+     * and the batch size, not on the number of worker threads.                 */
+    VTR_ASSERT(max_moves >= 1);
+
+    int num_attempted = 0;
+    int num_slots = 0;
+
+    move_batch.batch_locs.clear();
+    ++move_batch.stamp;
+
+    if (move_batch.has_pending_move) {
+        //The carried over proposal is only valid if no accepted move has since
+        //changed one of the locations it reads
+        t_pl_blocks_to_be_moved& pending = move_batch.moves[0];
+        move_batch.has_pending_move = false;
+
+        bool stale = false;
+        for (const t_pl_loc& loc : pending.moved_from) {
+            stale |= move_batch.committed_locs.count(loc) > 0;
+        }
+        for (const t_pl_loc& loc : pending.moved_to) {
+            stale |= move_batch.committed_locs.count(loc) > 0;
+        }
+
+        if (stale) {
+            log_move_abort("stale batched move");
+            clear_move_blocks(pending);
+
+            MoveOutcomeStats move_outcome_stats;
+            move_generator.process_outcome(move_outcome_stats);
+            record_swap_outcome(ABORTED, *costs, stats);
+            ++num_ts_called;
+            ++num_attempted;
+        } else {
+            bool claimed = claim_batch_move(move_batch, 0);
+            VTR_ASSERT(claimed);
+            num_slots = 1;
+            ++num_attempted;
+        }
+    }
+    move_batch.committed_locs.clear();
+
+    //Propose moves until the batch is full or a proposal conflicts with it
+    while (num_attempted < max_moves) {
+        t_pl_blocks_to_be_moved& blocks_affected = move_batch.moves[num_slots];
+
+        float move_rlim = rlim;
+        if (placer_opts.rlim_escape_fraction > 0. && vtr::frand() < placer_opts.rlim_escape_fraction) {
+            move_rlim = std::numeric_limits<float>::infinity();
+        }
+
+        e_create_move create_move_outcome = move_generator.propose_move(blocks_affected, move_rlim);
+
+        if (create_move_outcome == e_create_move::ABORT) {
+            LOG_MOVE_STATS_PROPOSED(t, blocks_affected);
+            LOG_MOVE_STATS_OUTCOME(std::numeric_limits<float>::quiet_NaN(),
+                                   std::numeric_limits<float>::quiet_NaN(),
+                                   std::numeric_limits<float>::quiet_NaN(),
+                                   "ABORTED", "illegal move");
+            clear_move_blocks(blocks_affected);
+
+            MoveOutcomeStats move_outcome_stats;
+            move_generator.process_outcome(move_outcome_stats);
+            record_swap_outcome(ABORTED, *costs, stats);
+            ++num_ts_called;
+            ++num_attempted;
+            continue;
+        }
+        VTR_ASSERT(create_move_outcome == e_create_move::VALID);
+
+        if (!claim_batch_move(move_batch, num_slots)) {
+            //Depends on the outcome of an earlier move: evaluate it in the next batch
+            move_batch.has_pending_move = true;
+            break;
+        }
+        ++num_slots;
+        ++num_attempted;
+    }
+
+    //Compute the cost changes. The moves share no blocks, locations or nets, so
+    //each one only touches its own entries of the try_swap scratch arrays.
+    auto evaluate_move = [&](int islot) {
+        t_pl_blocks_to_be_moved& blocks_affected = move_batch.moves[islot];
+
+        apply_move_blocks(blocks_affected);
+
+        move_batch.bb_delta_c[islot] = 0.;
+        move_batch.timing_delta_c[islot] = 0.;
+        move_batch.num_nets_affected[islot] = find_affected_nets_and_update_costs(placer_opts.place_algorithm,
+                                                                                  blocks_affected,
+                                                                                  delay_model,
+                                                                                  move_batch.nets_to_update[islot],
+                                                                                  move_batch.bb_delta_c[islot],
+                                                                                  move_batch.timing_delta_c[islot]);
+    };
+
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(0, num_slots, evaluate_move);
+#else
+    for (int islot = 0; islot < num_slots; ++islot) {
+        evaluate_move(islot);
+    }
+#endif
+
+    //Accept or reject in proposal order
+    for (int islot = 0; islot < num_slots; ++islot) {
+        t_pl_blocks_to_be_moved& blocks_affected = move_batch.moves[islot];
+        double bb_delta_c = move_batch.bb_delta_c[islot];
+        double timing_delta_c = move_batch.timing_delta_c[islot];
+
+        //grid_blocks is not updated until a move commits, so this logs the
+        //same destination contents the serial annealer would
+        LOG_MOVE_STATS_PROPOSED(t, blocks_affected);
+
+        double delta_c = comp_delta_cost(prev_inverse_costs, placer_opts.place_algorithm, placer_opts.timing_tradeoff,
+                                         bb_delta_c, timing_delta_c);
+
+        e_move_result move_outcome = assess_swap(delta_c, t);
+
+        if (move_outcome == ACCEPTED) {
+            move_batch.committed_locs.insert(blocks_affected.moved_from.begin(), blocks_affected.moved_from.end());
+            move_batch.committed_locs.insert(blocks_affected.moved_to.begin(), blocks_affected.moved_to.end());
+        }
+
+        finish_move(move_outcome, delta_c, bb_delta_c, timing_delta_c, costs,
+                    blocks_affected, move_batch.num_nets_affected[islot], move_batch.nets_to_update[islot],
+                    placer_opts.place_algorithm);
+
+        MoveOutcomeStats move_outcome_stats;
+        move_outcome_stats.delta_cost_norm = delta_c;
+        move_outcome_stats.delta_bb_cost_norm = bb_delta_c * prev_inverse_costs->bb_cost;
+        move_outcome_stats.delta_timing_cost_norm = timing_delta_c * prev_inverse_costs->timing_cost;
+
+        move_outcome_stats.delta_bb_cost_abs = bb_delta_c;
+        move_outcome_stats.delta_timing_cost_abs = timing_delta_c;
+
+        LOG_MOVE_STATS_OUTCOME(delta_c, bb_delta_c, timing_delta_c,
+                               (move_outcome ? "ACCEPTED" : "REJECTED"), "");
+
+        move_outcome_stats.outcome = move_outcome;
+        move_generator.process_outcome(move_outcome_stats);
+
+        clear_move_blocks(blocks_affected);
+
+        record_swap_outcome(move_outcome, *costs, stats);
+        ++num_ts_called;
+    }
+
+    if (move_batch.has_pending_move) {
+        std::swap(move_batch.moves[0], move_batch.moves[num_slots]);
+    }
+
+    return num_attempted;
+}
+
+//Adds the move in slot islot to the current batch if it shares no location and
+//no (non-ignored) net with the moves already in it.
+//
+//Returns false (leaving the batch unchanged) on a conflict.
+static bool claim_batch_move(t_pl_move_batch& move_batch, int islot) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    const t_pl_blocks_to_be_moved& blocks_affected = move_batch.moves[islot];
+
+    for (const t_pl_loc& loc : blocks_affected.moved_from) {
+        if (move_batch.batch_locs.count(loc)) return false;
+    }
+    for (const t_pl_loc& loc : blocks_affected.moved_to) {
+        if (move_batch.batch_locs.count(loc)) return false;
+    }
+
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        ClusterBlockId blk = blocks_affected.moved_blocks[iblk].block_num;
+        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(blk)) {
+            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) continue;
+
+            if (move_batch.net_stamps[net_id] == move_batch.stamp) return false;
+        }
+    }
+
+    //No conflicts: claim the locations and nets
+    move_batch.batch_locs.insert(blocks_affected.moved_from.begin(), blocks_affected.moved_from.end());
+    move_batch.batch_locs.insert(blocks_affected.moved_to.begin(), blocks_affected.moved_to.end());
+
+    //Nets reached through several pins of the move are only counted once
+    size_t num_nets = 0;
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        ClusterBlockId blk = blocks_affected.moved_blocks[iblk].block_num;
+        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(blk)) {
+            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) continue;
+
+            if (move_batch.net_stamps[net_id] != move_batch.stamp) {
+                move_batch.net_stamps[net_id] = move_batch.stamp;
+                ++num_nets;
+            }
+        }
+    }
+
+    //find_affected_nets_and_update_costs() records exactly these nets
+    std::vector<ClusterNetId>& nets_to_update = move_batch.nets_to_update[islot];
+    if (nets_to_update.size() < num_nets) {
+        nets_to_update.resize(num_nets, ClusterNetId::INVALID());
+    }
+
+    return true;
+}
+
+static double comp_delta_cost(const t_placer_prev_inverse_costs* prev_inverse_costs,
+                              enum e_place_algorithm place_algorithm,
+                              float timing_tradeoff,
+                              double bb_delta_c,
+                              double timing_delta_c) {
+    if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+        /*in this case we redefine delta_c as a combination of timing and bb.  *
+         *additionally, we normalize all values, therefore delta_c is in       *
+         *relation to 1*/
+
+        return (1 - timing_tradeoff) * bb_delta_c * prev_inverse_costs->bb_cost
+               + timing_tradeoff * timing_delta_c * prev_inverse_costs->timing_cost;
+    }
+
+    return bb_delta_c;
+}
+
+//Commits an accepted move (updating the costs) or reverts a rejected one
+static void finish_move(e_move_result move_outcome,
+                        double delta_c,
+                        double bb_delta_c,
+                        double timing_delta_c,
+                        t_placer_costs* costs,
+                        t_pl_blocks_to_be_moved& blocks_affected,
+                        int num_nets_affected,
+                        const std::vector<ClusterNetId>& nets_to_update,
+                        enum e_place_algorithm place_algorithm) {
+    if (move_outcome == ACCEPTED) {
+        costs->cost += delta_c;
+        costs->bb_cost += bb_delta_c;
+
+        if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+            /*update the point_to_point_timing_cost and point_to_point_delay
+             * values from the temporary values */
+            costs->timing_cost += timing_delta_c;
+
+            update_td_cost(blocks_affected);
+        }
+
+        /* update net cost functions and reset flags. */
+        update_move_nets(num_nets_affected, nets_to_update);
+
+        /* Update clb data structures since we kept the move. */
+        commit_move_blocks(blocks_affected);
+
+    } else { /* Move was rejected.  */
+             /* Reset the net cost function flags first. */
+        reset_move_nets(num_nets_affected, nets_to_update);
+        revert_net_bb_histograms(blocks_affected);
+
+        /* Restore the place_ctx.block_locs data structures to their state before the move. */
+        revert_move_blocks(blocks_affected);
+    }
+}
+
+//Updates the annealing statistics and swap counters with the outcome of a move
+static void record_swap_outcome(e_move_result swap_result, const t_placer_costs& costs, t_placer_statistics* stats) {
+    if (swap_result == ACCEPTED) {
+        /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
+        stats->success_sum++;
+        stats->av_cost += costs.cost;
+        stats->av_bb_cost += costs.bb_cost;
+        stats->av_timing_cost += costs.timing_cost;
+        stats->sum_of_squares += (costs.cost) * (costs.cost);
+        num_swap_accepted++;
+    } else if (swap_result == ABORTED) {
+        num_swap_aborted++;
+    } else { // swap_result == REJECTED
+        num_swap_rejected++;
+    }
+}
+
 //Puts all the nets changed by the current swap into nets_to_update,
 //and updates their bounding box.
 //
@@ -1314,6 +1704,7 @@ static e_move_result try_swap(float t,
 static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
                                                const t_pl_blocks_to_be_moved& blocks_affected,
                                                const PlaceDelayModel* delay_model,
+                                               std::vector<ClusterNetId>& nets_to_update,
                                                double& bb_delta_c,
                                                double& timing_delta_c) {
     VTR_ASSERT_SAFE(bb_delta_c == 0.);
@@ -1335,7 +1726,7 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
                 continue; //TODO: do we require anyting special here for global nets. "Global nets are assumed to span the whole chip, and do not effect costs"
 
             //Record effected nets
-            record_affected_net(net_id, num_affected_nets);
+            record_affected_net(net_id, nets_to_update, num_affected_nets);
 
             //Update the net bounding boxes
             //
@@ -1354,7 +1745,7 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
      * The cost is only updated once per net.
      */
     for (int inet_affected = 0; inet_affected < num_affected_nets; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+        ClusterNetId net_id = nets_to_update[inet_affected];
 
         temp_net_cost[net_id] = get_net_cost(net_id, &ts_bb_coord_new[net_id]);
         bb_delta_c += temp_net_cost[net_id] - net_cost[net_id];
@@ -1363,11 +1754,11 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
     return num_affected_nets;
 }
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets) {
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update, int& num_affected_nets) {
     //Record effected nets
     if (temp_net_cost[net] < 0.) {
         //Net not marked yet.
-        ts_nets_to_update[num_affected_nets] = net;
+        nets_to_update[num_affected_nets] = net;
         num_affected_nets++;
 
         //Flag to say we've marked this net.
@@ -1388,6 +1779,10 @@ static void update_net_bb(const ClusterNetId net,
         if (bb_updated_before[net] == NOT_UPDATED_YET) { //Only once per-net
             get_non_updateable_bb(net, &ts_bb_coord_new[net]);
         }
+    } else if (net_bb_histograms[net]) {
+        //For high fanout nets, update the pin histograms
+        update_bb_from_histogram(net, blocks_affected.moved_blocks[iblk], tile_pin_index(blk_pin),
+                                 &ts_bb_coord_new[net], &ts_bb_edge_new[net]);
     } else {
         //For large nets, update bounding box incrementally
         int iblk_pin = tile_pin_index(blk_pin);
@@ -1490,14 +1885,14 @@ static float comp_td_point_to_point_delay(const PlaceDelayModel* delay_model, Cl
         //Only estimate delay for signals routed through the inter-block
         //routing network. TODO: Do how should we compute the delay for globals. "Global signals are assumed to have zero delay."
 
-        ClusterPinId source_pin = cluster_ctx.clb_nlist.net_driver(net_id);
-        ClusterPinId sink_pin = cluster_ctx.clb_nlist.net_pin(net_id, ipin);
+        size_t source_pin = net_pin_store.pins_begin(net_id);
+        size_t sink_pin = source_pin + ipin;
 
-        ClusterBlockId source_block = cluster_ctx.clb_nlist.pin_block(source_pin);
-        ClusterBlockId sink_block = cluster_ctx.clb_nlist.pin_block(sink_pin);
+        ClusterBlockId source_block = net_pin_store.pin_block(source_pin);
+        ClusterBlockId sink_block = net_pin_store.pin_block(sink_pin);
 
-        int source_block_ipin = cluster_ctx.clb_nlist.pin_logical_index(source_pin);
-        int sink_block_ipin = cluster_ctx.clb_nlist.pin_logical_index(sink_pin);
+        int source_block_ipin = net_pin_store.pin_logical_index(source_pin);
+        int sink_block_ipin = net_pin_store.pin_logical_index(sink_pin);
 
         int source_x = place_ctx.block_locs[source_block].loc.x;
         int source_y = place_ctx.block_locs[source_block].loc.y;
@@ -1644,7 +2039,11 @@ static double comp_bb_cost(e_cost_methods method) {
         if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) { /* Do only if not ignored. */
             /* Small nets don't use incremental updating on their bounding boxes, *
              * so they can use a fast bounding box calculator.                    */
-            if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET && method == NORMAL) {
+            if (net_bb_histograms[net_id] && method == NORMAL) {
+                load_net_bb_histogram(net_id);
+                get_bb_from_histogram(net_id, &bb_coords[net_id],
+                                      &bb_num_on_edges[net_id]);
+            } else if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET && method == NORMAL) {
                 get_bb_from_scratch(net_id, &bb_coords[net_id],
                                     &bb_num_on_edges[net_id]);
             } else {
@@ -1823,6 +2222,15 @@ static void alloc_and_load_try_swap_structs() {
     ts_bb_edge_new.resize(num_nets, t_bb());
     ts_nets_to_update.resize(num_nets, ClusterNetId::INVALID());
 
+    auto& grid = g_vpr_ctx.device().grid;
+    net_bb_histograms.resize(num_nets);
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)
+            && cluster_ctx.clb_nlist.net_sinks(net_id).size() >= HIGH_FANOUT_NET) {
+            net_bb_histograms[net_id] = std::make_unique<t_net_bb_histogram>(grid.width(), grid.height());
+        }
+    }
+
     auto& place_ctx = g_vpr_ctx.mutable_placement();
     place_ctx.compressed_block_grids = create_compressed_block_grids();
 }
@@ -1835,16 +2243,19 @@ static void get_bb_from_scratch(ClusterNetId net_id, t_bb* coords, t_bb* num_on_
     int pnum, x, y, xmin, xmax, ymin, ymax;
     int xmin_edge, xmax_edge, ymin_edge, ymax_edge;
 
-    auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
     auto& device_ctx = g_vpr_ctx.device();
     auto& grid = device_ctx.grid;
 
-    ClusterBlockId bnum = cluster_ctx.clb_nlist.net_driver_block(net_id);
-    pnum = net_pin_to_tile_pin_index(net_id, 0);
+    size_t ipin = net_pin_store.pins_begin(net_id);
+    size_t ipin_end = net_pin_store.pins_end(net_id);
+
+    ClusterBlockId bnum = net_pin_store.pin_block(ipin);
+    pnum = net_pin_store.pin_tile_index(ipin);
     VTR_ASSERT(pnum >= 0);
-    x = place_ctx.block_locs[bnum].loc.x + physical_tile_type(bnum)->pin_width_offset[pnum];
-    y = place_ctx.block_locs[bnum].loc.y + physical_tile_type(bnum)->pin_height_offset[pnum];
+    t_pl_loc loc = place_ctx.block_locs[bnum].loc;
+    x = loc.x + grid[loc.x][loc.y].type->pin_width_offset[pnum];
+    y = loc.y + grid[loc.x][loc.y].type->pin_height_offset[pnum];
 
     x = max(min<int>(x, grid.width() - 2), 1);
     y = max(min<int>(y, grid.height() - 2), 1);
@@ -1858,11 +2269,12 @@ static void get_bb_from_scratch(ClusterNetId net_id, t_bb* coords, t_bb* num_on_
     xmax_edge = 1;
     ymax_edge = 1;
 
-    for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
-        pnum = tile_pin_index(pin_id);
-        x = place_ctx.block_locs[bnum].loc.x + physical_tile_type(bnum)->pin_width_offset[pnum];
-        y = place_ctx.block_locs[bnum].loc.y + physical_tile_type(bnum)->pin_height_offset[pnum];
+    for (++ipin; ipin < ipin_end; ++ipin) {
+        bnum = net_pin_store.pin_block(ipin);
+        pnum = net_pin_store.pin_tile_index(ipin);
+        loc = place_ctx.block_locs[bnum].loc;
+        x = loc.x + grid[loc.x][loc.y].type->pin_width_offset[pnum];
+        y = loc.y + grid[loc.x][loc.y].type->pin_height_offset[pnum];
 
         /* Code below counts IO blocks as being within the 1..grid.width()-2, 1..grid.height()-2 clb array. *
          * This is because channels do not go out of the 0..grid.width()-2, 0..grid.height()-2 range, and   *
@@ -1914,6 +2326,91 @@ static void get_bb_from_scratch(ClusterNetId net_id, t_bb* coords, t_bb* num_on_
     num_on_edges->ymax = ymax_edge;
 }
 
+/* Rebuilds the pin coordinate histograms of a high fanout net from the   *
+ * block locations.                                                       */
+static void load_net_bb_histogram(ClusterNetId net_id) {
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    t_net_bb_histogram& hist = *net_bb_histograms[net_id];
+    hist.x.clear();
+    hist.y.clear();
+
+    for (size_t ipin = net_pin_store.pins_begin(net_id); ipin < net_pin_store.pins_end(net_id); ++ipin) {
+        ClusterBlockId bnum = net_pin_store.pin_block(ipin);
+
+        int x, y;
+        get_pin_bb_coords(place_ctx.block_locs[bnum].loc, net_pin_store.pin_tile_index(ipin), &x, &y);
+        hist.x.add(x, +1);
+        hist.y.add(y, +1);
+    }
+}
+
+/* Same result as get_bb_from_scratch(), read from the net's histograms.  */
+static void get_bb_from_histogram(ClusterNetId net_id, t_bb* coords, t_bb* num_on_edges) {
+    const t_net_bb_histogram& hist = *net_bb_histograms[net_id];
+
+    coords->xmin = hist.x.min_coord();
+    coords->xmax = hist.x.max_coord();
+    coords->ymin = hist.y.min_coord();
+    coords->ymax = hist.y.max_coord();
+
+    num_on_edges->xmin = hist.x.count(coords->xmin);
+    num_on_edges->xmax = hist.x.count(coords->xmax);
+    num_on_edges->ymin = hist.y.count(coords->ymin);
+    num_on_edges->ymax = hist.y.count(coords->ymax);
+}
+
+/* Moves one pin of a high fanout net in its histograms and derives the   *
+ * new bounding box from them in O(log n).  Unlike update_bb() this never *
+ * falls back to a full pin scan, and it may be called once per moved pin *
+ * of the net since the histograms always hold the current pin positions. */
+static void update_bb_from_histogram(ClusterNetId net_id, const t_pl_moved_block& moved_block, int iblk_pin, t_bb* bb_coord_new, t_bb* bb_edge_new) {
+    int xold, yold, xnew, ynew;
+    get_pin_bb_coords(moved_block.old_loc, iblk_pin, &xold, &yold);
+    get_pin_bb_coords(moved_block.new_loc, iblk_pin, &xnew, &ynew);
+
+    t_net_bb_histogram& hist = *net_bb_histograms[net_id];
+    hist.x.move(xold, xnew);
+    hist.y.move(yold, ynew);
+
+    get_bb_from_histogram(net_id, bb_coord_new, bb_edge_new);
+    bb_updated_before[net_id] = UPDATED_ONCE;
+}
+
+/* Undoes the histogram updates made while assessing a rejected move.     */
+static void revert_net_bb_histograms(const t_pl_blocks_to_be_moved& blocks_affected) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        const t_pl_moved_block& moved_block = blocks_affected.moved_blocks[iblk];
+
+        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(moved_block.block_num)) {
+            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || !net_bb_histograms[net_id])
+                continue;
+
+            int iblk_pin = tile_pin_index(blk_pin);
+
+            int xold, yold, xnew, ynew;
+            get_pin_bb_coords(moved_block.old_loc, iblk_pin, &xold, &yold);
+            get_pin_bb_coords(moved_block.new_loc, iblk_pin, &xnew, &ynew);
+
+            net_bb_histograms[net_id]->x.move(xnew, xold);
+            net_bb_histograms[net_id]->y.move(ynew, yold);
+        }
+    }
+}
+
+/* Coordinates of a block pin at location loc, clipped to the channel     *
+ * range like the other bounding box routines do.                         */
+static void get_pin_bb_coords(t_pl_loc loc, int iblk_pin, int* x, int* y) {
+    auto& grid = g_vpr_ctx.device().grid;
+    t_physical_tile_type_ptr type = grid[loc.x][loc.y].type;
+
+    *x = max(min<int>(loc.x + type->pin_width_offset[iblk_pin], grid.width() - 2), 1);  //-2 for no perim channels
+    *y = max(min<int>(loc.y + type->pin_height_offset[iblk_pin], grid.height() - 2), 1); //-2 for no perim channels
+}
+
 static double get_net_wirelength_estimate(ClusterNetId net_id, t_bb* bbptr) {
     /* WMF: Finds the estimate of wirelength due to one net by looking at   *
      * its coordinate bounding box.                                         */
@@ -1995,25 +2492,30 @@ static void get_non_updateable_bb(ClusterNetId net_id, t_bb* bb_coord_new) {
     int xmax, ymax, xmin, ymin, x, y;
     int pnum;
 
-    auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
     auto& device_ctx = g_vpr_ctx.device();
+    auto& grid = device_ctx.grid;
+
+    size_t ipin = net_pin_store.pins_begin(net_id);
+    size_t ipin_end = net_pin_store.pins_end(net_id);
 
-    ClusterBlockId bnum = cluster_ctx.clb_nlist.net_driver_block(net_id);
-    pnum = net_pin_to_tile_pin_index(net_id, 0);
-    x = place_ctx.block_locs[bnum].loc.x + physical_tile_type(bnum)->pin_width_offset[pnum];
-    y = place_ctx.block_locs[bnum].loc.y + physical_tile_type(bnum)->pin_height_offset[pnum];
+    ClusterBlockId bnum = net_pin_store.pin_block(ipin);
+    pnum = net_pin_store.pin_tile_index(ipin);
+    t_pl_loc loc = place_ctx.block_locs[bnum].loc;
+    x = loc.x + grid[loc.x][loc.y].type->pin_width_offset[pnum];
+    y = loc.y + grid[loc.x][loc.y].type->pin_height_offset[pnum];
 
     xmin = x;
     ymin = y;
     xmax = x;
     ymax = y;
 
-    for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
-        pnum = tile_pin_index(pin_id);
-        x = place_ctx.block_locs[bnum].loc.x + physical_tile_type(bnum)->pin_width_offset[pnum];
-        y = place_ctx.block_locs[bnum].loc.y + physical_tile_type(bnum)->pin_height_offset[pnum];
+    for (++ipin; ipin < ipin_end; ++ipin) {
+        bnum = net_pin_store.pin_block(ipin);
+        pnum = net_pin_store.pin_tile_index(ipin);
+        loc = place_ctx.block_locs[bnum].loc;
+        x = loc.x + grid[loc.x][loc.y].type->pin_width_offset[pnum];
+        y = loc.y + grid[loc.x][loc.y].type->pin_height_offset[pnum];
 
         if (x < xmin) {
             xmin = x;
@@ -2490,6 +2992,9 @@ static void print_clb_placement(const char* fname) {
 #endif
 
 static void free_try_swap_arrays() {
+    net_pin_store.clear();
+    net_bb_histograms.clear();
+
     g_vpr_ctx.mutable_placement().compressed_block_grids.clear();
 }
 
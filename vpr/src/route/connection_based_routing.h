@@ -30,8 +30,19 @@ class Connection_based_routing_resources {
     // order does not matter
     std::vector<t_rt_node*> reached_rt_sinks;
 
+    // the resources holding the per-net lookups, which is this object itself
+    // unless this object is the scratch space of a parallel router worker
+    Connection_based_routing_resources* owner;
+
   public:
     Connection_based_routing_resources();
+    // scratch space for a worker routing nets in parallel with other workers:
+    // has its own per-net targets, but shares the per-net lookups of owner_resources
+    explicit Connection_based_routing_resources(Connection_based_routing_resources& owner_resources);
+    // workers refer to their owner, which should not be copied
+    Connection_based_routing_resources(const Connection_based_routing_resources&) = delete;
+    Connection_based_routing_resources& operator=(const Connection_based_routing_resources&) = delete;
+
     // adding to the resources when they are reached during pruning
     // mark rr sink node as something that still needs to be reached
     void toreach_rr_sink(const int& rr_sink_node) { remaining_targets.push_back(rr_sink_node); }
@@ -108,9 +119,10 @@ class Connection_based_routing_resources {
 
     // get whether the connection to rr_sink_node of current_inet should be forcibly rerouted (can either assign or just read)
     bool should_force_reroute_connection(int rr_sink_node) const {
-        auto itr = forcible_reroute_connection_flag[current_inet].find(rr_sink_node);
+        const auto& net_flags = owner->forcible_reroute_connection_flag[current_inet];
+        auto itr = net_flags.find(rr_sink_node);
 
-        if (itr == forcible_reroute_connection_flag[current_inet].end()) {
+        if (itr == net_flags.end()) {
             return false; //A non-SINK end of a branch
         }
         return itr->second;
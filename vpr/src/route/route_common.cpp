@@ -36,6 +36,11 @@
 #include "timing_info.h"
 #include "tatum/echo_writer.hpp"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/spin_mutex.h>
+#    include <tbb/enumerable_thread_specific.h>
+#endif
+
 /**************** Types local to route_common.c ******************/
 struct t_trace_branch {
     t_trace* head;
@@ -44,22 +49,46 @@ struct t_trace_branch {
 
 /**************** Static variables local to route_common.c ******************/
 
-static t_heap** heap; /* Indexed from [1..heap_size] */
-static int heap_size; /* Number of slots in the heap array */
-static int heap_tail; /* Index of first unused slot in the heap array */
+/* The heap of a router and its own free list of heap data structures */
+struct t_heap_state {
+    t_heap** heap = nullptr; /* Indexed from [1..heap_size] */
+    int heap_size = 0;       /* Number of slots in the heap array */
+    int heap_tail = 1;       /* Index of first unused slot in the heap array */
+
+    /* For managing my own list of currently free heap data structures.     */
+    t_heap* heap_free_head = nullptr;
+    /* For keeping track of the sudo malloc memory for the heap*/
+    vtr::t_chunk heap_ch;
+
+    int num_heap_allocated = 0; /* To watch for memory leaks. */
+};
 
-/* For managing my own list of currently free heap data structures.     */
-static t_heap* heap_free_head = nullptr;
-/* For keeping track of the sudo malloc memory for the heap*/
-static vtr::t_chunk heap_ch;
+/* Each worker of the parallel router owns a heap, so that several nets can be
+ * routed at the same time. Workers other than the one calling init_heap()
+ * allocate their heap on first use, and free_route_structs() frees all of them.
+ * Each thread caches its own heap, so the heap operations do not look it up in
+ * heap_states. The states are reset but never erased, which keeps the cached
+ * pointers valid. */
+#if defined(VPR_USE_TBB)
+static tbb::enumerable_thread_specific<t_heap_state> heap_states;
+static thread_local t_heap_state* thread_heap_state = nullptr;
+#else
+static t_heap_state heap_states;
+#endif
 
 /* For managing my own list of currently free trace data structures.    */
 static t_trace* trace_free_head = nullptr;
 /* For keeping track of the sudo malloc memory for the trace*/
 static vtr::t_chunk trace_ch;
 
+#if defined(VPR_USE_TBB)
+/* Tracebacks outlive the thread which routed them, so their free list is
+ * shared and guarded while nets are routed in parallel */
+static tbb::spin_mutex trace_free_list_mutex;
+static bool trace_free_list_shared = false;
+#endif
+
 static int num_trace_allocated = 0; /* To watch for memory leaks. */
-static int num_heap_allocated = 0;
 static int num_linked_f_pointer_allocated = 0;
 
 /*  The numbering relation between the channels and clbs is:				*
@@ -106,6 +135,10 @@ bool validate_traceback_recurr(t_trace* trace, std::set<RRNodeId>& seen_rr_nodes
 static bool validate_trace_nodes(t_trace* head, const std::unordered_set<RRNodeId>& trace_nodes);
 static float get_single_rr_cong_cost(const RRNodeId& inode);
 
+static t_heap_state& local_heap_state();
+static void free_heap_state(t_heap_state& heap_state);
+static int get_num_heap_allocated();
+
 /************************** Subroutine definitions ***************************/
 
 void save_routing(vtr::vector<ClusterNetId, t_trace*>& best_routing,
@@ -474,15 +507,28 @@ void pathfinder_update_cost(float pres_fac, float acc_fac) {
     }
 }
 
+/* Returns the heap of the calling worker */
+static t_heap_state& local_heap_state() {
+#if defined(VPR_USE_TBB)
+    if (thread_heap_state == nullptr) {
+        thread_heap_state = &heap_states.local();
+    }
+    return *thread_heap_state;
+#else
+    return heap_states;
+#endif
+}
+
 void init_heap(const DeviceGrid& grid) {
-    if (heap != nullptr) {
-        vtr::free(heap + 1);
-        heap = nullptr;
+    t_heap_state& heap_state = local_heap_state();
+    if (heap_state.heap != nullptr) {
+        vtr::free(heap_state.heap + 1);
+        heap_state.heap = nullptr;
     }
-    heap_size = (grid.width() - 1) * (grid.height() - 1);
-    heap = (t_heap**)vtr::malloc(heap_size * sizeof(t_heap*));
-    heap--; /* heap stores from [1..heap_size] */
-    heap_tail = 1;
+    heap_state.heap_size = (grid.width() - 1) * (grid.height() - 1);
+    heap_state.heap = (t_heap**)vtr::malloc(heap_state.heap_size * sizeof(t_heap*));
+    heap_state.heap--; /* heap stores from [1..heap_size] */
+    heap_state.heap_tail = 1;
 }
 
 /* Call this before you route any nets.  It frees any old traceback and   *
@@ -512,7 +558,7 @@ void init_route_structs(int bb_factor) {
     /* Check that things that should have been emptied after the last routing *
      * really were.                                                           */
 
-    if (heap_tail != 1) {
+    if (local_heap_state().heap_tail != 1) {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
                         "in init_route_structs. Heap is not empty.\n");
     }
@@ -954,41 +1000,67 @@ void free_trace_structs() {
     }
 }
 
-void free_route_structs() {
-    /* Frees the temporary storage needed only during the routing.  The  *
-     * final routing result is not freed.                                */
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
-
-    if (heap != nullptr) {
+static void free_heap_state(t_heap_state& heap_state) {
+    if (heap_state.heap != nullptr) {
         //Free the individiaul heap elements (calls destructors)
-        for (int i = 1; i < num_heap_allocated; i++) {
-            VTR_LOG("Freeing %p\n", heap[i]);
-            vtr::chunk_delete(heap[i], &heap_ch);
+        for (int i = 1; i < heap_state.num_heap_allocated; i++) {
+            VTR_LOG("Freeing %p\n", heap_state.heap[i]);
+            vtr::chunk_delete(heap_state.heap[i], &heap_state.heap_ch);
         }
 
         // coverity[offset_free : Intentional]
-        free(heap + 1);
+        free(heap_state.heap + 1);
 
-        heap = nullptr; /* Defensive coding:  crash hard if I use these. */
+        heap_state.heap = nullptr; /* Defensive coding:  crash hard if I use these. */
     }
 
-    if (heap_free_head != nullptr) {
-        t_heap* curr = heap_free_head;
+    if (heap_state.heap_free_head != nullptr) {
+        t_heap* curr = heap_state.heap_free_head;
         while (curr) {
             t_heap* tmp = curr;
             curr = curr->u.next;
 
-            vtr::chunk_delete(tmp, &heap_ch);
+            vtr::chunk_delete(tmp, &heap_state.heap_ch);
         }
 
-        heap_free_head = nullptr;
+        heap_state.heap_free_head = nullptr;
+    }
+
+    /*free the memory chunks that were used by heap */
+    free_chunk_memory(&heap_state.heap_ch);
+}
+
+void free_route_structs() {
+    /* Frees the temporary storage needed only during the routing.  The  *
+     * final routing result is not freed.                                */
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    /* Free the heap of every worker which has routed a net */
+#if defined(VPR_USE_TBB)
+    for (t_heap_state& heap_state : heap_states) {
+        free_heap_state(heap_state);
+        heap_state = t_heap_state();
     }
+#else
+    free_heap_state(heap_states);
+#endif
+
     if (route_ctx.route_bb.size() != 0) {
         route_ctx.route_bb.clear();
     }
+}
 
-    /*free the memory chunks that were used by heap and linked f pointer */
-    free_chunk_memory(&heap_ch);
+/* Returns the number of heap data structures in use by all the workers */
+static int get_num_heap_allocated() {
+#if defined(VPR_USE_TBB)
+    int num_heap_allocated = 0;
+    for (const t_heap_state& heap_state : heap_states) {
+        num_heap_allocated += heap_state.num_heap_allocated;
+    }
+    return num_heap_allocated;
+#else
+    return heap_states.num_heap_allocated;
+#endif
 }
 
 /* Frees the data structures needed to save a routing.                     */
@@ -1214,57 +1286,65 @@ size_t parent(size_t i) { return i >> 1; }
 // child indices of a heap
 size_t left(size_t i) { return i << 1; }
 size_t right(size_t i) { return (i << 1) + 1; }
-size_t size() { return static_cast<size_t>(heap_tail - 1); } // heap[0] is not valid element
+size_t size() { return static_cast<size_t>(local_heap_state().heap_tail - 1); } // heap[0] is not valid element
 
 // make a heap rooted at index i by **sifting down** in O(lgn) time
 void sift_down(size_t hole) {
-    t_heap* head{heap[hole]};
+    t_heap_state& heap_state = local_heap_state();
+    t_heap* head{heap_state.heap[hole]};
     size_t child{left(hole)};
-    while ((int)child < heap_tail) {
-        if ((int)child + 1 < heap_tail && heap[child + 1]->cost < heap[child]->cost)
+    while ((int)child < heap_state.heap_tail) {
+        if ((int)child + 1 < heap_state.heap_tail && heap_state.heap[child + 1]->cost < heap_state.heap[child]->cost)
             ++child;
-        if (heap[child]->cost < head->cost) {
-            heap[hole] = heap[child];
+        if (heap_state.heap[child]->cost < head->cost) {
+            heap_state.heap[hole] = heap_state.heap[child];
             hole = child;
             child = left(child);
         } else
             break;
     }
-    heap[hole] = head;
+    heap_state.heap[hole] = head;
 }
 
 // runs in O(n) time by sifting down; the least work is done on the most elements: 1 swap for bottom layer, 2 swap for 2nd, ... lgn swap for top
 // 1*(n/2) + 2*(n/4) + 3*(n/8) + ... + lgn*1 = 2n (sum of i/2^i)
 void build_heap() {
+    t_heap_state& heap_state = local_heap_state();
     // second half of heap are leaves
-    for (size_t i = heap_tail >> 1; i != 0; --i)
+    for (size_t i = heap_state.heap_tail >> 1; i != 0; --i)
         sift_down(i);
 }
 
 // O(lgn) sifting up to maintain heap property after insertion (should sift down when building heap)
 void sift_up(size_t leaf, t_heap* const node) {
-    while ((leaf > 1) && (node->cost < heap[parent(leaf)]->cost)) {
+    t_heap_state& heap_state = local_heap_state();
+    while ((leaf > 1) && (node->cost < heap_state.heap[parent(leaf)]->cost)) {
         // sift hole up
-        heap[leaf] = heap[parent(leaf)];
+        heap_state.heap[leaf] = heap_state.heap[parent(leaf)];
         leaf = parent(leaf);
     }
-    heap[leaf] = node;
+    heap_state.heap[leaf] = node;
 }
 
 void expand_heap_if_full() {
-    if (heap_tail > heap_size) { /* Heap is full */
-        heap_size *= 2;
-        heap = (t_heap**)vtr::realloc((void*)(heap + 1),
-                                      heap_size * sizeof(t_heap*));
-        heap--; /* heap goes from [1..heap_size] */
+    t_heap_state& heap_state = local_heap_state();
+    if (heap_state.heap == nullptr) { /* First use of the heap by this thread */
+        init_heap(g_vpr_ctx.device().grid);
+    }
+    if (heap_state.heap_tail > heap_state.heap_size) { /* Heap is full */
+        heap_state.heap_size *= 2;
+        heap_state.heap = (t_heap**)vtr::realloc((void*)(heap_state.heap + 1),
+                                                 heap_state.heap_size * sizeof(t_heap*));
+        heap_state.heap--; /* heap goes from [1..heap_size] */
     }
 }
 
 // adds an element to the back of heap and expand if necessary, but does not maintain heap property
 void push_back(t_heap* const hptr) {
+    t_heap_state& heap_state = local_heap_state();
     expand_heap_if_full();
-    heap[heap_tail] = hptr;
-    ++heap_tail;
+    heap_state.heap[heap_state.heap_tail] = hptr;
+    ++heap_state.heap_tail;
 }
 
 void push_back_node(const RRNodeId& inode, float total_cost, const RRNodeId& prev_node, const RREdgeId& prev_edge, float backward_path_cost, float R_upstream) {
@@ -1287,9 +1367,10 @@ void push_back_node(const RRNodeId& inode, float total_cost, const RRNodeId& pre
 }
 
 bool is_valid() {
-    for (size_t i = 1; (int)i <= heap_tail >> 1; ++i) {
-        if ((int)left(i) < heap_tail && heap[left(i)]->cost < heap[i]->cost) return false;
-        if ((int)right(i) < heap_tail && heap[right(i)]->cost < heap[i]->cost) return false;
+    t_heap_state& heap_state = local_heap_state();
+    for (size_t i = 1; (int)i <= heap_state.heap_tail >> 1; ++i) {
+        if ((int)left(i) < heap_state.heap_tail && heap_state.heap[left(i)]->cost < heap_state.heap[i]->cost) return false;
+        if ((int)right(i) < heap_state.heap_tail && heap_state.heap[right(i)]->cost < heap_state.heap[i]->cost) return false;
     }
     return true;
 }
@@ -1301,15 +1382,17 @@ void pop_heap() {
 }
 // print every element; not necessarily in order for minheap
 void print_heap() {
-    for (int i = 1; i<heap_tail>> 1; ++i)
-        VTR_LOG("(%e %e %e) ", heap[i]->cost, heap[left(i)]->cost, heap[right(i)]->cost);
+    t_heap_state& heap_state = local_heap_state();
+    for (int i = 1; i<heap_state.heap_tail>> 1; ++i)
+        VTR_LOG("(%e %e %e) ", heap_state.heap[i]->cost, heap_state.heap[left(i)]->cost, heap_state.heap[right(i)]->cost);
     VTR_LOG("\n");
 }
 // verify correctness of extract top by making a copy, sorting it, and iterating it at the same time as extraction
 void verify_extract_top() {
     constexpr float float_epsilon = 1e-20;
+    t_heap_state& heap_state = local_heap_state();
     std::cout << "copying heap\n";
-    std::vector<t_heap*> heap_copy{heap + 1, heap + heap_tail};
+    std::vector<t_heap*> heap_copy{heap_state.heap + 1, heap_state.heap + heap_state.heap_tail};
     // sort based on cost with cheapest first
     VTR_ASSERT(heap_copy.size() == size());
     std::sort(begin(heap_copy), end(heap_copy),
@@ -1334,15 +1417,17 @@ void verify_extract_top() {
 } // namespace heap_
 // adds to heap and maintains heap quality
 void add_to_heap(t_heap* hptr) {
+    t_heap_state& heap_state = local_heap_state();
     heap_::expand_heap_if_full();
     // start with undefined hole
-    ++heap_tail;
-    heap_::sift_up(heap_tail - 1, hptr);
+    ++heap_state.heap_tail;
+    heap_::sift_up(heap_state.heap_tail - 1, hptr);
 }
 
 /*WMF: peeking accessor :) */
 bool is_empty_heap() {
-    return (bool)(heap_tail == 1);
+    t_heap_state& heap_state = local_heap_state();
+    return (bool)(heap_state.heap_tail == 1);
 }
 
 t_heap*
@@ -1351,28 +1436,29 @@ get_heap_head() {
      * heap is empty.  Invalid (index == OPEN) entries on the heap are never     *
      * returned -- they are just skipped over.                                   */
 
+    t_heap_state& heap_state = local_heap_state();
     t_heap* cheapest;
     size_t hole, child;
 
     do {
-        if (heap_tail == 1) { /* Empty heap. */
+        if (heap_state.heap_tail == 1) { /* Empty heap. */
             VTR_LOG_WARN("Empty heap occurred in get_heap_head.\n");
             return (nullptr);
         }
 
-        cheapest = heap[1];
+        cheapest = heap_state.heap[1];
 
         hole = 1;
         child = 2;
-        --heap_tail;
-        while ((int)child < heap_tail) {
-            if (heap[child + 1]->cost < heap[child]->cost)
+        --heap_state.heap_tail;
+        while ((int)child < heap_state.heap_tail) {
+            if (heap_state.heap[child + 1]->cost < heap_state.heap[child]->cost)
                 ++child; // become right child
-            heap[hole] = heap[child];
+            heap_state.heap[hole] = heap_state.heap[child];
             hole = child;
             child = heap_::left(child);
         }
-        heap_::sift_up(hole, heap[heap_tail]);
+        heap_::sift_up(hole, heap_state.heap[heap_state.heap_tail]);
 
     } while (cheapest->index == RRNodeId::INVALID()); /* Get another one if invalid entry. */
 
@@ -1380,23 +1466,25 @@ get_heap_head() {
 }
 
 void empty_heap() {
-    for (int i = 1; i < heap_tail; i++)
-        free_heap_data(heap[i]);
+    t_heap_state& heap_state = local_heap_state();
+    for (int i = 1; i < heap_state.heap_tail; i++)
+        free_heap_data(heap_state.heap[i]);
 
-    heap_tail = 1;
+    heap_state.heap_tail = 1;
 }
 
 t_heap*
 alloc_heap_data() {
-    if (heap_free_head == nullptr) { /* No elements on the free list */
-        heap_free_head = vtr::chunk_new<t_heap>(&heap_ch);
+    t_heap_state& heap_state = local_heap_state();
+    if (heap_state.heap_free_head == nullptr) { /* No elements on the free list */
+        heap_state.heap_free_head = vtr::chunk_new<t_heap>(&heap_state.heap_ch);
     }
 
     //Extract the head
-    t_heap* temp_ptr = heap_free_head;
-    heap_free_head = heap_free_head->u.next;
+    t_heap* temp_ptr = heap_state.heap_free_head;
+    heap_state.heap_free_head = heap_state.heap_free_head->u.next;
 
-    num_heap_allocated++;
+    heap_state.num_heap_allocated++;
 
     //Reset
     temp_ptr->u.next = nullptr;
@@ -1410,9 +1498,10 @@ alloc_heap_data() {
 }
 
 void free_heap_data(t_heap* hptr) {
-    hptr->u.next = heap_free_head;
-    heap_free_head = hptr;
-    num_heap_allocated--;
+    t_heap_state& heap_state = local_heap_state();
+    hptr->u.next = heap_state.heap_free_head;
+    heap_state.heap_free_head = hptr;
+    heap_state.num_heap_allocated--;
 }
 
 void invalidate_heap_entries(const RRNodeId& sink_node, const RRNodeId& ipin_node) {
@@ -1420,20 +1509,34 @@ void invalidate_heap_entries(const RRNodeId& sink_node, const RRNodeId& ipin_nod
      * via ipin_node, as invalid (OPEN).  Used only by the breadth_first router *
      * and even then only in rare circumstances.                                */
 
-    for (int i = 1; i < heap_tail; i++) {
-        if (heap[i]->index == sink_node) {
-            if (heap[i]->u.prev.node == ipin_node) {
-                heap[i]->index = RRNodeId::INVALID(); /* Invalid. */
+    t_heap_state& heap_state = local_heap_state();
+    for (int i = 1; i < heap_state.heap_tail; i++) {
+        if (heap_state.heap[i]->index == sink_node) {
+            if (heap_state.heap[i]->u.prev.node == ipin_node) {
+                heap_state.heap[i]->index = RRNodeId::INVALID(); /* Invalid. */
                 break;
             }
         }
     }
 }
 
+#if defined(VPR_USE_TBB)
+void set_trace_free_list_shared(bool shared) {
+    trace_free_list_shared = shared;
+}
+#endif
+
 t_trace*
 alloc_trace_data() {
     t_trace* temp_ptr;
 
+#if defined(VPR_USE_TBB)
+    tbb::spin_mutex::scoped_lock lock;
+    if (trace_free_list_shared) {
+        lock.acquire(trace_free_list_mutex);
+    }
+#endif
+
     if (trace_free_head == nullptr) { /* No elements on the free list */
         trace_free_head = (t_trace*)vtr::chunk_malloc(sizeof(t_trace), &trace_ch);
         trace_free_head->next = nullptr;
@@ -1446,6 +1549,12 @@ alloc_trace_data() {
 
 void free_trace_data(t_trace* tptr) {
     /* Puts the traceback structure pointed to by tptr on the free list. */
+#if defined(VPR_USE_TBB)
+    tbb::spin_mutex::scoped_lock lock;
+    if (trace_free_list_shared) {
+        lock.acquire(trace_free_list_mutex);
+    }
+#endif
 
     tptr->next = trace_free_head;
     trace_free_head = tptr;
@@ -1600,7 +1709,7 @@ void print_route(const char* placement_file, const char* route_file) {
     if (getEchoEnabled() && isEchoFileEnabled(E_ECHO_MEM)) {
         fp = vtr::fopen(getEchoFileName(E_ECHO_MEM), "w");
         fprintf(fp, "\nNum_heap_allocated: %d   Num_trace_allocated: %d\n",
-                num_heap_allocated, num_trace_allocated);
+                get_num_heap_allocated(), num_trace_allocated);
         fprintf(fp, "Num_linked_f_pointer_allocated: %d\n",
                 num_linked_f_pointer_allocated);
         fclose(fp);
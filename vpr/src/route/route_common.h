@@ -136,4 +136,9 @@ void print_invalid_routing_info();
 t_trace* alloc_trace_data();
 void free_trace_data(t_trace* trace);
 
+#if defined(VPR_USE_TBB)
+/* Guard the free list of traceback data while several nets are routed at the same time */
+void set_trace_free_list_shared(bool shared);
+#endif
+
 bool router_needs_lookahead(enum e_router_algorithm router_algorithm);
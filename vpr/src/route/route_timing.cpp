@@ -4,6 +4,7 @@
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
+#include <memory>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -37,6 +38,11 @@
 
 #include "tatum/TimingReporter.hpp"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#    include <tbb/enumerable_thread_specific.h>
+#endif
+
 #define CONGESTED_SLOPE_VAL -0.04
 
 enum class RouterCongestionMode {
@@ -130,7 +136,8 @@ struct RoutingMetrics {
 
 //Run-time flag to control when router debug information is printed
 //Note only enables debug output if compiled with VTR_ENABLE_DEBUG_LOGGING defined
-bool f_router_debug = false;
+//The flag is per thread, since each thread sets it for the net it is routing
+thread_local bool f_router_debug = false;
 
 /******************** Subroutines local to route_timing.c ********************/
 
@@ -262,6 +269,23 @@ void reduce_budgets_if_congested(route_budgets& budgeting_inf,
                                  int itry);
 
 static bool should_route_net(ClusterNetId net_id, CBRR& connections_inf, bool if_force_reroute);
+
+static bool can_route_nets_in_parallel(const t_router_opts& router_opts);
+static int get_max_rr_node_span();
+static std::vector<std::vector<ClusterNetId>> build_parallel_routing_levels(const std::vector<ClusterNetId>& sorted_nets, int max_rr_node_span);
+static bool try_parallel_timing_driven_route_nets(const std::vector<ClusterNetId>& sorted_nets,
+                                                  int max_rr_node_span,
+                                                  int itry,
+                                                  float pres_fac,
+                                                  const t_router_opts& router_opts,
+                                                  CBRR& connections_inf,
+                                                  RouterStats& router_stats,
+                                                  vtr::vector<ClusterNetId, float*>& net_delay,
+                                                  const RouterLookahead& router_lookahead,
+                                                  const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                                  std::shared_ptr<SetupTimingInfo> timing_info,
+                                                  route_budgets& budgeting_inf,
+                                                  std::vector<ClusterNetId>& rerouted_nets);
 static bool early_exit_heuristic(const t_router_opts& router_opts, const WirelengthInfo& wirelength_info);
 
 struct more_sinks_than {
@@ -354,6 +378,15 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
 
     float high_effort_congestion_mode_iteration_threshold = router_opts.congested_routing_iteration_threshold_frac * router_opts.max_router_iterations;
 
+    /*
+     * Configure parallel net routing
+     */
+    bool route_nets_in_parallel = can_route_nets_in_parallel(router_opts);
+    int max_rr_node_span = 0;
+    if (route_nets_in_parallel) {
+        max_rr_node_span = get_max_rr_node_span();
+    }
+
     /* Set delay of ignored signals to zero. Non-ignored net delays are set by
      * update_net_delays_from_route_tree() inside timing_driven_route_net(),
      * which is only called for non-ignored nets. */
@@ -452,28 +485,47 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
         /*
          * Route each net
          */
-        for (auto net_id : sorted_nets) {
-            bool was_rerouted = false;
-            bool is_routable = try_timing_driven_route_net(net_id,
-                                                           itry,
-                                                           pres_fac,
-                                                           router_opts,
-                                                           connections_inf,
-                                                           router_iteration_stats,
-                                                           route_structs.pin_criticality,
-                                                           route_structs.rt_node_of_sink,
-                                                           net_delay,
-                                                           *router_lookahead,
-                                                           netlist_pin_lookup,
-                                                           route_timing_info,
-                                                           budgeting_inf,
-                                                           was_rerouted);
+        if (route_nets_in_parallel) {
+            bool is_routable = try_parallel_timing_driven_route_nets(sorted_nets,
+                                                                     max_rr_node_span,
+                                                                     itry,
+                                                                     pres_fac,
+                                                                     router_opts,
+                                                                     connections_inf,
+                                                                     router_iteration_stats,
+                                                                     net_delay,
+                                                                     *router_lookahead,
+                                                                     netlist_pin_lookup,
+                                                                     route_timing_info,
+                                                                     budgeting_inf,
+                                                                     rerouted_nets);
             if (!is_routable) {
                 return (false); //Impossible to route
             }
+        } else {
+            for (auto net_id : sorted_nets) {
+                bool was_rerouted = false;
+                bool is_routable = try_timing_driven_route_net(net_id,
+                                                               itry,
+                                                               pres_fac,
+                                                               router_opts,
+                                                               connections_inf,
+                                                               router_iteration_stats,
+                                                               route_structs.pin_criticality,
+                                                               route_structs.rt_node_of_sink,
+                                                               net_delay,
+                                                               *router_lookahead,
+                                                               netlist_pin_lookup,
+                                                               route_timing_info,
+                                                               budgeting_inf,
+                                                               was_rerouted);
+                if (!is_routable) {
+                    return (false); //Impossible to route
+                }
 
-            if (was_rerouted) {
-                rerouted_nets.push_back(net_id);
+                if (was_rerouted) {
+                    rerouted_nets.push_back(net_id);
+                }
             }
         }
 
@@ -829,6 +881,251 @@ bool try_timing_driven_route_net(ClusterNetId net_id,
     return (is_routed);
 }
 
+//Returns true if the nets can be routed in parallel.
+//
+//The parallel router relies on each net only touching the rr_nodes which overlap its
+//bounding box, and on the routing of a net not modifying any data shared by other nets.
+//Otherwise the router falls back to routing the nets serially.
+static bool can_route_nets_in_parallel(const t_router_opts& router_opts) {
+    if (!router_opts.parallel_route_nets) {
+        return false;
+    }
+
+#if defined(VPR_USE_TBB)
+    auto& device_ctx = g_vpr_ctx.device();
+
+    if (!device_ctx.rr_non_config_node_sets.empty()) {
+        //Non-configurable edges may pull nodes outside of the net bounding box into the routing
+        VTR_LOG_WARN("Routing nets serially: the routing resource graph contains non-configurable edges\n");
+        return false;
+    }
+
+    for (size_t index = CHANX_COST_INDEX_START; index < device_ctx.rr_indexed_data.size(); index++) {
+        if (device_ctx.rr_indexed_data[index].T_quadratic > 0.) {
+            //See update_rr_base_costs()
+            VTR_LOG_WARN("Routing nets serially: the base costs of pass-transistor wires depend on the fanout of the net being routed\n");
+            return false;
+        }
+    }
+
+    if (router_opts.router_debug_net >= -1 || router_opts.router_debug_sink_rr >= 0) {
+        VTR_LOG_WARN("Routing nets serially: router debugging is enabled\n");
+        return false;
+    }
+
+    VTR_LOG("Routing nets in parallel\n");
+    return true;
+#else
+    VTR_LOG_WARN("Routing nets serially: VPR was built without the TBB execution engine\n");
+    return false;
+#endif
+}
+
+//Returns the largest number of grid locations spanned by a rr_node, in either dimension
+static int get_max_rr_node_span() {
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    int max_span = 0;
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        max_span = std::max(max_span, rr_graph.node_xhigh(node) - rr_graph.node_xlow(node));
+        max_span = std::max(max_span, rr_graph.node_yhigh(node) - rr_graph.node_ylow(node));
+    }
+    return max_span;
+}
+
+//Groups the nets into levels which can be routed one after another.
+//
+//A net only touches the rr_nodes overlapping its bounding box. Two nets may
+//compete for a rr_node only if their bounding boxes are at most max_rr_node_span
+//apart in both dimensions. Such nets are put in different levels, keeping their
+//serial routing order, while the nets of a level touch disjoint sets of rr_nodes.
+//Routing the levels in order, and the nets of each level concurrently, therefore
+//produces exactly the same routing as the serial router.
+//
+//A net also rips up its current routing, which may lie outside its bounding box
+//(e.g. once load_route_bb() has shrunk a box grown by dynamic_update_bounding_boxes()),
+//so the box of each net covers its current routing as well.
+//
+//Global nets may be routed to a dedicated clock network outside of their bounding
+//box, so each of them gets a level of its own which is ordered after all the
+//previous nets and before all the following ones.
+static std::vector<std::vector<ClusterNetId>> build_parallel_routing_levels(const std::vector<ClusterNetId>& sorted_nets, int max_rr_node_span) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    //The bounding boxes are stretched by the node span to their top-right,
+    //so that two nets may compete for a rr_node only if their stretched bounding boxes overlap
+    int width = device_ctx.grid.width() + max_rr_node_span;
+    int height = device_ctx.grid.height() + max_rr_node_span;
+
+    //The last level assigned to a net covering each grid location
+    vtr::Matrix<int> loc_levels({size_t(width), size_t(height)}, -1);
+
+    int barrier_level = -1; //Level of the last global net
+    int max_level = -1;
+
+    std::vector<std::vector<ClusterNetId>> levels;
+    for (ClusterNetId net_id : sorted_nets) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            continue; //Never routed
+        }
+
+        int level = barrier_level + 1;
+        if (cluster_ctx.clb_nlist.net_is_global(net_id)) {
+            level = max_level + 1;
+            barrier_level = level;
+        } else {
+            t_bb bb = route_ctx.route_bb[net_id];
+            const t_trace* routing_head = route_ctx.trace[net_id].head;
+            if (routing_head != nullptr) {
+                t_bb curr_bb = calc_current_bb(routing_head);
+                bb.xmin = std::min(bb.xmin, curr_bb.xmin);
+                bb.ymin = std::min(bb.ymin, curr_bb.ymin);
+                bb.xmax = std::max(bb.xmax, curr_bb.xmax);
+                bb.ymax = std::max(bb.ymax, curr_bb.ymax);
+            }
+            int xmin = std::max(bb.xmin, 0);
+            int ymin = std::max(bb.ymin, 0);
+            int xmax = std::min(bb.xmax + max_rr_node_span, width - 1);
+            int ymax = std::min(bb.ymax + max_rr_node_span, height - 1);
+
+            for (int x = xmin; x <= xmax; ++x) {
+                for (int y = ymin; y <= ymax; ++y) {
+                    level = std::max(level, loc_levels[x][y] + 1);
+                }
+            }
+            for (int x = xmin; x <= xmax; ++x) {
+                for (int y = ymin; y <= ymax; ++y) {
+                    loc_levels[x][y] = level;
+                }
+            }
+        }
+
+        if (size_t(level) >= levels.size()) {
+            levels.resize(level + 1);
+        }
+        levels[level].push_back(net_id);
+        max_level = std::max(max_level, level);
+    }
+
+    return levels;
+}
+
+//Routes the nets level by level (see build_parallel_routing_levels()), with the nets of
+//each level routed concurrently. Each worker owns its heap, route tree free lists and
+//per-net buffers, while the nets of a level update the congestion of disjoint rr_nodes.
+//The per-net results are committed in the serial routing order once a level is done.
+static bool try_parallel_timing_driven_route_nets(const std::vector<ClusterNetId>& sorted_nets,
+                                                  int max_rr_node_span,
+                                                  int itry,
+                                                  float pres_fac,
+                                                  const t_router_opts& router_opts,
+                                                  CBRR& connections_inf,
+                                                  RouterStats& router_stats,
+                                                  vtr::vector<ClusterNetId, float*>& net_delay,
+                                                  const RouterLookahead& router_lookahead,
+                                                  const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                                  std::shared_ptr<SetupTimingInfo> timing_info,
+                                                  route_budgets& budgeting_inf,
+                                                  std::vector<ClusterNetId>& rerouted_nets) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    //Settle the lazily built look-ups and the base costs shared by all the nets,
+    //so that the worker threads only read them
+    device_ctx.rr_graph.initialize_fast_node_lookup();
+    update_rr_base_costs(1);
+
+    std::vector<std::vector<ClusterNetId>> levels = build_parallel_routing_levels(sorted_nets, max_rr_node_span);
+
+    //Per-worker buffers indexed by net pin, and the per-net targets of the connection
+    //based rerouting, which share the per-net lookups of connections_inf
+    struct t_net_route_buffers {
+        std::vector<float> pin_criticality;
+        std::vector<t_rt_node*> rt_node_of_sink;
+        std::unique_ptr<CBRR> connections_inf;
+    };
+    size_t max_pins_per_net = get_max_pins_per_net();
+    auto alloc_route_buffers = [&]() {
+        t_net_route_buffers buffers;
+        buffers.pin_criticality.resize(max_pins_per_net);
+        buffers.rt_node_of_sink.resize(max_pins_per_net);
+        buffers.connections_inf = std::make_unique<CBRR>(connections_inf);
+        return buffers;
+    };
+#if defined(VPR_USE_TBB)
+    tbb::enumerable_thread_specific<t_net_route_buffers> route_buffers(alloc_route_buffers);
+#else
+    t_net_route_buffers route_buffers = alloc_route_buffers();
+#endif
+
+    std::vector<bool> net_rerouted(cluster_ctx.clb_nlist.nets().size(), false);
+    std::vector<RouterStats> net_stats;
+    std::vector<char> net_routable;
+    std::vector<char> net_was_rerouted;
+
+    for (const std::vector<ClusterNetId>& level_nets : levels) {
+        net_stats.assign(level_nets.size(), RouterStats());
+        net_routable.assign(level_nets.size(), false);
+        net_was_rerouted.assign(level_nets.size(), false);
+
+        auto route_one_net = [&](size_t inet, t_net_route_buffers& buffers) {
+            bool was_rerouted = false;
+            net_routable[inet] = try_timing_driven_route_net(level_nets[inet],
+                                                             itry,
+                                                             pres_fac,
+                                                             router_opts,
+                                                             *buffers.connections_inf,
+                                                             net_stats[inet],
+                                                             buffers.pin_criticality.data(),
+                                                             buffers.rt_node_of_sink.data(),
+                                                             net_delay,
+                                                             router_lookahead,
+                                                             netlist_pin_lookup,
+                                                             timing_info,
+                                                             budgeting_inf,
+                                                             was_rerouted);
+            net_was_rerouted[inet] = was_rerouted;
+        };
+
+#if defined(VPR_USE_TBB)
+        set_trace_free_list_shared(true);
+        tbb::parallel_for(size_t(0), level_nets.size(), [&](size_t inet) {
+            route_one_net(inet, route_buffers.local());
+        });
+        set_trace_free_list_shared(false);
+#else
+        for (size_t inet = 0; inet < level_nets.size(); ++inet) {
+            route_one_net(inet, route_buffers);
+        }
+#endif
+
+        //Commit the results in order
+        for (size_t inet = 0; inet < level_nets.size(); ++inet) {
+            if (!net_routable[inet]) {
+                return false; //Impossible to route
+            }
+            net_rerouted[size_t(level_nets[inet])] = net_was_rerouted[inet];
+
+            router_stats.connections_routed += net_stats[inet].connections_routed;
+            router_stats.nets_routed += net_stats[inet].nets_routed;
+            router_stats.heap_pushes += net_stats[inet].heap_pushes;
+            router_stats.heap_pops += net_stats[inet].heap_pops;
+        }
+    }
+
+    //Report the rerouted nets in the serial routing order
+    for (ClusterNetId net_id : sorted_nets) {
+        if (net_rerouted[size_t(net_id)]) {
+            rerouted_nets.push_back(net_id);
+        }
+    }
+
+    return true;
+}
+
 /*
  * NOTE:
  * Suggest using a timing_driven_route_structs struct. Memory is managed for you
@@ -2254,10 +2551,14 @@ void update_rr_base_costs(int fanout) {
     factor = sqrt(fanout);
 
     for (index = CHANX_COST_INDEX_START; index < device_ctx.rr_indexed_data.size(); index++) {
+        float base_cost = device_ctx.rr_indexed_data[index].saved_base_cost;
         if (device_ctx.rr_indexed_data[index].T_quadratic > 0.) { /* pass transistor */
-            device_ctx.rr_indexed_data[index].base_cost = device_ctx.rr_indexed_data[index].saved_base_cost * factor;
-        } else {
-            device_ctx.rr_indexed_data[index].base_cost = device_ctx.rr_indexed_data[index].saved_base_cost;
+            base_cost *= factor;
+        }
+        /* Only write on changes: when no base cost depends on the fanout,
+         * nets routed in parallel never modify the shared costs */
+        if (device_ctx.rr_indexed_data[index].base_cost != base_cost) {
+            device_ctx.rr_indexed_data[index].base_cost = base_cost;
         }
     }
 }
@@ -2360,9 +2661,8 @@ static bool early_exit_heuristic(const t_router_opts& router_opts, const Wirelen
 
 // incremental rerouting resources class definitions
 Connection_based_routing_resources::Connection_based_routing_resources()
-    : current_inet(NO_PREVIOUS)
-    , // not routing to a specific net yet (note that NO_PREVIOUS is not unsigned, so will be largest unsigned)
-    last_stable_critical_path_delay{0.0f}
+    : owner{this}
+    , last_stable_critical_path_delay{0.0f}
     , critical_path_growth_tolerance{1.001f}
     , connection_criticality_tolerance{0.9f}
     , connection_delay_optimality_tolerance{1.1f} {
@@ -2379,6 +2679,9 @@ Connection_based_routing_resources::Connection_based_routing_resources()
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& route_ctx = g_vpr_ctx.routing();
 
+    // not routing to a specific net yet (note that NO_PREVIOUS is not unsigned, so will be largest unsigned)
+    current_inet = ClusterNetId(NO_PREVIOUS);
+
     // can have as many targets as sink pins (total number of pins - SOURCE pin)
     // supposed to be used as persistent vector growing with push_back and clearing at the start of each net routing iteration
     auto max_sink_pins_per_net = std::max(get_max_pins_per_net() - 1, 0);
@@ -2411,13 +2714,28 @@ Connection_based_routing_resources::Connection_based_routing_resources()
     }
 }
 
+Connection_based_routing_resources::Connection_based_routing_resources(Connection_based_routing_resources& owner_resources)
+    : owner{owner_resources.owner}
+    , last_stable_critical_path_delay{owner_resources.last_stable_critical_path_delay}
+    , critical_path_growth_tolerance{owner_resources.critical_path_growth_tolerance}
+    , connection_criticality_tolerance{owner_resources.connection_criticality_tolerance}
+    , connection_delay_optimality_tolerance{owner_resources.connection_delay_optimality_tolerance} {
+    /* Only the per-net targets are owned by a worker,
+     * the per-net lookups are read and updated through its owner */
+    current_inet = ClusterNetId(NO_PREVIOUS);
+
+    auto max_sink_pins_per_net = std::max(get_max_pins_per_net() - 1, 0);
+    remaining_targets.reserve(max_sink_pins_per_net);
+    reached_rt_sinks.reserve(max_sink_pins_per_net);
+}
+
 void Connection_based_routing_resources::convert_sink_nodes_to_net_pins(std::vector<int>& rr_sink_nodes) const {
     /* Turn a vector of device_ctx.rr_nodes indices, assumed to be of sinks for a net *
      * into the pin indices of the same net. */
 
     VTR_ASSERT(current_inet != ClusterNetId::INVALID()); // not uninitialized
 
-    const auto& node_to_pin_mapping = rr_sink_node_to_pin[current_inet];
+    const auto& node_to_pin_mapping = owner->rr_sink_node_to_pin[current_inet];
 
     for (size_t s = 0; s < rr_sink_nodes.size(); ++s) {
         auto mapping = node_to_pin_mapping.find(rr_sink_nodes[s]);
@@ -2437,7 +2755,7 @@ void Connection_based_routing_resources::put_sink_rt_nodes_in_net_pins_lookup(co
     VTR_ASSERT(current_inet != ClusterNetId::INVALID());
 
     // a net specific mapping from node index to pin index
-    const auto& node_to_pin_mapping = rr_sink_node_to_pin[current_inet];
+    const auto& node_to_pin_mapping = owner->rr_sink_node_to_pin[current_inet];
 
     for (t_rt_node* rt_node : sink_rt_nodes) {
         /* Xifan Tang - TODO: should use RRNodeId later */
@@ -2544,14 +2862,14 @@ bool Connection_based_routing_resources::forcibly_reroute_connections(float max_
 }
 
 void Connection_based_routing_resources::clear_force_reroute_for_connection(int rr_sink_node) {
-    forcible_reroute_connection_flag[current_inet][rr_sink_node] = false;
+    owner->forcible_reroute_connection_flag[current_inet][rr_sink_node] = false;
     profiling::perform_forced_reroute();
 }
 
 void Connection_based_routing_resources::clear_force_reroute_for_net() {
     VTR_ASSERT(current_inet != ClusterNetId::INVALID());
 
-    auto& net_flags = forcible_reroute_connection_flag[current_inet];
+    auto& net_flags = owner->forcible_reroute_connection_flag[current_inet];
     for (auto& force_reroute_flag : net_flags) {
         if (force_reroute_flag.second) {
             force_reroute_flag.second = false;
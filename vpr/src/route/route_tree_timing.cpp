@@ -15,6 +15,10 @@
 #include "route_common.h"
 #include "route_tree_timing.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/enumerable_thread_specific.h>
+#endif
+
 /* This module keeps track of the partial routing tree for timing-driven     *
  * routing.  The normal traceback structure doesn't provide enough info      *
  * about the partial routing during timing-driven routing, so the routines   *
@@ -30,12 +34,28 @@
 static vtr::vector<RRNodeId, t_rt_node*> rr_node_to_rt_node; /* [0..device_ctx.rr_graph.nodes().size()-1] */
 
 /* Frees lists for fast addition and deletion of nodes and edges. */
-
-static t_rt_node* rt_node_free_list = nullptr;
-static t_linked_rt_edge* rt_edge_free_list = nullptr;
+struct t_rt_free_lists {
+    t_rt_node* rt_node_free_list = nullptr;
+    t_linked_rt_edge* rt_edge_free_list = nullptr;
+};
+
+/* Each worker of the parallel router owns its free lists, as route trees are
+ * built by the worker routing the net. free_route_tree_timing_structs() frees
+ * the lists of all the workers. Each thread caches its own lists, which are
+ * emptied but never erased. */
+#if defined(VPR_USE_TBB)
+static tbb::enumerable_thread_specific<t_rt_free_lists> rt_free_lists;
+static thread_local t_rt_free_lists* thread_rt_free_lists = nullptr;
+#else
+static t_rt_free_lists rt_free_lists;
+#endif
 
 /********************** Subroutines local to this module *********************/
 
+static t_rt_free_lists& local_rt_free_lists();
+
+static void free_rt_free_lists(t_rt_free_lists& free_lists);
+
 static t_rt_node* alloc_rt_node();
 
 static void free_rt_node(t_rt_node* rt_node);
@@ -74,7 +94,7 @@ bool alloc_route_tree_timing_structs(bool exists_ok) {
     auto& device_ctx = g_vpr_ctx.device();
 
     bool route_tree_structs_are_allocated = (rr_node_to_rt_node.size() == size_t(device_ctx.rr_graph.nodes().size())
-                                             || rt_node_free_list != nullptr);
+                                             || local_rt_free_lists().rt_node_free_list != nullptr);
     if (route_tree_structs_are_allocated) {
         if (exists_ok) {
             return false;
@@ -89,16 +109,23 @@ bool alloc_route_tree_timing_structs(bool exists_ok) {
     return true;
 }
 
-void free_route_tree_timing_structs() {
-    /* Frees the structures needed to build routing trees, and really frees
-     * (i.e. calls free) all the data on the free lists.                         */
+/* Returns the free lists of the calling worker */
+static t_rt_free_lists& local_rt_free_lists() {
+#if defined(VPR_USE_TBB)
+    if (thread_rt_free_lists == nullptr) {
+        thread_rt_free_lists = &rt_free_lists.local();
+    }
+    return *thread_rt_free_lists;
+#else
+    return rt_free_lists;
+#endif
+}
 
+static void free_rt_free_lists(t_rt_free_lists& free_lists) {
     t_rt_node *rt_node, *next_node;
     t_linked_rt_edge *rt_edge, *next_edge;
 
-    rr_node_to_rt_node.clear();
-
-    rt_node = rt_node_free_list;
+    rt_node = free_lists.rt_node_free_list;
 
     while (rt_node != nullptr) {
         next_node = rt_node->u.next;
@@ -106,9 +133,9 @@ void free_route_tree_timing_structs() {
         rt_node = next_node;
     }
 
-    rt_node_free_list = nullptr;
+    free_lists.rt_node_free_list = nullptr;
 
-    rt_edge = rt_edge_free_list;
+    rt_edge = free_lists.rt_edge_free_list;
 
     while (rt_edge != nullptr) {
         next_edge = rt_edge->next;
@@ -116,7 +143,22 @@ void free_route_tree_timing_structs() {
         rt_edge = next_edge;
     }
 
-    rt_edge_free_list = nullptr;
+    free_lists.rt_edge_free_list = nullptr;
+}
+
+void free_route_tree_timing_structs() {
+    /* Frees the structures needed to build routing trees, and really frees
+     * (i.e. calls free) all the data on the free lists of every worker.         */
+
+    rr_node_to_rt_node.clear();
+
+#if defined(VPR_USE_TBB)
+    for (t_rt_free_lists& free_lists : rt_free_lists) {
+        free_rt_free_lists(free_lists);
+    }
+#else
+    free_rt_free_lists(rt_free_lists);
+#endif
 }
 
 static t_rt_node*
@@ -124,12 +166,13 @@ alloc_rt_node() {
     /* Allocates a new rt_node, from the free list if possible, from the free
      * store otherwise.                                                         */
 
+    t_rt_free_lists& free_lists = local_rt_free_lists();
     t_rt_node* rt_node;
 
-    rt_node = rt_node_free_list;
+    rt_node = free_lists.rt_node_free_list;
 
     if (rt_node != nullptr) {
-        rt_node_free_list = rt_node->u.next;
+        free_lists.rt_node_free_list = rt_node->u.next;
     } else {
         rt_node = (t_rt_node*)vtr::malloc(sizeof(t_rt_node));
     }
@@ -140,8 +183,9 @@ alloc_rt_node() {
 static void free_rt_node(t_rt_node* rt_node) {
     /* Adds rt_node to the proper free list.          */
 
-    rt_node->u.next = rt_node_free_list;
-    rt_node_free_list = rt_node;
+    t_rt_free_lists& free_lists = local_rt_free_lists();
+    rt_node->u.next = free_lists.rt_node_free_list;
+    free_lists.rt_node_free_list = rt_node;
 }
 
 static t_linked_rt_edge*
@@ -149,12 +193,13 @@ alloc_linked_rt_edge() {
     /* Allocates a new linked_rt_edge, from the free list if possible, from the
      * free store otherwise.                                                     */
 
+    t_rt_free_lists& free_lists = local_rt_free_lists();
     t_linked_rt_edge* linked_rt_edge;
 
-    linked_rt_edge = rt_edge_free_list;
+    linked_rt_edge = free_lists.rt_edge_free_list;
 
     if (linked_rt_edge != nullptr) {
-        rt_edge_free_list = linked_rt_edge->next;
+        free_lists.rt_edge_free_list = linked_rt_edge->next;
     } else {
         linked_rt_edge = (t_linked_rt_edge*)vtr::malloc(sizeof(t_linked_rt_edge));
     }
@@ -165,8 +210,9 @@ alloc_linked_rt_edge() {
 
 /* Adds the rt_edge to the rt_edge free list.                       */
 static void free_linked_rt_edge(t_linked_rt_edge* rt_edge) {
-    rt_edge->next = rt_edge_free_list;
-    rt_edge_free_list = rt_edge;
+    t_rt_free_lists& free_lists = local_rt_free_lists();
+    rt_edge->next = free_lists.rt_edge_free_list;
+    free_lists.rt_edge_free_list = rt_edge;
 }
 
 /* Initializes the routing tree to just the net source, and returns the root
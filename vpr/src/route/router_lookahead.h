@@ -72,12 +72,8 @@ class MapLookahead : public RouterLookahead {
   protected:
     float get_expected_cost(const RRNodeId& node, const RRNodeId& target_node, const t_conn_cost_params& params, float R_upstream) const override;
     void compute(const std::vector<t_segment_inf>& segment_inf) override;
-    void read(const std::string& /*file*/) override {
-        VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::read unimplemented");
-    }
-    void write(const std::string& /*file*/) const override {
-        VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::write unimplemented");
-    }
+    void read(const std::string& file) override;
+    void write(const std::string& file) const override;
 };
 
 class NoOpLookahead : public RouterLookahead {
@@ -25,9 +25,22 @@
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
+#include "vtr_hash.h"
 #include "rr_graph_obj_util.h"
 #include "router_lookahead_map.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "map_lookahead.capnp.h"
+#    include "ndmatrix_serdes.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
 /* the cost map is computed by running a Dijkstra search from channel segment rr nodes at the specified reference coordinate */
 #define REF_X 3
 #define REF_Y 3
@@ -97,6 +110,14 @@ class Expansion_Cost_Entry {
             this->cost_vector.push_back(cost_entry);
         }
     }
+    /* adds all the cost entries recorded by another expansion, in the order they were recorded there.
+     * merging the entries of several Dijkstra runs in a fixed order gives the same result as recording
+     * them one run after another */
+    void merge_cost_entries(const Expansion_Cost_Entry& other) {
+        for (const Cost_Entry& cost_entry : other.cost_vector) {
+            this->add_cost_entry(cost_entry.delay, cost_entry.congestion);
+        }
+    }
     void clear_cost_entries() {
         this->cost_vector.clear();
     }
@@ -184,6 +205,13 @@ typedef vtr::NdMatrix<Cost_Entry, 4> t_cost_map; //[0..1][[0..num_seg_types-1]0.
  * the list at each coordinate is later boiled down to a single representative cost entry to be stored in the final cost map */
 typedef vtr::Matrix<Expansion_Cost_Entry> t_routing_cost_map; //[0..device_ctx.grid.width()-1][0..device_ctx.grid.height()-1]
 
+/* the start node of one Dijkstra expansion and the reference coordinate it is run from */
+struct t_dijkstra_start {
+    RRNodeId node;
+    int x;
+    int y;
+};
+
 /******** File-Scope Variables ********/
 /* The cost map */
 t_cost_map f_cost_map;
@@ -198,6 +226,8 @@ static RRNodeId get_start_node_ind(int start_x, int start_y, int target_x, int t
 static void run_dijkstra(const RRNodeId& start_node_ind, int start_x, int start_y, t_routing_cost_map& routing_cost_map);
 /* iterates over the children of the specified node and selectively pushes them onto the priority queue */
 static void expand_dijkstra_neighbours(PQ_Entry parent_entry, vtr::vector<RRNodeId, float>& node_visited_costs, vtr::vector<RRNodeId, bool>& node_expanded, std::priority_queue<PQ_Entry>& pq);
+/* adds the cost entries recorded by one Dijkstra run to the cost entries of its segment/channel type */
+static void merge_routing_cost_map(t_routing_cost_map& routing_cost_map, const t_routing_cost_map& run_cost_map);
 /* sets the lookahead cost map entries based on representative cost entries from routing_cost_map */
 static void set_lookahead_map_costs(int segment_index, e_rr_type chan_type, t_routing_cost_map& routing_cost_map);
 /* fills in missing lookahead map entries by copying the cost of the closest valid entry */
@@ -253,37 +283,74 @@ void compute_router_lookahead(int num_segments) {
     free_cost_map();
     alloc_cost_map(num_segments);
 
-    /* run Dijkstra's algorithm for each segment type & channel type combination */
+    /* find the start nodes of the Dijkstra runs for each segment type & channel type combination.
+     * This is done ahead of the expansion since looking up rr nodes may (re)build the fast node look-up
+     * of the rr graph, which is not safe to do from several threads */
+    std::vector<std::vector<t_dijkstra_start>> start_nodes(2 * num_segments); //[0..num_segments-1][CHANX/CHANY]
     for (int iseg = 0; iseg < num_segments; iseg++) {
         for (e_rr_type chan_type : {CHANX, CHANY}) {
-            /* allocate the cost map for this iseg/chan_type */
-            t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
-
+            std::vector<t_dijkstra_start>& group_start_nodes = start_nodes[2 * iseg + (chan_type == CHANY ? 1 : 0)];
             for (int ref_inc = 0; ref_inc < 3; ref_inc++) {
                 for (int track_offset = 0; track_offset < MAX_TRACK_OFFSET; track_offset += 2) {
                     /* get the rr node index from which to start routing */
                     RRNodeId start_node_ind = get_start_node_ind(REF_X + ref_inc, REF_Y + ref_inc,
-                                                            device_ctx.grid.width() - 2, device_ctx.grid.height() - 2, //non-corner upper right
-                                                            chan_type, iseg, track_offset);
+                                                                 device_ctx.grid.width() - 2, device_ctx.grid.height() - 2, //non-corner upper right
+                                                                 chan_type, iseg, track_offset);
 
                     if (start_node_ind == RRNodeId::INVALID()) {
                         continue;
                     }
 
-                    /* run Dijkstra's algorithm */
-                    run_dijkstra(start_node_ind, REF_X + ref_inc, REF_Y + ref_inc, routing_cost_map);
+                    group_start_nodes.push_back({start_node_ind, REF_X + ref_inc, REF_Y + ref_inc});
                 }
             }
+        }
+    }
 
-            /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
-             * cost map */
-            set_lookahead_map_costs(iseg, chan_type, routing_cost_map);
+    /* run Dijkstra's algorithm for each segment type & channel type combination.
+     * Each combination only writes its own slice of the lookahead cost map, and each Dijkstra run only reads
+     * the rr graph and records into its own routing cost map. The runs of a combination are merged in
+     * the order of their start nodes, so that the result does not depend on the number of threads */
+    auto compute_one_cost_map = [&](size_t igroup) {
+        int iseg = igroup / 2;
+        e_rr_type chan_type = (igroup % 2 == 0) ? CHANX : CHANY;
+        const std::vector<t_dijkstra_start>& group_start_nodes = start_nodes[igroup];
+
+        std::vector<t_routing_cost_map> run_cost_maps(group_start_nodes.size());
+        auto run_one_dijkstra = [&](size_t irun) {
+            run_cost_maps[irun] = t_routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
+            run_dijkstra(group_start_nodes[irun].node, group_start_nodes[irun].x, group_start_nodes[irun].y, run_cost_maps[irun]);
+        };
+#if defined(VPR_USE_TBB)
+        tbb::parallel_for(size_t(0), group_start_nodes.size(), run_one_dijkstra);
+#else
+        for (size_t irun = 0; irun < group_start_nodes.size(); irun++) {
+            run_one_dijkstra(irun);
+        }
+#endif
 
-            /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
-             * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed) */
-            fill_in_missing_lookahead_entries(iseg, chan_type);
+        /* allocate the cost map for this iseg/chan_type */
+        t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
+        for (const t_routing_cost_map& run_cost_map : run_cost_maps) {
+            merge_routing_cost_map(routing_cost_map, run_cost_map);
         }
+        run_cost_maps.clear();
+
+        /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
+         * cost map */
+        set_lookahead_map_costs(iseg, chan_type, routing_cost_map);
+
+        /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
+         * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed) */
+        fill_in_missing_lookahead_entries(iseg, chan_type);
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), start_nodes.size(), compute_one_cost_map);
+#else
+    for (size_t igroup = 0; igroup < start_nodes.size(); igroup++) {
+        compute_one_cost_map(igroup);
     }
+#endif
 
     if (false) print_cost_map();
 }
@@ -424,6 +491,18 @@ static void expand_dijkstra_neighbours(PQ_Entry parent_entry, vtr::vector<RRNode
     }
 }
 
+/* adds the cost entries recorded by one Dijkstra run to the cost entries of its segment/channel type */
+static void merge_routing_cost_map(t_routing_cost_map& routing_cost_map, const t_routing_cost_map& run_cost_map) {
+    VTR_ASSERT(routing_cost_map.dim_size(0) == run_cost_map.dim_size(0));
+    VTR_ASSERT(routing_cost_map.dim_size(1) == run_cost_map.dim_size(1));
+
+    for (unsigned ix = 0; ix < routing_cost_map.dim_size(0); ix++) {
+        for (unsigned iy = 0; iy < routing_cost_map.dim_size(1); iy++) {
+            routing_cost_map[ix][iy].merge_cost_entries(run_cost_map[ix][iy]);
+        }
+    }
+}
+
 /* sets the lookahead cost map entries based on representative cost entries from routing_cost_map */
 static void set_lookahead_map_costs(int segment_index, e_rr_type chan_type, t_routing_cost_map& routing_cost_map) {
     int chan_index = 0;
@@ -676,3 +755,117 @@ static void print_cost_map() {
         }
     }
 }
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void read_router_lookahead(const std::string& /*file*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::read " DISABLE_ERROR);
+}
+
+void write_router_lookahead(const std::string& /*file*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::write " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/* Computes a fingerprint of everything the cost map depends on: the device grid, the connectivity of the
+ * routing resource graph and the delay/base costs of the rr indexed data.
+ * A cost map read from a file is only valid when the fingerprint matches the current device */
+static size_t compute_router_lookahead_fingerprint() {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    size_t fingerprint = 0;
+    /* Change the format version whenever the way to compute the cost map changes */
+    vtr::hash_combine(fingerprint, size_t(1));
+    vtr::hash_combine(fingerprint, int(REPRESENTATIVE_ENTRY_METHOD));
+
+    vtr::hash_combine(fingerprint, device_ctx.grid.width());
+    vtr::hash_combine(fingerprint, device_ctx.grid.height());
+    for (size_t ix = 0; ix < device_ctx.grid.width(); ix++) {
+        for (size_t iy = 0; iy < device_ctx.grid.height(); iy++) {
+            t_physical_tile_type_ptr type = device_ctx.grid[ix][iy].type;
+            vtr::hash_combine(fingerprint, nullptr == type ? -1 : type->index);
+        }
+    }
+
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        vtr::hash_combine(fingerprint, int(rr_graph.node_type(node)));
+        vtr::hash_combine(fingerprint, rr_graph.node_xlow(node));
+        vtr::hash_combine(fingerprint, rr_graph.node_ylow(node));
+        vtr::hash_combine(fingerprint, rr_graph.node_xhigh(node));
+        vtr::hash_combine(fingerprint, rr_graph.node_yhigh(node));
+        vtr::hash_combine(fingerprint, rr_graph.node_ptc_num(node));
+        vtr::hash_combine(fingerprint, rr_graph.node_cost_index(node));
+        for (const RREdgeId& edge : rr_graph.node_out_edges(node)) {
+            vtr::hash_combine(fingerprint, size_t(rr_graph.edge_sink_node(edge)));
+        }
+    }
+
+    for (const t_rr_indexed_data& indexed_data : device_ctx.rr_indexed_data) {
+        vtr::hash_combine(fingerprint, indexed_data.seg_index);
+        vtr::hash_combine(fingerprint, indexed_data.base_cost);
+        vtr::hash_combine(fingerprint, indexed_data.T_linear);
+    }
+
+    return fingerprint;
+}
+
+static void ToCostEntry(Cost_Entry* out, const VprCostEntry::Reader& in) {
+    out->delay = in.getDelay();
+    out->congestion = in.getCongestion();
+}
+
+static void FromCostEntry(VprCostEntry::Builder* out, const Cost_Entry& in) {
+    out->setDelay(in.delay);
+    out->setCongestion(in.congestion);
+}
+
+void read_router_lookahead(const std::string& file) {
+    vtr::ScopedStartFinishTimer timer("Loading router lookahead map");
+
+    auto& device_ctx = g_vpr_ctx.device();
+
+    /* The file is mapped to memory, and unmapped when leaving the scope */
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData());
+    auto lookahead = reader.getRoot<VprMapLookahead>();
+
+    /* Reject a cost map which is computed for another device, as it would silently mislead the router */
+    if (lookahead.getFingerprint() != compute_router_lookahead_fingerprint()) {
+        VPR_THROW(VPR_ERROR_ROUTE,
+                  "Router lookahead map '%s' does not match the current device and routing resource graph. Re-compute it without --read_router_lookahead",
+                  file.c_str());
+    }
+
+    f_cost_map.clear();
+    ToNdMatrix<4, VprCostEntry, Cost_Entry>(&f_cost_map, lookahead.getCostMap(), ToCostEntry);
+
+    if (2 != f_cost_map.dim_size(0)
+        || device_ctx.grid.width() != f_cost_map.dim_size(2)
+        || device_ctx.grid.height() != f_cost_map.dim_size(3)) {
+        VPR_THROW(VPR_ERROR_ROUTE,
+                  "Router lookahead map '%s' has dimensions inconsistent with the device grid (%zux%zu)",
+                  file.c_str(), device_ctx.grid.width(), device_ctx.grid.height());
+    }
+}
+
+void write_router_lookahead(const std::string& file) {
+    vtr::ScopedStartFinishTimer timer("Writing router lookahead map");
+
+    ::capnp::MallocMessageBuilder builder;
+    auto lookahead = builder.initRoot<VprMapLookahead>();
+
+    lookahead.setFingerprint(compute_router_lookahead_fingerprint());
+
+    auto cost_map = lookahead.getCostMap();
+    FromNdMatrix<4, VprCostEntry, Cost_Entry>(&cost_map, f_cost_map, FromCostEntry);
+
+    writeMessageToFile(file, &builder);
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -368,6 +368,8 @@ void create_rr_graph(const t_graph_type graph_type,
                                                     &det_routing_arch->wire_to_rr_ipin_switch,
                                                     trim_obs_channels, /* Allow/Prohibit through tracks across multi-height and multi-width grids */
                                                     false, /* Do not allow passing tracks to be wired to the same routing channels */
+                                                    det_routing_arch->rr_graph_snapshot_dir,
+                                                    det_routing_arch->arch_file_name,
                                                     Warnings);
         }
 
@@ -4,6 +4,7 @@
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
@@ -585,6 +586,119 @@ bool RRGSB::is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const {
   return true;
 }
 
+/************************************************************************
+ * Get a fingerprint of the switch block, which is canonical for mirror equivalence
+ * Only the features which is_sb_mirror() compares by equality are included:
+ * 1. Number of sides 
+ * For each side whose channel width is not zero
+ * 2. Number of channel/opin/ipin rr_nodes
+ * 3. Directionality of each channel rr_node
+ * For each OUT_PORT channel rr_node
+ * 4. If it is a passing wire
+ * 5. The type, switch, side and index of each driving rr_node
+ *
+ * Note that segment ids are not considered here as
+ * they are not required to be the same by is_sb_mirror()
+ ***********************************************************************/
+size_t RRGSB::get_sb_fingerprint(const RRGraph& rr_graph) const {
+  size_t fingerprint = 0;
+
+  vtr::hash_combine(fingerprint, get_num_sides());
+
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    e_side side_enum = side_manager.get_side();
+
+    /* Sides without routing tracks are bypassed by is_sb_mirror() */
+    if (0 == get_chan_width(side_enum)) {
+      continue;
+    }
+
+    vtr::hash_combine(fingerprint, side);
+    vtr::hash_combine(fingerprint, get_chan_width(side_enum));
+    vtr::hash_combine(fingerprint, get_num_opin_nodes(side_enum));
+    vtr::hash_combine(fingerprint, get_num_ipin_nodes(side_enum));
+
+    for (size_t itrack = 0; itrack < get_chan_width(side_enum); ++itrack) {
+      vtr::hash_combine(fingerprint, size_t(get_chan_node_direction(side_enum, itrack)));
+
+      /* Only OUT_PORT rr_node has its fan-in checked */
+      if (OUT_PORT != get_chan_node_direction(side_enum, itrack)) {
+        continue;
+      }
+
+      bool is_short_conkt = is_sb_node_passing_wire(rr_graph, side_enum, itrack);
+      vtr::hash_combine(fingerprint, is_short_conkt);
+      if (true == is_short_conkt) {
+        continue;
+      }
+
+      std::vector<RREdgeId> node_in_edges = get_chan_node_in_edges(rr_graph, side_enum, itrack);
+      vtr::hash_combine(fingerprint, node_in_edges.size());
+      for (const RREdgeId& edge : node_in_edges) {
+        RRNodeId src_node = rr_graph.edge_src_node(edge);
+        vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(src_node)));
+        vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(edge)));
+
+        int src_node_id;
+        enum e_side src_node_side; 
+        get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side, src_node_id);
+        vtr::hash_combine(fingerprint, size_t(src_node_side));
+        vtr::hash_combine(fingerprint, src_node_id);
+      }
+    }
+  }
+
+  return fingerprint;
+}
+
+/************************************************************************
+ * Get a fingerprint of the connection block, which is canonical for mirror equivalence
+ * Only the features which is_cb_mirror() compares by equality are included:
+ * 1. Channel width, type, directionality and segment ids of channel rr_nodes
+ * 2. Number of ipin rr_nodes on each side 
+ * 3. The type, switch and index (and side for OPINs) of each driving rr_node of ipins
+ ***********************************************************************/
+size_t RRGSB::get_cb_fingerprint(const RRGraph& rr_graph, const t_rr_type& cb_type) const {
+  size_t fingerprint = 0;
+
+  vtr::hash_combine(fingerprint, get_cb_chan_width(cb_type));
+
+  enum e_side chan_side = get_cb_chan_side(cb_type);
+  const RRChan& rr_chan = chan_node_[size_t(chan_side)];
+  vtr::hash_combine(fingerprint, size_t(rr_chan.get_type()));
+  for (size_t inode = 0; inode < rr_chan.get_chan_width(); ++inode) {
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(rr_chan.get_node(inode))));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_direction(rr_chan.get_node(inode))));
+    vtr::hash_combine(fingerprint, size_t(rr_chan.get_node_segment(inode)));
+  }
+
+  for (const e_side& ipin_side : get_cb_ipin_sides(cb_type)) {
+    vtr::hash_combine(fingerprint, get_num_ipin_nodes(ipin_side));
+    for (size_t inode = 0; inode < get_num_ipin_nodes(ipin_side); ++inode) {
+      RRNodeId ipin_node = get_ipin_node(ipin_side, inode);
+      vtr::hash_combine(fingerprint, size_t(rr_graph.node_in_edges(ipin_node).size()));
+      for (const RREdgeId& edge : rr_graph.node_in_edges(ipin_node)) {
+        RRNodeId src_node = rr_graph.edge_src_node(edge);
+        vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(src_node)));
+        vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(edge)));
+
+        int src_node_id = -1;
+        enum e_side src_node_side = NUM_SIDES; 
+        if (OPIN == rr_graph.node_type(src_node)) {
+          get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side, src_node_id);
+        } else {
+          src_node_id = get_chan_node_index(chan_side, src_node);
+        }
+        vtr::hash_combine(fingerprint, size_t(src_node_side));
+        vtr::hash_combine(fingerprint, src_node_id);
+      }
+    }
+  }
+
+  return fingerprint;
+}
+
 /* Public Accessors: Cooridinator conversion */
 
 /* get the x coordinate of this GSB */
@@ -167,6 +167,18 @@ class RRGSB {
      */
     bool is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const; 
 
+    /* Get a structural fingerprint of the switch block
+     * Two switch blocks which are mirrors (see is_sb_mirror()) always have the same fingerprint,
+     * so that the fingerprint can be used to bucket the candidates 
+     * before running the complete mirror checking 
+     */
+    size_t get_sb_fingerprint(const RRGraph& rr_graph) const;
+
+    /* Get a structural fingerprint of the X/Y-direction connection block
+     * Two connection blocks which are mirrors (see is_cb_mirror()) always have the same fingerprint
+     */
+    size_t get_cb_fingerprint(const RRGraph& rr_graph, const t_rr_type& cb_type) const;
+
   public: /* Cooridinator conversion and output  */
     size_t get_x() const; /* get the x coordinate of this switch block */
     size_t get_y() const; /* get the y coordinate of this switch block */
@@ -23,6 +23,7 @@
 #include "tileable_chan_details_builder.h"
 #include "tileable_rr_graph_node_builder.h"
 #include "tileable_rr_graph_edge_builder.h"
+#include "tileable_rr_graph_snapshot.h"
 #include "tileable_rr_graph_builder.h"
 
 #include "globals.h"
@@ -85,6 +86,8 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
                                     int* wire_to_rr_ipin_switch,
                                     const bool& through_channel,
                                     const bool& wire_opposite_side,
+                                    const std::string& snapshot_dir,
+                                    const std::string& arch_file_name,
                                     int *Warnings) { 
 
   vtr::ScopedStartFinishTimer timer("Build tileable routing resource graph");
@@ -137,126 +140,158 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
   VTR_ASSERT(true == device_ctx.rr_graph.valid_switch_id(wire_to_ipin_rr_switch)); 
   VTR_ASSERT(true == device_ctx.rr_graph.valid_switch_id(delayless_rr_switch)); 
 
-  /* A temp data about the driver switch ids for each rr_node */
-  vtr::vector<RRNodeId, RRSwitchId> rr_node_driver_switches; 
+  /* Global routing uses a single longwire track */
+  int max_chan_width = find_unidir_routing_channel_width(chan_width.max);
+  VTR_ASSERT(max_chan_width > 0);
 
+  /************************************************************************
+   * Load the nodes and edges from a snapshot if a snapshot directory is given
+   * and a snapshot has been taken for the same device. 
+   * Otherwise, build them and take a snapshot for the next runs
+   ***********************************************************************/
   /* A temp data about the track ids for each CHANX and CHANY rr_node */
   std::map<RRNodeId, std::vector<size_t>> rr_node_track_ids;
 
-  /************************
-   * Allocate the rr_nodes 
-   ************************/
-  alloc_tileable_rr_graph_nodes(device_ctx.rr_graph,
-                                rr_node_driver_switches,
-                                grids,
-                                device_chan_width,
-                                segment_inf,
-                                through_channel);
-
-  /************************
-   * Create all the rr_nodes 
-   ************************/
-  create_tileable_rr_graph_nodes(device_ctx.rr_graph,
-                                 rr_node_driver_switches,
-                                 rr_node_track_ids,
-                                 grids,
-                                 device_chan_width,
-                                 segment_inf,
-                                 wire_to_ipin_rr_switch,
-                                 delayless_rr_switch,
-                                 through_channel);
+  std::string snapshot_file;
+  size_t snapshot_fingerprint = 0;
+  bool snapshot_loaded = false;
+  if (false == snapshot_dir.empty()) {
+    snapshot_fingerprint = tileable_rr_graph_fingerprint(arch_file_name, grids, chan_width,
+                                                         sb_type, Fs, sb_subtype, subFs,
+                                                         through_channel, wire_opposite_side);
+    snapshot_file = tileable_rr_graph_snapshot_file(snapshot_dir, snapshot_fingerprint);
+    snapshot_loaded = read_tileable_rr_graph_snapshot(snapshot_file, snapshot_fingerprint,
+                                                      device_ctx.rr_graph, rr_node_track_ids);
+  }
 
-  /************************************************************************
-   * Create the connectivity of OPINs
-   *   a. Evenly assign connections to OPINs to routing tracks
-   *   b. the connection pattern should be same across the fabric
-   *
-   * Create the connectivity of IPINs 
-   *   a. Evenly assign connections from routing tracks to IPINs
-   *   b. the connection pattern should be same across the fabric
-   ***********************************************************************/
-  /* Global routing uses a single longwire track */
-  int max_chan_width = find_unidir_routing_channel_width(chan_width.max);
-  VTR_ASSERT(max_chan_width > 0);
+  if (false == snapshot_loaded) {
+    /* A temp data about the driver switch ids for each rr_node */
+    vtr::vector<RRNodeId, RRSwitchId> rr_node_driver_switches; 
+
+    /************************
+     * Allocate the rr_nodes 
+     ************************/
+    alloc_tileable_rr_graph_nodes(device_ctx.rr_graph,
+                                  rr_node_driver_switches,
+                                  grids,
+                                  device_chan_width,
+                                  segment_inf,
+                                  through_channel);
+
+    /************************
+     * Create all the rr_nodes 
+     ************************/
+    create_tileable_rr_graph_nodes(device_ctx.rr_graph,
+                                   rr_node_driver_switches,
+                                   rr_node_track_ids,
+                                   grids,
+                                   device_chan_width,
+                                   segment_inf,
+                                   wire_to_ipin_rr_switch,
+                                   delayless_rr_switch,
+                                   through_channel);
+
+    /************************************************************************
+     * Create the connectivity of OPINs
+     *   a. Evenly assign connections to OPINs to routing tracks
+     *   b. the connection pattern should be same across the fabric
+     *
+     * Create the connectivity of IPINs 
+     *   a. Evenly assign connections from routing tracks to IPINs
+     *   b. the connection pattern should be same across the fabric
+     ***********************************************************************/
+
+    /* get maximum number of pins across all blocks */
+    int max_pins = types[0].num_pins;
+    for (const auto& type : types) {
+      if (is_empty_type(&type)) {
+        continue;
+      }
+
+      if (type.num_pins > max_pins) {
+        max_pins = type.num_pins;
+      }
+    }
+    
+    /* Fc assignment still uses the old function from VPR.
+     * Should use tileable version so that we have can have full control
+     */
+    std::vector<size_t> num_tracks = get_num_tracks_per_seg_type(max_chan_width / 2, segment_inf, false);  
+    int* sets_per_seg_type = (int*)vtr::malloc(sizeof(int) * segment_inf.size());
+    VTR_ASSERT(num_tracks.size() == segment_inf.size());
+    for (size_t iseg = 0; iseg < num_tracks.size(); ++iseg) {
+      sets_per_seg_type[iseg] = num_tracks[iseg];
+    }
 
-  /* get maximum number of pins across all blocks */
-  int max_pins = types[0].num_pins;
-  for (const auto& type : types) {
-    if (is_empty_type(&type)) {
-      continue;
+    bool Fc_clipped = false;
+    /* [0..num_types-1][0..num_pins-1] */
+    std::vector<vtr::Matrix<int>> Fc_in;
+    Fc_in = alloc_and_load_actual_fc(types, max_pins, segment_inf, sets_per_seg_type, max_chan_width,
+                                     e_fc_type::IN, UNI_DIRECTIONAL, &Fc_clipped);
+    if (Fc_clipped) {
+      *Warnings |= RR_GRAPH_WARN_FC_CLIPPED;
     }
 
-    if (type.num_pins > max_pins) {
-      max_pins = type.num_pins;
+    Fc_clipped = false;
+    /* [0..num_types-1][0..num_pins-1] */
+    std::vector<vtr::Matrix<int>> Fc_out;
+    Fc_out = alloc_and_load_actual_fc(types, max_pins, segment_inf, sets_per_seg_type, max_chan_width,
+                                      e_fc_type::OUT, UNI_DIRECTIONAL, &Fc_clipped);
+
+    if (Fc_clipped) {
+      *Warnings |= RR_GRAPH_WARN_FC_CLIPPED;
     }
-  }
-    
-  /* Fc assignment still uses the old function from VPR.
-   * Should use tileable version so that we have can have full control
-   */
-  std::vector<size_t> num_tracks = get_num_tracks_per_seg_type(max_chan_width / 2, segment_inf, false);  
-  int* sets_per_seg_type = (int*)vtr::malloc(sizeof(int) * segment_inf.size());
-  VTR_ASSERT(num_tracks.size() == segment_inf.size());
-  for (size_t iseg = 0; iseg < num_tracks.size(); ++iseg) {
-    sets_per_seg_type[iseg] = num_tracks[iseg];
-  }
 
-  bool Fc_clipped = false;
-  /* [0..num_types-1][0..num_pins-1] */
-  std::vector<vtr::Matrix<int>> Fc_in;
-  Fc_in = alloc_and_load_actual_fc(types, max_pins, segment_inf, sets_per_seg_type, max_chan_width,
-                                   e_fc_type::IN, UNI_DIRECTIONAL, &Fc_clipped);
-  if (Fc_clipped) {
-    *Warnings |= RR_GRAPH_WARN_FC_CLIPPED;
-  }
+    /************************************************************************
+     * Build the connections tile by tile:
+     * We classify rr_nodes into a general switch block (GSB) data structure
+     * where we create edges to each rr_nodes in the GSB with respect to
+     * Fc_in and Fc_out, switch block patterns 
+     * In addition, we will also handle direct-connections:
+     * Add edges that bridge OPINs and IPINs to the rr_graph
+     ***********************************************************************/
+    /* Create edges for a tileable rr_graph */
+    build_rr_graph_edges(device_ctx.rr_graph,
+                         rr_node_driver_switches,
+                         grids,
+                         device_chan_width,
+                         segment_inf, 
+                         Fc_in, Fc_out,
+                         sb_type, Fs, sb_subtype, subFs,
+                         wire_opposite_side);
+
+    /************************************************************************
+     * Build direction connection lists
+     * TODO: use tile direct builder
+     ***********************************************************************/
+    /* Create data structure of direct-connections */
+    t_clb_to_clb_directs* clb_to_clb_directs = NULL;
+    if (num_directs > 0) {
+      clb_to_clb_directs = alloc_and_load_clb_to_clb_directs(directs, num_directs, delayless_switch);
+    }
+    std::vector<t_direct_inf> arch_directs;
+    std::vector<t_clb_to_clb_directs> clb2clb_directs;
+    for (int idirect = 0; idirect < num_directs; ++idirect) {
+      arch_directs.push_back(directs[idirect]);
+      clb2clb_directs.push_back(clb_to_clb_directs[idirect]);
+    }
 
-  Fc_clipped = false;
-  /* [0..num_types-1][0..num_pins-1] */
-  std::vector<vtr::Matrix<int>> Fc_out;
-  Fc_out = alloc_and_load_actual_fc(types, max_pins, segment_inf, sets_per_seg_type, max_chan_width,
-                                    e_fc_type::OUT, UNI_DIRECTIONAL, &Fc_clipped);
+    build_rr_graph_direct_connections(device_ctx.rr_graph, grids, delayless_rr_switch, 
+                                      arch_directs, clb2clb_directs);
 
-  if (Fc_clipped) {
-    *Warnings |= RR_GRAPH_WARN_FC_CLIPPED;
-  }
+    /* Free all temp stucts */
+    free(sets_per_seg_type);
 
-  /************************************************************************
-   * Build the connections tile by tile:
-   * We classify rr_nodes into a general switch block (GSB) data structure
-   * where we create edges to each rr_nodes in the GSB with respect to
-   * Fc_in and Fc_out, switch block patterns 
-   * In addition, we will also handle direct-connections:
-   * Add edges that bridge OPINs and IPINs to the rr_graph
-   ***********************************************************************/
-  /* Create edges for a tileable rr_graph */
-  build_rr_graph_edges(device_ctx.rr_graph,
-                       rr_node_driver_switches,
-                       grids,
-                       device_chan_width,
-                       segment_inf, 
-                       Fc_in, Fc_out,
-                       sb_type, Fs, sb_subtype, subFs,
-                       wire_opposite_side);
+    if (nullptr != clb_to_clb_directs) {
+      free(clb_to_clb_directs);
+    }
 
-  /************************************************************************
-   * Build direction connection lists
-   * TODO: use tile direct builder
-   ***********************************************************************/
-  /* Create data structure of direct-connections */
-  t_clb_to_clb_directs* clb_to_clb_directs = NULL;
-  if (num_directs > 0) {
-    clb_to_clb_directs = alloc_and_load_clb_to_clb_directs(directs, num_directs, delayless_switch);
-  }
-  std::vector<t_direct_inf> arch_directs;
-  std::vector<t_clb_to_clb_directs> clb2clb_directs;
-  for (int idirect = 0; idirect < num_directs; ++idirect) {
-    arch_directs.push_back(directs[idirect]);
-    clb2clb_directs.push_back(clb_to_clb_directs[idirect]);
+    if (false == snapshot_file.empty()) {
+      write_tileable_rr_graph_snapshot(snapshot_file, snapshot_fingerprint,
+                                       device_ctx.rr_graph, rr_node_track_ids);
+    }
   }
 
-  build_rr_graph_direct_connections(device_ctx.rr_graph, grids, delayless_rr_switch, 
-                                    arch_directs, clb2clb_directs);
-
   /* First time to build edges so that we can remap the architecture switch to rr_switch
    * This is a must-do before function alloc_and_load_rr_switch_inf() 
    */
@@ -316,14 +351,6 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
               "but not smooth\n");
   }
 
-  /************************************************************************
-   * Free all temp stucts 
-   ***********************************************************************/
-  free(sets_per_seg_type);
-
-  if (nullptr != clb_to_clb_directs) {
-    free(clb_to_clb_directs);
-  }
 }
 
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include <vector>
 
 #include "physical_types.h"
@@ -32,6 +33,8 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
                                     int* wire_to_rr_ipin_switch,
                                     const bool& through_channel,
                                     const bool& wire_opposite_side,
+                                    const std::string& snapshot_dir,
+                                    const std::string& arch_file_name,
                                     int *Warnings); 
 
 } /* end namespace openfpga */
@@ -9,6 +9,10 @@
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "vpr_utils.h"
 
 #include "rr_graph_builder_utils.h"
@@ -86,6 +90,13 @@ void build_rr_graph_edges_for_sink_nodes(RRGraph& rr_graph,
  * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks)
  * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks)
  * 3. create edges between OPINs and IPINs (direct-connections)
+ *
+ * The edges are built in two phases:
+ * 1. The edge lists of the GSBs are collected in parallel.
+ *    This phase only reads the rr_graph. 
+ * 2. The edges are added to the rr_graph GSB by GSB, after a single
+ *    reservation. The GSBs are visited in the same order as a serial
+ *    build, so that the edge ids do not depend on the number of threads
  ***********************************************************************/
 void build_rr_graph_edges(RRGraph& rr_graph, 
                           const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches,
@@ -104,37 +115,64 @@ void build_rr_graph_edges(RRGraph& rr_graph,
 
   vtr::Point<size_t> gsb_range(grids.width() - 2, grids.height() - 2);
 
-  /* Go Switch Block by Switch Block */
-  for (size_t ix = 0; ix <= gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy <= gsb_range.y(); ++iy) { 
-      //vpr_printf(TIO_MESSAGE_INFO, "Building edges for GSB[%lu][%lu]\n", ix, iy);
-
-      vtr::Point<size_t> gsb_coord(ix, iy);
-      /* Create a GSB object */
-      const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
-                                                      device_chan_width, segment_inf,
-                                                      gsb_coord);
-
-      /* adapt the track_to_ipin_lookup for the GSB nodes */      
-      t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
-      track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in);
-
-      /* adapt the opin_to_track_map for the GSB nodes */      
-      t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
-      opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out);
-
-      /* adapt the switch_block_conn for the GSB nodes */      
-      t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
-      sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb, 
-                                             sb_type, Fs, sb_subtype, subFs, wire_opposite_side, 
-                                             segment_inf);
-
-      /* Build edges for a GSB */
-      build_edges_for_one_tileable_rr_gsb(rr_graph, rr_gsb,
-                                          track2ipin_map, opin2track_map, 
-                                          sb_conn, rr_node_driver_switches);
-      /* Finish this GSB, go to the next*/
+  /* The GSBs query nodes by coordinates, so the fast look-up 
+   * must be ready before the threads start 
+   */
+  rr_graph.initialize_fast_node_lookup();
+  const RRGraph& const_rr_graph = rr_graph;
+
+  /* Collect the edges Switch Block by Switch Block: [0..num_gsbs-1][edge_indices] */
+  size_t num_gsb_rows = gsb_range.y() + 1;
+  std::vector<std::vector<t_rr_gsb_edge>> gsb_edges((gsb_range.x() + 1) * num_gsb_rows);
+
+  auto collect_gsb_edges = [&](size_t igsb) {
+    vtr::Point<size_t> gsb_coord(igsb / num_gsb_rows, igsb % num_gsb_rows);
+    /* Create a GSB object */
+    const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, const_rr_graph,
+                                                    device_chan_width, segment_inf,
+                                                    gsb_coord);
+
+    /* adapt the track_to_ipin_lookup for the GSB nodes */      
+    t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
+    track2ipin_map = build_gsb_track_to_ipin_map(const_rr_graph, rr_gsb, grids, segment_inf, Fc_in);
+
+    /* adapt the opin_to_track_map for the GSB nodes */      
+    t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
+    opin2track_map = build_gsb_opin_to_track_map(const_rr_graph, rr_gsb, grids, segment_inf, Fc_out);
+
+    /* adapt the switch_block_conn for the GSB nodes */      
+    t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
+    sb_conn = build_gsb_track_to_track_map(const_rr_graph, rr_gsb, 
+                                           sb_type, Fs, sb_subtype, subFs, wire_opposite_side, 
+                                           segment_inf);
+
+    /* Collect the edges of the GSB */
+    gsb_edges[igsb] = collect_edges_for_one_tileable_rr_gsb(rr_gsb,
+                                                            track2ipin_map, opin2track_map, 
+                                                            sb_conn, rr_node_driver_switches);
+  };
+
+#if defined(VPR_USE_TBB)
+  tbb::parallel_for(size_t(0), gsb_edges.size(), collect_gsb_edges);
+#else
+  for (size_t igsb = 0; igsb < gsb_edges.size(); ++igsb) {
+    collect_gsb_edges(igsb);
+  }
+#endif
+
+  /* Add all the edges to the rr_graph with a single reservation */
+  size_t num_gsb_edges = 0;
+  for (const std::vector<t_rr_gsb_edge>& edges : gsb_edges) {
+    num_gsb_edges += edges.size();
+  }
+  rr_graph.reserve_edges(rr_graph.edges().size() + num_gsb_edges);
+
+  for (std::vector<t_rr_gsb_edge>& edges : gsb_edges) {
+    for (const t_rr_gsb_edge& edge : edges) {
+      rr_graph.create_edge(edge.src_node, edge.sink_node, edge.switch_id);
     }
+    /* Release the edge list once it is in the rr_graph */
+    std::vector<t_rr_gsb_edge>().swap(edges);
   }
 }
 
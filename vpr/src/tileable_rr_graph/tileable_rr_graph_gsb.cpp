@@ -897,17 +897,20 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
 }
 
 /************************************************************************
- * Create edges for each rr_node of a General Switch Blocks (GSB):
- * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
- * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
- * 3. create edges between OPINs and IPINs (direct-connections) 
+ * Collect the edges to create for each rr_node of a General Switch Blocks (GSB):
+ * 1. edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
+ * 2. edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
+ * 3. edges between OPINs and IPINs (direct-connections) 
+ * The edges are listed in the order they should be created in the rr_graph.
+ * This function does not modify the rr_graph, so that the edges of
+ * different GSBs can be collected in parallel
  ***********************************************************************/
-void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
-                                         const RRGSB& rr_gsb,
-                                         const t_track2pin_map& track2ipin_map,
-                                         const t_pin2track_map& opin2track_map,
-                                         const t_track2track_map& track2track_map,
-                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
+std::vector<t_rr_gsb_edge> collect_edges_for_one_tileable_rr_gsb(const RRGSB& rr_gsb,
+                                                                  const t_track2pin_map& track2ipin_map,
+                                                                  const t_pin2track_map& opin2track_map,
+                                                                  const t_track2track_map& track2track_map,
+                                                                  const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
+  std::vector<t_rr_gsb_edge> gsb_edges;
   
   /* Walk through each sides */ 
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -921,7 +924,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
       /* 1. create edges between OPINs and CHANX|CHANY, using opin2track_map */
       /* add edges to the opin_node */
       for (const RRNodeId& track_node : opin2track_map[gsb_side][inode]) {
-        rr_graph.create_edge(opin_node, track_node, rr_node_driver_switches[track_node]);
+        gsb_edges.push_back({opin_node, track_node, rr_node_driver_switches[track_node]});
       }
     }
 
@@ -935,7 +938,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
       for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
         const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode); 
         for (const RRNodeId& ipin_node : track2ipin_map[gsb_side][inode]) {
-          rr_graph.create_edge(chan_node, ipin_node, rr_node_driver_switches[ipin_node]);
+          gsb_edges.push_back({chan_node, ipin_node, rr_node_driver_switches[ipin_node]});
         }
       }
     }
@@ -944,10 +947,31 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
     for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
       const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode); 
       for (const RRNodeId& track_node : track2track_map[gsb_side][inode]) {
-        rr_graph.create_edge(chan_node, track_node, rr_node_driver_switches[track_node]);
+        gsb_edges.push_back({chan_node, track_node, rr_node_driver_switches[track_node]});
       }
     }
   }
+
+  return gsb_edges;
+}
+
+/************************************************************************
+ * Create edges for each rr_node of a General Switch Blocks (GSB):
+ * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
+ * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
+ * 3. create edges between OPINs and IPINs (direct-connections) 
+ ***********************************************************************/
+void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
+                                         const RRGSB& rr_gsb,
+                                         const t_track2pin_map& track2ipin_map,
+                                         const t_pin2track_map& opin2track_map,
+                                         const t_track2track_map& track2track_map,
+                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
+  for (const t_rr_gsb_edge& edge : collect_edges_for_one_tileable_rr_gsb(rr_gsb,
+                                                                         track2ipin_map, opin2track_map,
+                                                                         track2track_map, rr_node_driver_switches)) {
+    rr_graph.create_edge(edge.src_node, edge.sink_node, edge.switch_id);
+  }
 }
 
 /************************************************************************
@@ -30,6 +30,13 @@ typedef std::vector<std::vector<std::vector<RRNodeId>>> t_track2track_map;
 typedef std::vector<std::vector<std::vector<RRNodeId>>> t_track2pin_map;
 typedef std::vector<std::vector<std::vector<RRNodeId>>> t_pin2track_map;
 
+/* An edge to be created in the rr_graph */
+struct t_rr_gsb_edge {
+  RRNodeId src_node;
+  RRNodeId sink_node;
+  RRSwitchId switch_id;
+};
+
 /************************************************************************
  * Functions 
  ***********************************************************************/
@@ -48,6 +55,12 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
                                 const std::vector<t_segment_inf>& segment_inf,
                                 const vtr::Point<size_t>& gsb_coordinate);
 
+std::vector<t_rr_gsb_edge> collect_edges_for_one_tileable_rr_gsb(const RRGSB& rr_gsb,
+                                                                  const t_track2pin_map& track2ipin_map,
+                                                                  const t_pin2track_map& opin2track_map,
+                                                                  const t_track2track_map& track2track_map,
+                                                                  const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches);
+
 void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
                                          const RRGSB& rr_gsb,
                                          const t_track2pin_map& track2ipin_map,
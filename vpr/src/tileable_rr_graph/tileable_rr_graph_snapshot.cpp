@@ -0,0 +1,401 @@
+/************************************************************************
+ *  This file contains functions to save and load a snapshot of
+ *  a tileable routing resource graph, so that a device whose
+ *  architecture, layout and channel width are unchanged does not need
+ *  to build its rr_graph again.
+ *
+ *  The snapshot is taken once all the nodes and edges are created,
+ *  before the switches are remapped by their fan-in. The remaining
+ *  steps of the builder are cheap and run as usual on the loaded graph.
+ ***********************************************************************/
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_hash.h"
+#include "vtr_util.h"
+
+#include "vpr_error.h"
+#include "rr_node.h"
+#include "globals.h"
+
+#include "tileable_rr_graph_snapshot.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include <cstdio>
+#    include <cstdlib>
+#    include <sys/stat.h>
+#    include <unistd.h>
+
+#    include "capnp/serialize.h"
+#    include "rr_graph_snapshot.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Change the version whenever the content of a snapshot changes */
+constexpr size_t TILEABLE_RR_GRAPH_SNAPSHOT_VERSION = 1;
+
+/************************************************************************
+ * Compute a fingerprint of everything that a tileable rr_graph is built from:
+ * - the content of the architecture file
+ * - the device layout, i.e., the tile type at each grid location
+ * - the channel widths
+ * - the switch block options
+ ***********************************************************************/
+size_t tileable_rr_graph_fingerprint(const std::string& arch_file_name,
+                                     const DeviceGrid& grids,
+                                     const t_chan_width& chan_width,
+                                     const e_switch_block_type& sb_type, const int& Fs,
+                                     const e_switch_block_type& sb_subtype, const int& subFs,
+                                     const bool& through_channel,
+                                     const bool& wire_opposite_side) {
+  size_t fingerprint = 0;
+  vtr::hash_combine(fingerprint, TILEABLE_RR_GRAPH_SNAPSHOT_VERSION);
+
+  std::ifstream arch_file(arch_file_name, std::ios::binary);
+  if (!arch_file.is_open()) {
+    VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                    "Unable to open architecture file '%s' to fingerprint the routing resource graph\n",
+                    arch_file_name.c_str());
+  }
+  std::stringstream arch_content;
+  arch_content << arch_file.rdbuf();
+  vtr::hash_combine(fingerprint, arch_content.str());
+
+  vtr::hash_combine(fingerprint, grids.width());
+  vtr::hash_combine(fingerprint, grids.height());
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      vtr::hash_combine(fingerprint, std::string(grids[ix][iy].type->name));
+      vtr::hash_combine(fingerprint, grids[ix][iy].width_offset);
+      vtr::hash_combine(fingerprint, grids[ix][iy].height_offset);
+    }
+  }
+
+  vtr::hash_combine(fingerprint, chan_width.max);
+  vtr::hash_combine(fingerprint, chan_width.x_max);
+  vtr::hash_combine(fingerprint, chan_width.y_max);
+  vtr::hash_combine(fingerprint, chan_width.x_min);
+  vtr::hash_combine(fingerprint, chan_width.y_min);
+  for (const int& width : chan_width.x_list) {
+    vtr::hash_combine(fingerprint, width);
+  }
+  for (const int& width : chan_width.y_list) {
+    vtr::hash_combine(fingerprint, width);
+  }
+
+  vtr::hash_combine(fingerprint, int(sb_type));
+  vtr::hash_combine(fingerprint, Fs);
+  vtr::hash_combine(fingerprint, int(sb_subtype));
+  vtr::hash_combine(fingerprint, subFs);
+  vtr::hash_combine(fingerprint, through_channel);
+  vtr::hash_combine(fingerprint, wire_opposite_side);
+
+  return fingerprint;
+}
+
+/************************************************************************
+ * Get the path of the snapshot file for a fingerprint
+ ***********************************************************************/
+std::string tileable_rr_graph_snapshot_file(const std::string& snapshot_dir,
+                                            const size_t& fingerprint) {
+  std::string file_path(snapshot_dir);
+  if (!file_path.empty() && '/' != file_path.back()) {
+    file_path += "/";
+  }
+  file_path += vtr::string_fmt("rr_graph_%016zx.bin", fingerprint);
+
+  return file_path;
+}
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+bool read_tileable_rr_graph_snapshot(const std::string& /*file*/,
+                                     const size_t& /*fingerprint*/,
+                                     RRGraph& /*rr_graph*/,
+                                     std::map<RRNodeId, std::vector<size_t>>& /*rr_node_track_ids*/) {
+  VPR_THROW(VPR_ERROR_ROUTE, "Routing resource graph snapshot " DISABLE_ERROR);
+}
+
+void write_tileable_rr_graph_snapshot(const std::string& /*file*/,
+                                      const size_t& /*fingerprint*/,
+                                      const RRGraph& /*rr_graph*/,
+                                      const std::map<RRNodeId, std::vector<size_t>>& /*rr_node_track_ids*/) {
+  VPR_THROW(VPR_ERROR_ROUTE, "Routing resource graph snapshot " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/************************************************************************
+ * Load the nodes and edges of a snapshot into a rr_graph.
+ * The rr_graph should contain the segments and the architecture switches
+ * but no nodes and edges.
+ * Return false if the snapshot does not exist or does not match the fingerprint,
+ * in which case the rr_graph is untouched and should be built as usual.
+ ***********************************************************************/
+bool read_tileable_rr_graph_snapshot(const std::string& file,
+                                     const size_t& fingerprint,
+                                     RRGraph& rr_graph,
+                                     std::map<RRNodeId, std::vector<size_t>>& rr_node_track_ids) {
+  if (!vtr::file_exists(file.c_str())) {
+    VTR_LOG("No routing resource graph snapshot '%s' found\n", file.c_str());
+    return false;
+  }
+
+  vtr::ScopedStartFinishTimer timer("Loading routing resource graph snapshot");
+
+  VTR_ASSERT(0 == rr_graph.nodes().size());
+  VTR_ASSERT(0 == rr_graph.edges().size());
+
+  /* The file is mapped to memory, and unmapped when leaving the scope */
+  MmapFile f(file);
+  /* A snapshot of a large device easily exceeds the default traversal limit of capnproto */
+  ::capnp::ReaderOptions options;
+  options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+  ::capnp::FlatArrayMessageReader reader(f.getData(), options);
+  auto snapshot = reader.getRoot<VprRRGraphSnapshot>();
+
+  if (snapshot.getFingerprint() != fingerprint) {
+    VTR_LOG_WARN("Routing resource graph snapshot '%s' does not match the current device. Ignore it.\n",
+                 file.c_str());
+    return false;
+  }
+
+  /* Map the flyweight RC data of the snapshot to the one of the device */
+  std::vector<short> rc_data_indices;
+  for (const auto& rc_data : snapshot.getRcData()) {
+    rc_data_indices.push_back(find_create_rr_rc_data(rc_data.getR(), rc_data.getC()));
+  }
+
+  /* Create nodes */
+  auto node_types = snapshot.getNodeTypes();
+  auto node_xlows = snapshot.getNodeXlows();
+  auto node_ylows = snapshot.getNodeYlows();
+  auto node_xhighs = snapshot.getNodeXhighs();
+  auto node_yhighs = snapshot.getNodeYhighs();
+  auto node_capacities = snapshot.getNodeCapacities();
+  auto node_ptc_nums = snapshot.getNodePtcNums();
+  auto node_cost_indices = snapshot.getNodeCostIndices();
+  auto node_directions = snapshot.getNodeDirections();
+  auto node_sides = snapshot.getNodeSides();
+  auto node_Rs = snapshot.getNodeRs();
+  auto node_Cs = snapshot.getNodeCs();
+  auto node_rc_data_indices = snapshot.getNodeRcDataIndices();
+
+  size_t num_nodes = node_types.size();
+  rr_graph.reserve_nodes(num_nodes);
+  for (size_t inode = 0; inode < num_nodes; ++inode) {
+    t_rr_type node_type = t_rr_type(node_types[inode]);
+    const RRNodeId& node = rr_graph.create_node(node_type);
+    VTR_ASSERT(size_t(node) == inode);
+
+    rr_graph.set_node_bounding_box(node, vtr::Rect<short>(node_xlows[inode], node_ylows[inode],
+                                                          node_xhighs[inode], node_yhighs[inode]));
+    rr_graph.set_node_capacity(node, node_capacities[inode]);
+
+    auto ptc_nums = node_ptc_nums[inode];
+    if ((CHANX == node_type) || (CHANY == node_type)) {
+      /* Each track id of a routing track is at an offset along its direction */
+      for (size_t offset = 0; offset < ptc_nums.size(); ++offset) {
+        vtr::Point<size_t> node_offset(node_xlows[inode], node_ylows[inode]);
+        if (CHANX == node_type) {
+          node_offset.set_x(node_offset.x() + offset);
+        } else {
+          node_offset.set_y(node_offset.y() + offset);
+        }
+        rr_graph.add_node_track_num(node, node_offset, ptc_nums[offset]);
+      }
+      rr_graph.set_node_direction(node, e_direction(node_directions[inode]));
+    } else {
+      VTR_ASSERT(1 == ptc_nums.size());
+      rr_graph.set_node_ptc_num(node, ptc_nums[0]);
+    }
+
+    if ((IPIN == node_type) || (OPIN == node_type)) {
+      rr_graph.set_node_side(node, e_side(node_sides[inode]));
+    }
+
+    rr_graph.set_node_cost_index(node, node_cost_indices[inode]);
+    rr_graph.set_node_R(node, node_Rs[inode]);
+    rr_graph.set_node_C(node, node_Cs[inode]);
+
+    short rc_data_index = node_rc_data_indices[inode];
+    if (0 <= rc_data_index) {
+      VTR_ASSERT(size_t(rc_data_index) < rc_data_indices.size());
+      rc_data_index = rc_data_indices[rc_data_index];
+    }
+    rr_graph.set_node_rc_data_index(node, rc_data_index);
+  }
+
+  /* Create edges */
+  auto edge_src_nodes = snapshot.getEdgeSrcNodes();
+  auto edge_sink_nodes = snapshot.getEdgeSinkNodes();
+  auto edge_switches = snapshot.getEdgeSwitches();
+  VTR_ASSERT(edge_src_nodes.size() == edge_sink_nodes.size());
+  VTR_ASSERT(edge_src_nodes.size() == edge_switches.size());
+
+  rr_graph.reserve_edges(edge_src_nodes.size());
+  for (size_t iedge = 0; iedge < edge_src_nodes.size(); ++iedge) {
+    rr_graph.create_edge(RRNodeId(edge_src_nodes[iedge]),
+                         RRNodeId(edge_sink_nodes[iedge]),
+                         RRSwitchId(edge_switches[iedge]));
+  }
+
+  /* Restore the track ids */
+  for (const auto& node_track_ids : snapshot.getNodeTrackIds()) {
+    std::vector<size_t>& track_ids = rr_node_track_ids[RRNodeId(node_track_ids.getNode())];
+    for (const uint32_t& track_id : node_track_ids.getTrackIds()) {
+      track_ids.push_back(track_id);
+    }
+  }
+
+  VTR_LOG("Loaded %lu nodes and %lu edges from routing resource graph snapshot '%s'\n",
+          rr_graph.nodes().size(), rr_graph.edges().size(), file.c_str());
+
+  return true;
+}
+
+/************************************************************************
+ * Write the nodes and edges of a rr_graph to a snapshot
+ *
+ * Snapshots are shared by concurrent jobs, so the snapshot is written to
+ * a unique temporary file in the same directory and then renamed to the
+ * final name. A job reading the snapshot either finds no file or
+ * a complete one, but never a half-written one.
+ ***********************************************************************/
+void write_tileable_rr_graph_snapshot(const std::string& file,
+                                      const size_t& fingerprint,
+                                      const RRGraph& rr_graph,
+                                      const std::map<RRNodeId, std::vector<size_t>>& rr_node_track_ids) {
+  vtr::ScopedStartFinishTimer timer("Writing routing resource graph snapshot");
+
+  const auto& device_ctx = g_vpr_ctx.device();
+
+  ::capnp::MallocMessageBuilder builder;
+  auto snapshot = builder.initRoot<VprRRGraphSnapshot>();
+
+  snapshot.setFingerprint(fingerprint);
+
+  auto rc_data = snapshot.initRcData(device_ctx.rr_rc_data.size());
+  for (size_t irc = 0; irc < device_ctx.rr_rc_data.size(); ++irc) {
+    rc_data[irc].setR(device_ctx.rr_rc_data[irc].R);
+    rc_data[irc].setC(device_ctx.rr_rc_data[irc].C);
+  }
+
+  size_t num_nodes = rr_graph.nodes().size();
+  auto node_types = snapshot.initNodeTypes(num_nodes);
+  auto node_xlows = snapshot.initNodeXlows(num_nodes);
+  auto node_ylows = snapshot.initNodeYlows(num_nodes);
+  auto node_xhighs = snapshot.initNodeXhighs(num_nodes);
+  auto node_yhighs = snapshot.initNodeYhighs(num_nodes);
+  auto node_capacities = snapshot.initNodeCapacities(num_nodes);
+  auto node_ptc_nums = snapshot.initNodePtcNums(num_nodes);
+  auto node_cost_indices = snapshot.initNodeCostIndices(num_nodes);
+  auto node_directions = snapshot.initNodeDirections(num_nodes);
+  auto node_sides = snapshot.initNodeSides(num_nodes);
+  auto node_Rs = snapshot.initNodeRs(num_nodes);
+  auto node_Cs = snapshot.initNodeCs(num_nodes);
+  auto node_rc_data_indices = snapshot.initNodeRcDataIndices(num_nodes);
+
+  for (const RRNodeId& node : rr_graph.nodes()) {
+    size_t inode = size_t(node);
+    t_rr_type node_type = rr_graph.node_type(node);
+
+    node_types.set(inode, node_type);
+    node_xlows.set(inode, rr_graph.node_xlow(node));
+    node_ylows.set(inode, rr_graph.node_ylow(node));
+    node_xhighs.set(inode, rr_graph.node_xhigh(node));
+    node_yhighs.set(inode, rr_graph.node_yhigh(node));
+    node_capacities.set(inode, rr_graph.node_capacity(node));
+
+    if ((CHANX == node_type) || (CHANY == node_type)) {
+      std::vector<short> track_ids = rr_graph.node_track_ids(node);
+      auto ptc_nums = node_ptc_nums.init(inode, track_ids.size());
+      for (size_t offset = 0; offset < track_ids.size(); ++offset) {
+        ptc_nums.set(offset, track_ids[offset]);
+      }
+      node_directions.set(inode, rr_graph.node_direction(node));
+    } else {
+      auto ptc_nums = node_ptc_nums.init(inode, 1);
+      ptc_nums.set(0, rr_graph.node_ptc_num(node));
+      node_directions.set(inode, NO_DIRECTION);
+    }
+
+    if ((IPIN == node_type) || (OPIN == node_type)) {
+      node_sides.set(inode, rr_graph.node_side(node));
+    } else {
+      node_sides.set(inode, NUM_SIDES);
+    }
+
+    node_cost_indices.set(inode, rr_graph.node_cost_index(node));
+    node_Rs.set(inode, rr_graph.node_R(node));
+    node_Cs.set(inode, rr_graph.node_C(node));
+    node_rc_data_indices.set(inode, rr_graph.node_rc_data_index(node));
+  }
+
+  size_t num_edges = rr_graph.edges().size();
+  auto edge_src_nodes = snapshot.initEdgeSrcNodes(num_edges);
+  auto edge_sink_nodes = snapshot.initEdgeSinkNodes(num_edges);
+  auto edge_switches = snapshot.initEdgeSwitches(num_edges);
+  for (const RREdgeId& edge : rr_graph.edges()) {
+    size_t iedge = size_t(edge);
+    edge_src_nodes.set(iedge, size_t(rr_graph.edge_src_node(edge)));
+    edge_sink_nodes.set(iedge, size_t(rr_graph.edge_sink_node(edge)));
+    edge_switches.set(iedge, size_t(rr_graph.edge_switch(edge)));
+  }
+
+  auto node_track_ids = snapshot.initNodeTrackIds(rr_node_track_ids.size());
+  size_t ientry = 0;
+  for (const auto& node_tracks : rr_node_track_ids) {
+    node_track_ids[ientry].setNode(size_t(node_tracks.first));
+    auto track_ids = node_track_ids[ientry].initTrackIds(node_tracks.second.size());
+    for (size_t itrack = 0; itrack < node_tracks.second.size(); ++itrack) {
+      track_ids.set(itrack, node_tracks.second[itrack]);
+    }
+    ientry++;
+  }
+
+  std::string tmp_file = file + std::string(".XXXXXX");
+  int tmp_fd = mkstemp(&tmp_file[0]);
+  if (-1 == tmp_fd) {
+    VPR_THROW(VPR_ERROR_ROUTE,
+              "Fail to create a temporary file for routing resource graph snapshot '%s'",
+              file.c_str());
+  }
+  /* mkstemp() only grants access to the owner, while snapshots are shared */
+  fchmod(tmp_fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  close(tmp_fd);
+
+  try {
+    writeMessageToFile(tmp_file, &builder);
+  } catch (...) {
+    std::remove(tmp_file.c_str());
+    throw;
+  }
+
+  if (0 != std::rename(tmp_file.c_str(), file.c_str())) {
+    std::remove(tmp_file.c_str());
+    VPR_THROW(VPR_ERROR_ROUTE,
+              "Fail to rename temporary file '%s' to routing resource graph snapshot '%s'",
+              tmp_file.c_str(), file.c_str());
+  }
+
+  VTR_LOG("Wrote %lu nodes and %lu edges to routing resource graph snapshot '%s'\n",
+          num_nodes, num_edges, file.c_str());
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+} /* end namespace openfpga */
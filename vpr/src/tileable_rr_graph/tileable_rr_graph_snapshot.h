@@ -0,0 +1,45 @@
+#ifndef TILEABLE_RR_GRAPH_SNAPSHOT_H
+#define TILEABLE_RR_GRAPH_SNAPSHOT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <map>
+#include <string>
+#include <vector>
+
+#include "physical_types.h"
+#include "device_grid.h"
+#include "rr_graph_obj.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+size_t tileable_rr_graph_fingerprint(const std::string& arch_file_name,
+                                     const DeviceGrid& grids,
+                                     const t_chan_width& chan_width,
+                                     const e_switch_block_type& sb_type, const int& Fs,
+                                     const e_switch_block_type& sb_subtype, const int& subFs,
+                                     const bool& through_channel,
+                                     const bool& wire_opposite_side);
+
+std::string tileable_rr_graph_snapshot_file(const std::string& snapshot_dir,
+                                            const size_t& fingerprint);
+
+bool read_tileable_rr_graph_snapshot(const std::string& file,
+                                     const size_t& fingerprint,
+                                     RRGraph& rr_graph,
+                                     std::map<RRNodeId, std::vector<size_t>>& rr_node_track_ids);
+
+void write_tileable_rr_graph_snapshot(const std::string& file,
+                                      const size_t& fingerprint,
+                                      const RRGraph& rr_graph,
+                                      const std::map<RRNodeId, std::vector<size_t>>& rr_node_track_ids);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,108 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "net_pin_store.h"
+
+namespace {
+
+//Checks the histogram against a brute-force recount of the pin coordinates
+static void check_histogram(const CoordHistogram& histogram, const std::vector<int>& pin_coords, size_t num_coords) {
+    std::vector<int> counts(num_coords, 0);
+    for (int coord : pin_coords) {
+        ++counts[coord];
+    }
+
+    for (size_t coord = 0; coord < num_coords; ++coord) {
+        REQUIRE(histogram.count(coord) == counts[coord]);
+    }
+    REQUIRE(histogram.total() == int(pin_coords.size()));
+
+    if (pin_coords.empty()) return;
+
+    int min_coord = num_coords;
+    int max_coord = -1;
+    for (size_t coord = 0; coord < num_coords; ++coord) {
+        if (counts[coord] > 0) {
+            min_coord = std::min<int>(min_coord, coord);
+            max_coord = std::max<int>(max_coord, coord);
+        }
+    }
+    REQUIRE(histogram.min_coord() == min_coord);
+    REQUIRE(histogram.max_coord() == max_coord);
+}
+
+TEST_CASE("coord_histogram_random_moves", "[vpr]") {
+    constexpr size_t kNumMoves = 500;
+    std::mt19937 rng(1);
+
+    //Include sizes which are not powers of two, and single-coordinate ones
+    for (size_t num_coords : {1, 2, 7, 16, 33, 100}) {
+        for (size_t num_pins : {1, 2, 5, 40}) {
+            std::uniform_int_distribution<int> coord_dist(0, num_coords - 1);
+            std::uniform_int_distribution<size_t> pin_dist(0, num_pins - 1);
+
+            CoordHistogram histogram(num_coords);
+            std::vector<int> pin_coords;
+            for (size_t ipin = 0; ipin < num_pins; ++ipin) {
+                pin_coords.push_back(coord_dist(rng));
+                histogram.add(pin_coords.back(), +1);
+                check_histogram(histogram, pin_coords, num_coords);
+            }
+            std::vector<int> initial_coords = pin_coords;
+
+            //Apply random moves, as the placer does for swaps
+            std::vector<std::pair<size_t, int>> moves; //Pin and its previous coordinate
+            for (size_t imove = 0; imove < kNumMoves; ++imove) {
+                size_t ipin = pin_dist(rng);
+                int to = coord_dist(rng);
+                moves.emplace_back(ipin, pin_coords[ipin]);
+
+                histogram.move(pin_coords[ipin], to);
+                pin_coords[ipin] = to;
+                check_histogram(histogram, pin_coords, num_coords);
+            }
+
+            //Revert them in reverse order, as the placer does for rejected swaps
+            for (auto it = moves.rbegin(); it != moves.rend(); ++it) {
+                histogram.move(pin_coords[it->first], it->second);
+                pin_coords[it->first] = it->second;
+                check_histogram(histogram, pin_coords, num_coords);
+            }
+            REQUIRE(pin_coords == initial_coords);
+
+            histogram.clear();
+            check_histogram(histogram, std::vector<int>(), num_coords);
+        }
+    }
+}
+
+TEST_CASE("coord_histogram_add_remove", "[vpr]") {
+    CoordHistogram histogram(10);
+    std::vector<int> pin_coords = {3, 3, 8};
+    for (int coord : pin_coords) {
+        histogram.add(coord, +1);
+    }
+    check_histogram(histogram, pin_coords, 10);
+
+    //Removing one of the two pins at the minimum keeps it
+    histogram.add(3, -1);
+    pin_coords = {3, 8};
+    check_histogram(histogram, pin_coords, 10);
+
+    //Removing the last pin at the minimum moves it to the maximum
+    histogram.add(3, -1);
+    pin_coords = {8};
+    check_histogram(histogram, pin_coords, 10);
+
+    //Several pins added at once
+    histogram.add(0, +2);
+    histogram.add(9, +3);
+    pin_coords = {0, 0, 8, 9, 9, 9};
+    check_histogram(histogram, pin_coords, 10);
+}
+
+} // namespace